@@ -8,10 +8,14 @@ using fad_double = Sacado::Fad::DFad<double>;
 
 using namespace dealii;
 
-template<int dim>
-SymmetricTensor<2,dim,fad_double> init_Sacado(const SymmetricTensor<2,dim,double> &SymTensor)
+/*
+ * The functions are templated on the Sacado data type \a Number (default fad_double),
+ * e.g. init_Sacado<dim, Sacado::Fad::SFad<double,6> >(eps)
+ */
+template<int dim, typename Number=fad_double>
+SymmetricTensor<2,dim,Number> init_Sacado(const SymmetricTensor<2,dim,double> &SymTensor)
 {
-	SymmetricTensor<2,dim,fad_double> SymTensor_Sacado;
+	SymmetricTensor<2,dim,Number> SymTensor_Sacado;
 	 for ( unsigned int i=0; i<dim; ++i)
 		for ( unsigned int j=i; j<dim; ++j )
 			SymTensor_Sacado[i][j] = SymTensor[i][j];
@@ -20,14 +24,15 @@ SymmetricTensor<2,dim,fad_double> init_Sacado(const SymmetricTensor<2,dim,double
 }
 
 
-template<int dim>
-SymmetricTensor<2,dim> extract_value_from_Sacado(const SymmetricTensor<2,dim,fad_double> &SymTensor_Sacado)
+template<int dim, typename Number>
+SymmetricTensor<2,dim> extract_value_from_Sacado(const SymmetricTensor<2,dim,Number> &SymTensor_Sacado)
 {
 	SymmetricTensor<2,dim> SymTensor;
-	// .val() extracts the \a double value from the Sacado variable
+	// Sacado::ScalarValue extracts the \a double value from the Sacado variable (also from nested ones, where .val() would
+	// only return the inner Sacado variable)
 	 for ( unsigned int i=0; i<dim; ++i)
 		for ( unsigned int j=i; j<dim; ++j )
-			SymTensor[i][j] = SymTensor_Sacado[i][j].val();
+			SymTensor[i][j] = Sacado::ScalarValue<Number>::eval(SymTensor_Sacado[i][j]);
 	 
 	 return SymTensor;
 }
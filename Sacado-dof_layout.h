@@ -0,0 +1,166 @@
+#ifndef Sacado_dof_layout_H
+#define Sacado_dof_layout_H
+
+#include <cstddef>
+
+/*
+ * Compile-time layout of the Sacado dofs, shared by the wrapper classes (testEnv/Sacado_Wrapper.h) and the SacadoQP
+ * functions (Sacado_Wrapper.h). This header only depends on the standard library.
+ */
+namespace Sacado_Wrapper
+{
+	/*
+	 * Compile-time tables that relate the dof-nbr x to the component (i,j) of a symmetric tensor, e.g. the first dof
+	 * (x=0) is the (0,0) component, whereas the second dof (x=1) is the (0,1) component. These replace the std::map
+	 * that every wrapper object used to set up in its constructor, so they are shared by all the wrapper classes.
+	 * 	- 2D: (0,0)-(0,1)-(1,1)
+	 * 	- 3D: (0,0)-(0,1)-(0,2)-(1,1)-(1,2)-(2,2)
+	 */
+	namespace internal
+	{
+		constexpr unsigned int index_i_2D[3] = { 0, 0, 1 };
+		constexpr unsigned int index_j_2D[3] = { 0, 1, 1 };
+
+		constexpr unsigned int index_i_3D[6] = { 0, 0, 0, 1, 1, 2 };
+		constexpr unsigned int index_j_3D[6] = { 0, 1, 2, 1, 2, 2 };
+
+		// Derivatives with respect to the off-diagonal components of a symmetric tensor need to be scaled by 0.5
+		// (see \ref Ex9 "example 9" on why we need this factor), the diagonal components remain unscaled.
+		constexpr double voigt_scale_2D[3] = { 1., 0.5, 1. };
+		constexpr double voigt_scale_3D[6] = { 1., 0.5, 0.5, 1., 0.5, 1. };
+
+		// Position of the dof-nbr x in the Voigt/Mandel vector
+		//	- 2D: (0,0)-(1,1)-(0,1)
+		//	- 3D: (0,0)-(1,1)-(2,2)-(1,2)-(0,2)-(0,1)
+		 constexpr unsigned int voigt_index_2D[3] = { 0, 2, 1 };
+		 constexpr unsigned int voigt_index_3D[6] = { 0, 5, 4, 1, 3, 2 };
+
+		constexpr double sqrt_2 = 1.41421356237309504880;
+
+		// Inverse of the above tables: dof-nbr of the component (i,j) (and (j,i))
+		 constexpr unsigned int dof_index_2D[2][2] = { {0,1}, {1,2} };
+		 constexpr unsigned int dof_index_3D[3][3] = { {0,1,2}, {1,3,4}, {2,4,5} };
+	}
+
+	/*
+	 * First index \a i of the component (i,j) that belongs to the dof-nbr \a x
+	 */
+	template<int dim>
+	constexpr unsigned int index_i ( const unsigned int x )
+	{
+		return (dim==2) ? internal::index_i_2D[x] : internal::index_i_3D[x];
+	}
+
+	/*
+	 * Second index \a j of the component (i,j) that belongs to the dof-nbr \a x
+	 */
+	template<int dim>
+	constexpr unsigned int index_j ( const unsigned int x )
+	{
+		return (dim==2) ? internal::index_j_2D[x] : internal::index_j_3D[x];
+	}
+
+	/*
+	 * Scaling factor (1 or 0.5) for the derivatives with respect to the dof-nbr \a x. The scaling of second derivatives
+	 * with respect to the dofs x and y follows as voigt_scale(x)*voigt_scale(y), giving the factors 1, 0.5 and 0.25.
+	 */
+	template<int dim>
+	constexpr double voigt_scale ( const unsigned int x )
+	{
+		return (dim==2) ? internal::voigt_scale_2D[x] : internal::voigt_scale_3D[x];
+	}
+
+	/*
+	 * Dof-nbr \a x of the component (i,j) (inverse of \a index_i and \a index_j)
+	 */
+	template<int dim>
+	constexpr unsigned int dof_index ( const unsigned int i, const unsigned int j )
+	{
+		return (dim==2) ? internal::dof_index_2D[i][j] : internal::dof_index_3D[i][j];
+	}
+
+	/*
+	 * Position of the dof-nbr \a x in the Voigt or Mandel vector (see enum_packing)
+	 */
+	template<int dim>
+	constexpr unsigned int voigt_index ( const unsigned int x )
+	{
+		return (dim==2) ? internal::voigt_index_2D[x] : internal::voigt_index_3D[x];
+	}
+
+	/*
+	 * Layout of the packed tangents written into a contiguous buffer or a FullMatrix:
+	 * 	- voigt:  C_IJ = C_ijkl, ordered as 11-22-33-23-13-12 (3D) or 11-22-12 (2D), to be used with the engineering
+	 * 			  shear strains (2*eps_ij) as in the classic B^T*C*B element kernels
+	 * 	- mandel: C_IJ = w_I*w_J*C_ijkl with w=sqrt(2) for the off-diagonal components, which keeps the norms and
+	 * 			  the symmetry of the Hessians and is used with the strain vector [eps_11,..., sqrt(2)*eps_23, ...]
+	 */
+	enum enum_packing
+	{
+		voigt = 0,
+		mandel = 1
+	};
+
+	/*
+	 * Weight w of the dof-nbr \a x in the packed vector (1 for Voigt, sqrt(2) for the off-diagonal components in Mandel notation)
+	 */
+	template<int dim>
+	constexpr double packing_weight ( const unsigned int x, const enum_packing packing )
+	{
+		return ( packing==mandel && index_i<dim>(x)!=index_j<dim>(x) ) ? internal::sqrt_2 : 1.;
+	}
+
+
+	/*
+	 * Compile-time layout of the dofs for a list of wrapper variables \a Fields (any mix of SymTensor, SW_double, SW_vector,
+	 * SymTensor2, SW_double2, ...). The fields are arranged in the given order, so the start index of the k-th field is the
+	 * sum of the number of dofs \a n_dofs of all the fields before it.
+	 * The layout only depends on \a n_dofs, which is independent of the Sacado data type. Hence, the width N of the
+	 * statically sized Sacado data types can be derived from the default wrapper types, e.g.
+	 * @code
+	 * 	const unsigned int N = Sacado_Wrapper::DoFs_layout< SymTensor<3>, SW_double<3>, SW_vector<3> >::n_total_dofs; // 6+1+3
+	 * 	Sacado_Wrapper::SymTensor_SFad<3,N> eps;
+	 * @endcode
+	 */
+	template<typename... Fields>
+	struct DoFs_layout;
+
+	template<>
+	struct DoFs_layout<>
+	{
+		static constexpr unsigned int n_total_dofs = 0;
+	};
+
+	template<typename First, typename... Rest>
+	struct DoFs_layout<First,Rest...>
+	{
+		static constexpr unsigned int n_total_dofs = First::n_dofs + DoFs_layout<Rest...>::n_total_dofs;
+
+		template<std::size_t k, typename dummy=void>
+		struct start_index
+		{
+			static constexpr unsigned int value = First::n_dofs + DoFs_layout<Rest...>::template start_index<k-1>::value;
+		};
+
+		template<typename dummy>
+		struct start_index<0,dummy>
+		{
+			static constexpr unsigned int value = 0;
+		};
+	};
+
+
+	/*
+	 * Total number of dofs of a single SymmetricTensor<2,dim> plus \a n_scalar_dofs scalars (SW_double), e.g.
+	 * n_total_dofs<3,1>::value = 6+1 for the strain tensor and the damage variable. Use this as the template argument N
+	 * of the statically sized Sacado data types (e.g. SymTensor_SFad). For arbitrary combinations of wrapper variables use
+	 * DoFs_layout.
+	 */
+	template<int dim, unsigned int n_scalar_dofs=0>
+	struct n_total_dofs
+	{
+		static const unsigned int value = ((dim==2)?3:6) + n_scalar_dofs;
+	};
+}
+
+#endif // Sacado_dof_layout_H
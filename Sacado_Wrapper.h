@@ -1,5 +1,5 @@
-#ifndef Sacado_Wrapper_H
-#define Sacado_Wrapper_H
+#ifndef SacadoQP_Wrapper_H
+#define SacadoQP_Wrapper_H
 
 // @section includes Include Files
 // The data type SymmetricTensor and some related operations, such as trace, symmetrize, deviator, ... for tensor calculus
@@ -11,57 +11,20 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <type_traits>
+#include <vector>
 
 // Sacado (from Trilinos, data types, operations, ...)
 #include <Sacado.hpp>
 
+// The compile-time index tables (index_i, index_j, voigt_scale) shared with the wrapper classes
+#include "Sacado-dof_layout.h"
+
 using namespace dealii;
 
 using fad_double = Sacado::Fad::DFad<double>;	// this data type now represents a double, but also contains the derivative of this variable with respect to the defined dofs (set via command *.diff(*))
 typedef Sacado::Fad::DFad<double> DFadType;
 
-///*
-// * A function to set up the map that relates the indices (e.g. first entry in vector is the (0,0) component, whereas the second is the (0,1) component
-// */
-//template<int dim>
-//void get_index_map( std::map<unsigned int,std::pair<unsigned int,unsigned int>> &std_map_indicies )
-//{
-//	std::pair<unsigned int, unsigned int> tmp_pair;
-//
-//	switch ( dim )
-//	{
-//	case 2:
-//		tmp_pair.first=0; tmp_pair.second=0;
-//		std_map_indicies[0] = tmp_pair;
-//
-//		tmp_pair.first=0; tmp_pair.second=1;
-//		std_map_indicies[1] = tmp_pair;
-//
-//		tmp_pair.first=1; tmp_pair.second=1;
-//		std_map_indicies[2] = tmp_pair;
-//		break;
-//	case 3:
-//		tmp_pair.first=0; tmp_pair.second=0;
-//		std_map_indicies[0] = tmp_pair;
-//
-//		tmp_pair.first=0; tmp_pair.second=1;
-//		std_map_indicies[1] = tmp_pair;
-//
-//		tmp_pair.first=0; tmp_pair.second=2;
-//		std_map_indicies[2] = tmp_pair;
-//
-//		tmp_pair.first=1; tmp_pair.second=1;
-//		std_map_indicies[3] = tmp_pair;
-//
-//		tmp_pair.first=1; tmp_pair.second=2;
-//		std_map_indicies[4] = tmp_pair;
-//
-//		tmp_pair.first=2; tmp_pair.second=2;
-//		std_map_indicies[5] = tmp_pair;
-//		break;
-//	}
-//}
-
 /**
  * @note The ad-helper stores a tensor as a list as:
  * 	-	 0 = [0][0]
@@ -75,16 +38,26 @@ typedef Sacado::Fad::DFad<double> DFadType;
  */
 namespace SacadoQP
 {
+	/*
+	 * All functions below are templated on the Sacado data type \a Number (fad_double, SFad, SLFad, ELRFad, CacheFad,
+	 * DMFad or nested combinations thereof). The overloads for double are picked for the standard double data type.
+	 * Sacado::ScalarValue extracts the double value also from nested data types, e.g. DFad<DFad<double>>.
+	 * The scalar overloads are restricted to Sacado data types (Sacado::IsADType) via \a enable_if_AD.
+	 */
+	template<typename Number, typename T=void>
+	using enable_if_AD = typename std::enable_if< Sacado::IsADType<Number>::value, T >::type;
+
+
 	/*
 	 * Extract values from SymmetricTensor of Sacado or standard double data types
 	 */
-	template<int dim>
-	SymmetricTensor<2,dim,double> get_value ( const SymmetricTensor<2,dim,fad_double> &symtensor )
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim,double> get_value ( const SymmetricTensor<2,dim,Number> &symtensor )
 	{
 		SymmetricTensor<2,dim,double> symtensor_double;
 		for ( unsigned int i=0; i<dim; ++i)
 			for ( unsigned int j=i; j<dim; ++j ) // start at \a i only possible for symmetric tensors
-				symtensor_double[i][j] = (symtensor[i][j]).val();
+				symtensor_double[i][j] = Sacado::ScalarValue<Number>::eval(symtensor[i][j]);
 
 		return symtensor_double;
 	}
@@ -93,15 +66,15 @@ namespace SacadoQP
 	{
 		return symtensor;
 	}
-	template<int dim>
-	SymmetricTensor<4,dim,double> get_value ( const SymmetricTensor<4,dim,fad_double> &symtensor )
+	template<int dim, typename Number>
+	SymmetricTensor<4,dim,double> get_value ( const SymmetricTensor<4,dim,Number> &symtensor )
 	{
 		SymmetricTensor<4,dim,double> symtensor_double;
 		for ( unsigned int i=0; i<dim; ++i)
 			for ( unsigned int j=i; j<dim; ++j ) // start at \a i only possible for symmetric tensors
 				for ( unsigned int k=0; k<dim; ++k ) // start at \a i only possible for symmetric tensors
 					for ( unsigned int l=k; l<dim; ++l ) // start at \a i only possible for symmetric tensors
-						symtensor_double[i][j][k][l] = (symtensor[i][j][k][l]).val();
+						symtensor_double[i][j][k][l] = Sacado::ScalarValue<Number>::eval(symtensor[i][j][k][l]);
 
 		return symtensor_double;
 	}
@@ -113,12 +86,12 @@ namespace SacadoQP
 	/*
 	 * Extract values from SymmetricTensor of Sacado or standard double data types
 	 */
-	template<int dim>
-	Tensor<1,dim,double> get_value ( const Tensor<1,dim,fad_double> &tensor )
+	template<int dim, typename Number>
+	Tensor<1,dim,double> get_value ( const Tensor<1,dim,Number> &tensor )
 	{
 		Tensor<1,dim,double> tensor_double;
 		for ( unsigned int i=0; i<dim; ++i)
-				tensor_double[i] = (tensor[i]).val();
+				tensor_double[i] = Sacado::ScalarValue<Number>::eval(tensor[i]);
 
 		return tensor_double;
 	}
@@ -130,35 +103,37 @@ namespace SacadoQP
 	/*
 	 * Extract values from Sacado or standard double data types
 	 */
-	double get_value ( const fad_double &faddouble )
+	template<typename Number>
+	enable_if_AD<Number,double> get_value ( const Number &faddouble )
 	{
-		return faddouble.val();
+		return Sacado::ScalarValue<Number>::eval(faddouble);
 	}
-	double get_value ( const double &doubleData )
+	inline double get_value ( const double &doubleData )
 	{
 		return doubleData;
 	}
 	/*
 	 * Extract values from Sacado or standard double data types
 	 */
-	std::vector<double> get_value ( const std::vector<fad_double> &vec_fad )
+	template<typename Number>
+	std::vector<double> get_value ( const std::vector<Number> &vec_fad )
 	{
 		std::vector<double> vec_double ( vec_fad.size() );
 		for (unsigned int it = 0; it < vec_fad.size(); ++it)
-			vec_double[it] = vec_fad[it].val();
+			vec_double[it] = Sacado::ScalarValue<Number>::eval(vec_fad[it]);
 		return vec_double;
 	}
-	std::vector<double> get_value ( const std::vector<double> &vec_double )
+	inline std::vector<double> get_value ( const std::vector<double> &vec_double )
 	{
 		return vec_double;
 	}
-	template<int dim>
-	Tensor<2,dim,double> get_value ( const Tensor<2,dim,fad_double> &tensor )
+	template<int dim, typename Number>
+	Tensor<2,dim,double> get_value ( const Tensor<2,dim,Number> &tensor )
 	{
 		Tensor<2,dim,double> tensor_double;
 		for ( unsigned int i=0; i<dim; ++i)
 			for ( unsigned int j=0; j<dim; ++j )
-				tensor_double[i][j] = (tensor[i][j]).val();
+				tensor_double[i][j] = Sacado::ScalarValue<Number>::eval(tensor[i][j]);
 
 		return tensor_double;
 	}
@@ -172,11 +147,12 @@ namespace SacadoQP
 	/*
 	 * Set values for Sacado or standard double data types
 	 */
-	void set_value ( fad_double &faddouble, double doubleData )
+	template<typename Number>
+	enable_if_AD<Number> set_value ( Number &faddouble, double doubleData )
 	{
 		faddouble.val()=doubleData;
 	}
-	void set_value ( double &faddouble, double doubleData )
+	inline void set_value ( double &faddouble, double doubleData )
 	{
 		faddouble = doubleData;
 	}
@@ -188,12 +164,12 @@ namespace SacadoQP
 	 * @param DoF_pos
 	 * @return Tangent=derivs[DoF_pos]
 	 */
-	double get_tangent ( const fad_double &function_f, const unsigned int DoF_pos )
+	template<typename Number>
+	enable_if_AD<Number,typename Number::value_type> get_tangent ( const Number &function_f, const unsigned int DoF_pos )
 	{
-		const double *derivs = &function_f.fastAccessDx(0); // Access the derivatives of the (i,j)-th component of \a sigma
-		return derivs[DoF_pos];
+		return function_f.fastAccessDx(DoF_pos); // Access the derivative of \a function_f
 	}
-	double get_tangent ( const double &function_f, const unsigned int DoF_pos )
+	inline double get_tangent ( const double &function_f, const unsigned int DoF_pos )
 	{
 		double Tangent;
 		AssertThrow(false,ExcMessage("When using data type double, you cannot use Sacado for the tangents."));
@@ -210,9 +186,10 @@ namespace SacadoQP
 	 * @param bucket
 	 * @param value
 	 */
-	void set_deriv ( fad_double &variable_x, const unsigned int DoF_pos, double value=0. )
+	template<typename Number>
+	enable_if_AD<Number> set_deriv ( Number &variable_x, const unsigned int DoF_pos, double value=0. )
 	{
-		double *derivs = &variable_x.fastAccessDx(0);
+		typename Number::value_type *derivs = &variable_x.fastAccessDx(0);
 //		if ( DoF_pos == 0 )
 //		{
 //			for ( unsigned int i=0; i<6; i++ )
@@ -221,16 +198,17 @@ namespace SacadoQP
 //		else
 			derivs[DoF_pos] = value;
 	}
-	void set_deriv ( double &variable_x, const unsigned int DoF_pos, double value=0. )
+	inline void set_deriv ( double &variable_x, const unsigned int DoF_pos, double value=0. )
 	{
 		AssertThrow(false,ExcMessage("When using data type fad_double, you cannot use this function."));
 		// Some useless code to get rid of "unused variable" warnings
 		 value *= variable_x*DoF_pos;
 	}
 
-	void set_deriv ( fad_double &variable_x, /*const unsigned int DoF_pos,*/ const SymmetricTensor<2,3,double> &deriv_values )
+	template<typename Number>
+	enable_if_AD<Number> set_deriv ( Number &variable_x, /*const unsigned int DoF_pos,*/ const SymmetricTensor<2,3,double> &deriv_values )
 	{
-		double *derivs = &variable_x.fastAccessDx(0);
+		typename Number::value_type *derivs = &variable_x.fastAccessDx(0);
 		derivs[0] += deriv_values[0][0];
 		derivs[1] += deriv_values[1][1];
 		derivs[2] += deriv_values[2][2];
@@ -238,7 +216,7 @@ namespace SacadoQP
 		derivs[4] += deriv_values[0][2];
 		derivs[5] += deriv_values[1][2];
 	}
-	void set_deriv ( double &variable_x, /*const unsigned int DoF_pos,*/ const SymmetricTensor<2,3,double> &deriv_values )
+	inline void set_deriv ( double &variable_x, /*const unsigned int DoF_pos,*/ const SymmetricTensor<2,3,double> &deriv_values )
 	{
 		AssertThrow(false,ExcMessage("When using data type fad_double, you cannot use this function."));
 		// Some useless code to get rid of "unused variable" warnings
@@ -246,171 +224,237 @@ namespace SacadoQP
 		 std::cout << deriv_values << std::endl;
 	}
 
-//	template<int dim, typename Number>
-//	class BuCa
-//	{
-//	public:
-//		// Use different BuCa constructors for (ten,ten), (ten,LM), (ten,LM,LM), ...
-//		/**
-//		 * Only a single symmetric tensor as AD-dofs
-//		 * @param variable_x
-//		 */
-//		BuCa( const SymmetricTensor<2,dim,Number> &variable_x )
-//		:
-//		start_indices(1),
-//		n_dofs_list(1)
-//		{
-//			get_index_map<dim>( std_map_indicies );
-//
-//			start_indices[0]=0;
-//			n_dofs_list[0] = ((dim==2)?3:6); // ToDo: Find a way to use eps.n_independent_components(); that gives ((dim==2)?3:6) for a SymmetricTensor
-//
-//			nbr_total_dofs = n_dofs_list.back();
-//		}
-//
-//		/**
-//		 * One symmetric tensor and a single scalar as AD-dofs
-//		 * @param variable_x1 SymmetricTensor
-//		 * @param variable_x2 Scalar
-//		 */
-//		BuCa( const SymmetricTensor<2,dim,Number> &variable_x1, const Number &variable_x2 )
-//		:
-//		start_indices(2),
-//		n_dofs_list(2)
-//		{
-//			get_index_map<dim>( std_map_indicies );
-//
-//			start_indices[0] = 0;
-//			n_dofs_list[0] = ((dim==2)?3:6); // ToDo: Find a way to use eps.n_independent_components(); that gives ((dim==2)?3:6) for a SymmetricTensor
-//
-//			start_indices[1] = n_dofs_list[0];
-//			n_dofs_list[1] = 1;
-//
-//			nbr_total_dofs = n_dofs_list[0] + n_dofs_list[1];
-//		}
-//		// Everything else could be captured by std::vector<SymmetricTensor> and std::vector<Number>
-//
-//		//~BuCa(){}
-//
-//		// To simplify the access to the dofs we define a map that relate the components of our strain tensor to the dof-nbr
-//	     std::map<unsigned int,std::pair<unsigned int,unsigned int>> std_map_indicies;
-//
-//	//private:
-//		std::vector<unsigned int> start_indices;
-//		std::vector<unsigned int> n_dofs_list;
-//		unsigned int nbr_total_dofs;
-//
-//	public:
-//		// These should be pure accessor functions (somehow I still cannot pass "const BuCa" as argument in the fncs below
-//		unsigned int start_index( const enums::enum_SacadoDoFs &SacDoFs ) const
-//		{
-//			return start_indices[SacDoFs];
-//		};
-//		unsigned int n_ADdofs( const enums::enum_SacadoDoFs &SacDoFs ) const
-//		{
-//			return n_dofs_list[SacDoFs];
-//		};
-//		unsigned int n_total_ADdofs(  ) const
-//		{
-//			return nbr_total_dofs;
-//		};
-//	};
-
-
-//	/*
-//	 * Set the components of the tensor as Sacado dofs
-//	 */
-//	/**
-//	 *
-//	 * @param variable_x Cannot be used as \a const, because we set the \a diff members
-//	 * @param SacDoFs
-//	 * @param bucket
-//	 */
-//	template<int dim>
-//	void set_dofs( SymmetricTensor<2,dim,fad_double> &variable_x, const enums::enum_SacadoDoFs SacDoFs, BuCa<dim,fad_double> &bucket )
-//	{
-//		// Instead of calling the *.diff(*) on the components one-by-one we could also use the following for-loop, so
-//		// we also use the map to set the dofs
-//		const unsigned int start_index = bucket.start_index(SacDoFs);
-//		const unsigned int end_index = start_index + bucket.n_ADdofs(SacDoFs);
-//
-//        for( unsigned int x=start_index; x < end_index; ++x )
-//		{
-//			unsigned int i=bucket.std_map_indicies[x].first;
-//			unsigned int j=bucket.std_map_indicies[x].second;
-//			variable_x[i][j].diff( x, bucket.n_total_ADdofs() );
-//		}
-//	}
-//	template<int dim>
-//	void set_dofs( SymmetricTensor<2,dim,double> &variable_x, const enums::enum_SacadoDoFs SacDoFs, BuCa<dim,double> &bucket )
-//	{
-//		AssertThrow(false,ExcMessage("When using data type double, you don't need to set_dofs for an analytical tangent."));
-//	}
-//
-//	/**
-//	 *
-//	 * @param variable_x Cannot be used as \a const, because we set the \a diff members
-//	 * @param SacDoFs
-//	 * @param bucket
-//	 */
-//	template<int dim>
-//	void set_dofs( fad_double &variable_x2, const enums::enum_SacadoDoFs SacDoFs, BuCa<dim,fad_double> &bucket )
-//	{
-//		// Instead of calling the *.diff(*) on the components one-by-one we could also use the following for-loop, so
-//		// we also use the map to set the dofs
-//		const unsigned int start_index = bucket.start_index(SacDoFs);
-//
-//		variable_x2.diff( start_index, bucket.n_total_ADdofs() );
-//	}
-//	template<int dim>
-//	void set_dofs( double &variable_x2, const enums::enum_SacadoDoFs SacDoFs, BuCa<dim,double> &bucket )
-//	{
-//		AssertThrow(false,ExcMessage("When using data type double, you don't need to set_dofs for an analytical tangent."));
-//	}
+	/*
+	 * BuCa ("bucket") describes the layout of the AD-dofs of a multi-field model at compile time, e.g.
+	 * strain tensor + damage + Lagrange multiplier. The blocks are arranged in the given order, so the start index of
+	 * a block and the total number of AD-dofs are compile-time constants. There is no runtime map and no std::vector of
+	 * start indices, the functions \a set_dofs, \a get_tangent and \a set_deriv below index the derivative arrays directly.
+	 * @code
+	 * 	enum enum_SacadoDoFs { eps_dofs=0, damage_dofs=1, LM_dofs=2 };
+	 * 	typedef SacadoQP::BuCa< SacadoQP::SymTensor_block<3>, SacadoQP::Scalar_block, SacadoQP::LM_block > bucket;
+	 *
+	 * 	SacadoQP::set_dofs<bucket,eps_dofs>(eps);
+	 * 	SacadoQP::set_dofs<bucket,damage_dofs>(d);
+	 * 	...
+	 * 	SymmetricTensor<4,3> C = SacadoQP::get_tangent<bucket,eps_dofs>(sigma);		// d_sigma/d_eps
+	 * 	SymmetricTensor<2,3> dsigma_dd = SacadoQP::get_tangent<bucket,damage_dofs>(sigma);	// d_sigma/d_d
+	 * @endcode
+	 * Because the type of each block is known at compile time, \a get_tangent returns the tangent of the correct order,
+	 * e.g. a 4th order tensor for the derivative of a tensor with respect to a tensor block.
+	 */
+
+	// Relation between the dof-nbr x and the component (i,j) of a symmetric tensor and the factor 0.5 for the derivatives
+	// with respect to the off-diagonal components: the compile-time tables of the Sacado_Wrapper (Sacado-dof_layout.h)
+	 using Sacado_Wrapper::index_i;
+	 using Sacado_Wrapper::index_j;
+	 using Sacado_Wrapper::voigt_scale;
 
 
 	/*
-	 * Extract Derivatives
+	 * Block of AD-dofs for a SymmetricTensor<2,dim>
 	 */
-//	// @todo Currently we cannot differ between a tangent wrt to a tensor -> 4th order or wrt to a scalar -> 2th order output
-//	template<int dim>
-//	SymmetricTensor<4,dim> get_tangent ( SymmetricTensor<2,dim,fad_double> &function_f, const enums::enum_SacadoDoFs SacDoFs, BuCa<dim,fad_double> &bucket )
-//	{
-//		SymmetricTensor<4,dim> Tangent;
-//		const unsigned int start_index = bucket.start_index(SacDoFs);
-//		const unsigned int end_index = start_index + bucket.n_ADdofs(SacDoFs);
-//
-//		for ( unsigned int i=0; i<dim; ++i)
-//			for ( unsigned int j=0; j<dim; ++j )
-//			{
-//				double *derivs = &function_f[i][j].fastAccessDx(0); // Access the derivatives of the (i,j)-th component of \a sigma
-//	            // We loop over all the dofs. To be able to use this independent of the chosen dimension \a dim, we use a ternary operator
-//	            // to decide whether we have to loop over 6 derivatives or just 3.
-//	            for( unsigned int x=start_index; x < end_index; ++x )
-//	            {
-//	                unsigned int k=bucket.std_map_indicies[x].first;
-//	                unsigned int l=bucket.std_map_indicies[x].second;
-//
-//	                if(k!=l)/*Compare to Voigt notation since only SymmetricTensor instead of Tensor*/
-//	                {
-//	                    Tangent[i][j][k][l] = 0.5*derivs[x];
-//	                    Tangent[i][j][l][k] = 0.5*derivs[x];
-//	                }
-//	                else
-//	                	Tangent[i][j][k][l] = derivs[x];
-//	            }
-//			}
-//		return Tangent;
-//	}
-//	// @todo-optimize This shall just catch the error message, so we could call the get_tanget with the double data type -> better ideas?!
-//	template<int dim>
-//	SymmetricTensor<4,dim> get_tangent ( const SymmetricTensor<2,dim,double> &function_f, const enums::enum_SacadoDoFs SacDoFs, BuCa<dim,double> &bucket )
-//	{
-//		SymmetricTensor<4,dim> Tangent;
-//
-//		AssertThrow(false,ExcMessage("When using data type double, you cannot use Sacado for the tangents."));
-//		return Tangent;
-//	}
+	template<int dim>
+	struct SymTensor_block
+	{
+		static constexpr unsigned int n_dofs = ((dim==2)?3:6);
+
+		template<typename Number>
+		static void set_dofs ( SymmetricTensor<2,dim,Number> &variable_x, const unsigned int start_index, const unsigned int n_total_ADdofs )
+		{
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				variable_x[index_i<dim>(x)][index_j<dim>(x)].diff( start_index+x, n_total_ADdofs );
+		}
+
+		// Derivative of a scalar with respect to the tensor block
+		template<typename Number>
+		static enable_if_AD<Number,SymmetricTensor<2,dim,typename Number::value_type> > tangent ( const Number &function_f, const unsigned int start_index )
+		{
+			SymmetricTensor<2,dim,typename Number::value_type> Tangent;
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				Tangent[index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * function_f.fastAccessDx(start_index+x);
+			return Tangent;
+		}
+
+		// Derivative of a tensor with respect to the tensor block
+		template<typename Number>
+		static SymmetricTensor<4,dim,typename Number::value_type> tangent ( const SymmetricTensor<2,dim,Number> &function_f, const unsigned int start_index )
+		{
+			SymmetricTensor<4,dim,typename Number::value_type> Tangent;
+			for ( unsigned int y=0; y<n_dofs; ++y )
+			{
+				const unsigned int i=index_i<dim>(y);
+				const unsigned int j=index_j<dim>(y);
+				for ( unsigned int x=0; x<n_dofs; ++x )
+					Tangent[i][j][index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * function_f[i][j].fastAccessDx(start_index+x);
+			}
+			return Tangent;
+		}
+		static SymmetricTensor<4,dim> tangent ( const SymmetricTensor<2,dim,double> &/*function_f*/, const unsigned int /*start_index*/ )
+		{
+			AssertThrow(false,ExcMessage("When using data type double, you cannot use Sacado for the tangents."));
+			return SymmetricTensor<4,dim>();
+		}
+
+		// Set the derivatives of \a variable_x with respect to the tensor block, \a deriv_values being d_variable_x/d_eps
+		// (inverse of \a tangent, so the off-diagonal dofs get the factor 2)
+		template<typename Number>
+		static void set_deriv ( Number &variable_x, const unsigned int start_index, const SymmetricTensor<2,dim> &deriv_values )
+		{
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				variable_x.fastAccessDx(start_index+x) = deriv_values[index_i<dim>(x)][index_j<dim>(x)] / voigt_scale<dim>(x);
+		}
+	};
+
+
+	/*
+	 * Block of a single scalar AD-dof (e.g. damage, hardening variable)
+	 */
+	struct Scalar_block
+	{
+		static constexpr unsigned int n_dofs = 1;
+
+		template<typename Number>
+		static enable_if_AD<Number> set_dofs ( Number &variable_x, const unsigned int start_index, const unsigned int n_total_ADdofs )
+		{
+			variable_x.diff( start_index, n_total_ADdofs );
+		}
+
+		// Derivative of a scalar with respect to the scalar block
+		template<typename Number>
+		static enable_if_AD<Number,typename Number::value_type> tangent ( const Number &function_f, const unsigned int start_index )
+		{
+			return function_f.fastAccessDx(start_index);
+		}
+
+		// Derivative of a tensor with respect to the scalar block
+		template<int dim, typename Number>
+		static SymmetricTensor<2,dim,typename Number::value_type> tangent ( const SymmetricTensor<2,dim,Number> &function_f, const unsigned int start_index )
+		{
+			SymmetricTensor<2,dim,typename Number::value_type> Tangent;
+			for ( unsigned int x=0; x<SymTensor_block<dim>::n_dofs; ++x )
+				Tangent[index_i<dim>(x)][index_j<dim>(x)] = function_f[index_i<dim>(x)][index_j<dim>(x)].fastAccessDx(start_index);
+			return Tangent;
+		}
+		template<int dim>
+		static SymmetricTensor<2,dim> tangent ( const SymmetricTensor<2,dim,double> &/*function_f*/, const unsigned int /*start_index*/ )
+		{
+			AssertThrow(false,ExcMessage("When using data type double, you cannot use Sacado for the tangents."));
+			return SymmetricTensor<2,dim>();
+		}
+
+		template<typename Number>
+		static void set_deriv ( Number &variable_x, const unsigned int start_index, const double &deriv_value )
+		{
+			variable_x.fastAccessDx(start_index) = deriv_value;
+		}
+	};
+
+	/*
+	 * A Lagrange multiplier is a scalar block too (only for readability of the layout)
+	 */
+	typedef Scalar_block LM_block;
+
+
+	template<typename... Blocks>
+	struct BuCa;
+
+	template<>
+	struct BuCa<>
+	{
+		static constexpr unsigned int n_blocks = 0;
+		static constexpr unsigned int n_total_ADdofs = 0;
+	};
+
+	template<typename First, typename... Rest>
+	struct BuCa<First,Rest...>
+	{
+		static constexpr unsigned int n_blocks = 1 + sizeof...(Rest);
+		static constexpr unsigned int n_total_ADdofs = First::n_dofs + BuCa<Rest...>::n_total_ADdofs;
+
+		// Type of the block \a SacDoFs
+		template<unsigned int SacDoFs, typename dummy=void>
+		struct block
+		{
+			typedef typename BuCa<Rest...>::template block<SacDoFs-1>::type type;
+			static constexpr unsigned int start_index = First::n_dofs + BuCa<Rest...>::template block<SacDoFs-1>::start_index;
+			static constexpr unsigned int n_ADdofs = type::n_dofs;
+		};
+
+		template<typename dummy>
+		struct block<0,dummy>
+		{
+			typedef First type;
+			static constexpr unsigned int start_index = 0;
+			static constexpr unsigned int n_ADdofs = First::n_dofs;
+		};
+	};
+
+
+	/*
+	 * Set the components of the tensor as Sacado dofs of the block \a SacDoFs of the layout \a bucket
+	 * @param variable_x Cannot be used as \a const, because we set the \a diff members
+	 */
+	template<typename bucket, unsigned int SacDoFs, int dim, typename Number>
+	void set_dofs ( SymmetricTensor<2,dim,Number> &variable_x )
+	{
+		typedef typename bucket::template block<SacDoFs> block;
+		block::type::set_dofs( variable_x, block::start_index, bucket::n_total_ADdofs );
+	}
+	template<typename bucket, unsigned int SacDoFs, int dim>
+	void set_dofs ( SymmetricTensor<2,dim,double> &/*variable_x*/ )
+	{
+		AssertThrow(false,ExcMessage("When using data type double, you don't need to set_dofs for an analytical tangent."));
+	}
+
+	template<typename bucket, unsigned int SacDoFs, typename Number>
+	enable_if_AD<Number> set_dofs ( Number &variable_x2 )
+	{
+		typedef typename bucket::template block<SacDoFs> block;
+		block::type::set_dofs( variable_x2, block::start_index, bucket::n_total_ADdofs );
+	}
+	template<typename bucket, unsigned int SacDoFs>
+	void set_dofs ( double &/*variable_x2*/ )
+	{
+		AssertThrow(false,ExcMessage("When using data type double, you don't need to set_dofs for an analytical tangent."));
+	}
+
+
+	/*
+	 * Extract the derivatives of \a function_f (scalar or SymmetricTensor<2,dim>) with respect to the block \a SacDoFs.
+	 * The order of the returned tangent follows from the type of the block.
+	 */
+	template<typename bucket, unsigned int SacDoFs, typename Argument>
+	auto get_tangent ( const Argument &function_f )
+	-> decltype( bucket::template block<SacDoFs>::type::tangent(function_f, 0u) )
+	{
+		typedef typename bucket::template block<SacDoFs> block;
+		return block::type::tangent( function_f, block::start_index );
+	}
+	// @todo-optimize This shall just catch the error message, so we could call the get_tangent with the double data type
+	template<typename bucket, unsigned int SacDoFs>
+	double get_tangent ( const double &/*function_f*/ )
+	{
+		AssertThrow(false,ExcMessage("When using data type double, you cannot use Sacado for the tangents."));
+		return 0.;
+	}
+
+
+	/*
+	 * Set the derivatives of \a variable_x with respect to the block \a SacDoFs to \a deriv_values
+	 * (double for a scalar block, SymmetricTensor<2,dim> for a tensor block)
+	 */
+	template<typename bucket, unsigned int SacDoFs, typename Number, typename DerivValue>
+	enable_if_AD<Number> set_deriv ( Number &variable_x, const DerivValue &deriv_values )
+	{
+		typedef typename bucket::template block<SacDoFs> block;
+		block::type::set_deriv( variable_x, block::start_index, deriv_values );
+	}
+	template<typename bucket, unsigned int SacDoFs, typename DerivValue>
+	void set_deriv ( double &/*variable_x*/, const DerivValue &/*deriv_values*/ )
+	{
+		AssertThrow(false,ExcMessage("When using data type double, you cannot use this function."));
+	}
+
 
 
 
@@ -438,5 +482,5 @@ namespace SacadoQP
 }
 
 
-#endif // Sacado_Wrapper_H
+#endif // SacadoQP_Wrapper_H
 
@@ -0,0 +1,379 @@
+/*
+ * Material point driver: Evaluate a material model through the Sacado_Wrapper for every point of a strain path
+ *
+ * Instead of hacking the main() of the examples, the strain path (strain components and the scalar phi for each point or
+ * load step) is read from a file, the model is evaluated for all points on all cores and the stress, the tangent and the
+ * coupling d_sigma_d_phi are written to a file together with a timing summary.
+ *
+ * Usage:
+ * @code
+ * 	material_point_driver [--model elastic|eps_phi|energy] [--threads n] [--chunk n] [--output file] [--append] strain_path.txt
+ * 	material_point_driver [--model ...] strain_path.bin
+ * 	material_point_driver [--model ...] --synthetic n_points
+ * @endcode
+ * Files with the extension ".bin" are binary point files (see point_binary_io.h, convert them from/to text with point_convert).
+ * A binary strain path is not read into memory, but mapped and evaluated block by block, where the strains are viewed
+ * directly in the mapped blocks. A binary output is written (and with --append continued) block by block as well.
+ *
+ * With MPI (deal.II configured with MPI), the points can be distributed over several processes, e.g. on one machine
+ * @code
+ * 	mpirun -np 4 material_point_driver [--batch n] [--threads n] ... strain_path.bin
+ * @endcode
+ * where rank 0 hands out batches of points on request and writes the results and the other ranks evaluate them (see
+ * mpi_ensemble.h). Without --threads, rank 0 keeps one core and the workers share the others evenly.
+ * The points are independent, so they are evaluated in chunks by a persistent ThreadPool (see thread_pool.h), where each
+ * thread reseeds its own wrapper variables (the \a Scratch of the model, see point_models.h).
+ */
+
+// @section includes Include Files
+#include <deal.II/base/timer.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/mpi.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "thread_pool.h"
+#include "point_models.h"
+#include "point_io.h"
+#include "mpi_ensemble.h"
+
+using namespace dealii;
+
+
+struct DriverSettings
+{
+	std::string model = "eps_phi";
+	std::string input;
+	std::string output = "results.txt";	// "none" to skip the output
+	bool append = false;
+	bool threads_given = false;
+	unsigned int n_synthetic_points = 0;
+	unsigned int n_threads = MultithreadInfo::n_cores();
+	unsigned int chunk_size = 1000;
+	unsigned int batch_size = 10000;	// points per MPI message
+
+	void parse ( const int argc, char **argv );
+};
+
+
+/*
+ * The value of the option \a option as an unsigned int, where anything but a complete non-negative integer (e.g. "abc",
+ * "4x", "-1") is rejected
+ */
+unsigned int parse_unsigned ( const std::string &option, const std::string &value )
+{
+	unsigned long number = 0;
+	std::size_t n_read = 0;
+	try
+	{
+		if ( !value.empty() && std::isdigit(static_cast<unsigned char>(value[0])) )
+			number = std::stoul( value, &n_read );
+	}
+	catch ( std::logic_error & )	// std::invalid_argument and std::out_of_range
+	{
+		n_read = 0;
+	}
+	AssertThrow( n_read>0 && n_read==value.size() && number<=std::numeric_limits<unsigned int>::max(),
+				 ExcMessage("material_point_driver: The value '"+value+"' of "+option+" is not a non-negative integer.") );
+	return number;
+}
+
+
+void DriverSettings::parse ( const int argc, char **argv )
+{
+	for ( int i=1; i<argc; ++i )
+	{
+		const std::string arg = argv[i];
+		const auto value = [&] () -> std::string
+		{
+			AssertThrow( i+1<argc, ExcMessage("material_point_driver: The option "+arg+" needs a value.") );
+			return argv[++i];
+		};
+
+		if ( arg=="--model" )
+			model = value();
+		else if ( arg=="--threads" )
+		{
+			n_threads = parse_unsigned(arg, value());
+			threads_given = true;
+		}
+		else if ( arg=="--batch" )
+			batch_size = parse_unsigned(arg, value());
+		else if ( arg=="--chunk" )
+			chunk_size = parse_unsigned(arg, value());
+		else if ( arg=="--output" )
+			output = value();
+		else if ( arg=="--append" )
+			append = true;
+		else if ( arg=="--synthetic" )
+			n_synthetic_points = parse_unsigned(arg, value());
+		// An unknown option would otherwise be taken as the strain path
+		 else if ( arg.size()>1 && arg[0]=='-' )
+			AssertThrow( false, ExcMessage("material_point_driver: Unknown option "+arg+" (see material_point_driver.cc).") );
+		 else
+		 {
+			AssertThrow( input.empty(), ExcMessage("material_point_driver: Give only one strain path file ('"+input+"', '"+arg+"').") );
+			input = arg;
+		 }
+	}
+
+	// Share the cores among the MPI processes on one machine: the master (rank 0) only hands out the batches and writes the
+	// results with a single thread, so the workers split the remaining cores (\a n_threads is the number per worker)
+	 const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+	 if ( !threads_given && n_ranks>1 )
+		n_threads = std::max( 1u, (MultithreadInfo::n_cores()-1)/(n_ranks-1) );
+
+	AssertThrow( !input.empty() || n_synthetic_points>0,
+				 ExcMessage("material_point_driver: Give a strain path file or --synthetic n_points.") );
+	AssertThrow( n_threads>0, ExcMessage("material_point_driver: The number of threads must be positive.") );
+	AssertThrow( batch_size>0, ExcMessage("material_point_driver: The batch size must be positive.") );
+}
+
+
+/*
+ * Evaluate the \a model for the points [begin,end) of the strains \a eps and the scalars \a phi and store the results at
+ * \a offset + p
+ */
+template<typename Model>
+void evaluate_range ( const Model &model, const Sacado_Wrapper::SymTensorBatch<3> &eps, const double *phi,
+					  const unsigned int begin, const unsigned int end, typename Model::Scratch &scratch,
+					  PointIO::PointResults &results, const unsigned int offset )
+{
+	SymmetricTensor<2,3> sigma, d_sigma_d_phi;
+	SymmetricTensor<4,3> C;
+	for ( unsigned int p=begin; p<end; ++p )
+	{
+		model.evaluate( eps.get(p), phi[p], scratch, sigma, C, d_sigma_d_phi );
+
+		results.sigma.set(offset+p, sigma);
+		results.C.set(offset+p, C);
+		results.d_sigma_d_phi.set(offset+p, d_sigma_d_phi);
+	}
+}
+
+
+/*
+ * Evaluate the \a model for all points of the \a path with the threads of the \a pool
+ */
+template<typename Model>
+void evaluate_points ( const Model &model, const PointIO::StrainPath &path, PointIO::PointResults &results,
+					   ThreadPool &pool, const unsigned int chunk_size )
+{
+	results.reinit( path.size() );
+
+	std::vector<typename Model::Scratch> scratch ( pool.n_threads() );
+
+	pool.parallel_for( 0, path.size(), chunk_size, [&] (const unsigned int begin, const unsigned int end, const unsigned int thread)
+	{
+		evaluate_range( model, path.eps, path.phi.data(), begin, end, scratch[thread], results, 0 );
+	});
+}
+
+
+template<typename Model>
+void run ( const DriverSettings &settings )
+{
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	timer.enter_subsection("Read strain path");
+	 const PointIO::StrainPath path = ( settings.n_synthetic_points>0 )
+									  ? PointIO::synthetic_strain_path(settings.n_synthetic_points)
+									  : PointIO::read_strain_path_text(settings.input);
+	timer.leave_subsection();
+
+	timer.enter_subsection("Start threads");
+	 ThreadPool pool (settings.n_threads);
+	timer.leave_subsection();
+
+	PointIO::PointResults results;
+	const Model model = Model();
+
+	Timer evaluation_timer;
+	timer.enter_subsection("Evaluate model");
+	 evaluate_points( model, path, results, pool, settings.chunk_size );
+	timer.leave_subsection();
+	evaluation_timer.stop();
+
+	timer.enter_subsection("Write results");
+	 PointIO::ResultsWriter writer (settings.output, settings.append);
+	 writer.write( results, path.size() );
+	timer.leave_subsection();
+
+	std::cout << "Material point driver: model " << Model::name() << ", " << path.size() << " points, "
+			  << pool.n_threads() << " threads, " << path.size()/evaluation_timer.wall_time() << " points/s" << std::endl;
+}
+
+
+/*
+ * Evaluate the \a model for a binary strain path: The blocks of the mapped file are processed in windows of a few blocks
+ * per thread, where every thread views its blocks (no copy of the strains) and the results of a window are written
+ * before the next window is evaluated.
+ */
+template<typename Model>
+void run_binary ( const DriverSettings &settings )
+{
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	timer.enter_subsection("Map strain path");
+	 PointIO::BinaryPointFile file (settings.input);
+	 const unsigned int n_dofs = Sacado_Wrapper::SymTensorBatch<3>::n_dofs;
+	 AssertThrow( file.n_fields()>=n_dofs,
+				  ExcMessage("material_point_driver: The binary strain path '"+settings.input+"' needs 6 strain components.") );
+	 const bool has_phi = ( file.n_fields()>n_dofs );
+	 const std::vector<double> zero_phi ( file.block_size(), 0. );
+	timer.leave_subsection();
+
+	timer.enter_subsection("Start threads");
+	 ThreadPool pool (settings.n_threads);
+	timer.leave_subsection();
+
+	const Model model = Model();
+	std::vector<typename Model::Scratch> scratch ( pool.n_threads() );
+	std::vector<Sacado_Wrapper::SymTensorBatch<3> > eps ( pool.n_threads() );
+
+	const std::uint64_t n_blocks_per_window = 4 * pool.n_threads();
+	PointIO::PointResults results;
+	results.reinit( n_blocks_per_window * file.block_size() );
+	PointIO::ResultsWriter writer (settings.output, settings.append);
+
+	Timer evaluation_timer;
+	evaluation_timer.stop();
+	for ( std::uint64_t window_begin=0; window_begin<file.n_blocks(); window_begin+=n_blocks_per_window )
+	{
+		const std::uint64_t window_end = std::min( window_begin+n_blocks_per_window, file.n_blocks() );
+
+		evaluation_timer.start();
+		timer.enter_subsection("Evaluate model");
+		 pool.parallel_for( 0, window_end-window_begin, 1, [&] (const unsigned int begin, const unsigned int end, const unsigned int thread)
+		 {
+			for ( unsigned int w=begin; w<end; ++w )
+			{
+				const std::uint64_t b = window_begin + w;
+				file.view( b, 0, eps[thread] );
+				const double *phi = has_phi ? file.field(b,n_dofs) : zero_phi.data();
+				evaluate_range( model, eps[thread], phi, 0, eps[thread].size(), scratch[thread], results, w*file.block_size() );
+			}
+		 });
+		timer.leave_subsection();
+		evaluation_timer.stop();
+
+		// Only the last block of the file is partially filled, so the valid results are contiguous
+		 timer.enter_subsection("Write results");
+		  const std::uint64_t n_points_window = std::min<std::uint64_t>( (window_end-window_begin)*file.block_size(),
+																		  file.n_points() - window_begin*file.block_size() );
+		  writer.write( results, n_points_window );
+		 timer.leave_subsection();
+	}
+
+	std::cout << "Material point driver: model " << Model::name() << ", " << file.n_points() << " points (binary), "
+			  << pool.n_threads() << " threads, " << file.n_points()/evaluation_timer.wall_time() << " points/s" << std::endl;
+}
+
+
+#ifdef DEAL_II_WITH_MPI
+/*
+ * Evaluate the \a model on all MPI processes, where rank 0 distributes the points (see mpi_ensemble.h)
+ */
+template<typename Model>
+void run_ensemble ( const DriverSettings &settings )
+{
+	const bool is_master = ( Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0 );
+	Timer wall_timer;
+	MPIEnsemble::RankStatistics statistics;
+
+	if ( is_master )
+	{
+		TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+		PointIO::ResultsWriter writer (settings.output, settings.append);
+
+		if ( settings.n_synthetic_points==0 && PointIO::is_binary_file(settings.input) )
+		{
+			timer.enter_subsection("Map strain path");
+			 PointIO::BinaryPointFile file (settings.input);
+			timer.leave_subsection();
+			MPIEnsemble::run_master( file, settings.batch_size, writer, timer );
+		}
+		else
+		{
+			timer.enter_subsection("Read strain path");
+			 const PointIO::StrainPath path = ( settings.n_synthetic_points>0 )
+											  ? PointIO::synthetic_strain_path(settings.n_synthetic_points)
+											  : PointIO::read_strain_path_text(settings.input);
+			timer.leave_subsection();
+			MPIEnsemble::run_master( path, settings.batch_size, writer, timer );
+		}
+	}
+	else
+	{
+		ThreadPool pool (settings.n_threads);
+		statistics = MPIEnsemble::run_worker( Model(), pool, settings.chunk_size );
+	}
+
+	wall_timer.stop();
+	if ( is_master )
+		std::cout << "Material point driver: model " << Model::name() << ", " << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+				  << " processes with " << settings.n_threads << " threads per worker" << std::endl;
+	MPIEnsemble::report( statistics, Utilities::MPI::max(wall_timer.wall_time(), MPI_COMM_WORLD) );
+}
+#endif
+
+
+template<typename Model>
+void run_model ( const DriverSettings &settings )
+{
+#ifdef DEAL_II_WITH_MPI
+	if ( Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)>1 )
+	{
+		run_ensemble<Model>(settings);
+		return;
+	}
+#endif
+
+	if ( settings.n_synthetic_points==0 && PointIO::is_binary_file(settings.input) )
+		run_binary<Model>(settings);
+	else
+		run<Model>(settings);
+}
+
+
+int main ( int argc, char **argv )
+{
+	// numbers::invalid_unsigned_int limits the threads of deal.II (TBB) to the share of the cores of this process on its
+	// machine. The evaluation runs on the threads of the driver's own ThreadPool instead, whose number is set in
+	// DriverSettings::parse. (MPI is only initialised, if deal.II has been built with it)
+	 Utilities::MPI::MPI_InitFinalize mpi_initialization (argc, argv, numbers::invalid_unsigned_int);
+
+	try
+	{
+		DriverSettings settings;
+		settings.parse(argc, argv);
+
+		if ( settings.model==PointModels::Elastic::name() )
+			run_model<PointModels::Elastic>(settings);
+		else if ( settings.model==PointModels::EpsPhi::name() )
+			run_model<PointModels::EpsPhi>(settings);
+		else if ( settings.model==PointModels::Energy::name() )
+			run_model<PointModels::Energy>(settings);
+		else
+			AssertThrow( false, ExcMessage("material_point_driver: Unknown model '"+settings.model+"' (elastic, eps_phi, energy).") );
+	}
+	catch ( std::exception &exc )
+	{
+		std::cerr << exc.what() << std::endl;
+#ifdef DEAL_II_WITH_MPI
+		// The other processes would wait for messages forever
+		 if ( Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)>1 )
+			MPI_Abort( MPI_COMM_WORLD, 1 );
+#endif
+		return 1;
+	}
+
+	return 0;
+}
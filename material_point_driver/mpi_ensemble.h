@@ -0,0 +1,305 @@
+#ifndef mpi_ensemble_H
+#define mpi_ensemble_H
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/timer.h>
+
+#ifdef DEAL_II_WITH_MPI
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+
+#include "thread_pool.h"
+#include "point_io.h"
+
+using namespace dealii;
+
+/*
+ * Ensemble evaluation of material points on several MPI processes (master-worker with dynamic load balancing)
+ *
+ * The master (rank 0) owns the strain path and the output, the workers (ranks 1 ... n-1) evaluate the model with their
+ * own ThreadPool. Every worker asks for work, receives a batch of points, evaluates it and sends the results back, which is
+ * also the request for the next batch. Hence, fast ranks simply get more batches, without any cost model.
+ *
+ * The master hands out the points in windows of a few batches per worker and writes the results of a window once it is
+ * complete, so neither the master nor the workers keep the results of all points.
+ *
+ * Messages (all as MPI_DOUBLE, the first two entries are the first point and the number of points of the batch):
+ * - work:    begin, n, eps (6 components, each for n points), phi (n points)
+ * - results: begin, n, sigma (6 x n), C (36 x n, row-major in the dof order), d_sigma_d_phi (6 x n)
+ * The first request of a worker is an empty results message and the master ends the work with an empty stop message.
+ */
+namespace MPIEnsemble
+{
+	enum Tags
+	{
+		tag_results = 1,
+		tag_work = 2,
+		tag_stop = 3
+	};
+
+	const unsigned int n_dofs = Sacado_Wrapper::SymTensorBatch<3>::n_dofs;
+	const unsigned int n_header = 2;
+
+
+	// Copy the strains and phi of the points [begin,begin+n) of the \a path component-major to \a eps_phi
+	 inline void pack_points ( const PointIO::StrainPath &path, const std::uint64_t begin, const unsigned int n, double *eps_phi )
+	 {
+		for ( unsigned int x=0; x<n_dofs; ++x )
+			std::copy( path.eps.component(x)+begin, path.eps.component(x)+begin+n, eps_phi + x*n );
+		std::copy( path.phi.begin()+begin, path.phi.begin()+begin+n, eps_phi + n_dofs*n );
+	 }
+
+	// The same for a binary strain path, where the batch may reach over several blocks (phi is zero without a seventh field)
+	 inline void pack_points ( PointIO::BinaryPointFile &file, const std::uint64_t begin, const unsigned int n, double *eps_phi )
+	 {
+		const unsigned int block_size = file.block_size();
+		for ( unsigned int p=0; p<n; )
+		{
+			const std::uint64_t b = (begin+p) / block_size;
+			const unsigned int q = (begin+p) % block_size;
+			const unsigned int n_copy = std::min( n-p, block_size-q );
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				std::copy( file.field(b,x)+q, file.field(b,x)+q+n_copy, eps_phi + x*n + p );
+			if ( file.n_fields()>n_dofs )
+				std::copy( file.field(b,n_dofs)+q, file.field(b,n_dofs)+q+n_copy, eps_phi + n_dofs*n + p );
+			else
+				std::fill( eps_phi + n_dofs*n + p, eps_phi + n_dofs*n + p + n_copy, 0. );
+			p += n_copy;
+		}
+	 }
+
+	 inline std::uint64_t n_points ( const PointIO::StrainPath &path ) { return path.size(); }
+	 inline std::uint64_t n_points ( const PointIO::BinaryPointFile &file ) { return file.n_points(); }
+
+
+	// Pack the first \a n points of the \a results component-major behind the \a header
+	 inline void pack_results ( const PointIO::PointResults &results, const unsigned int n, std::vector<double> &buffer )
+	 {
+		double *values = buffer.data() + n_header;
+		for ( unsigned int y=0; y<n_dofs; ++y, values+=n )
+			std::copy( results.sigma.component(y), results.sigma.component(y)+n, values );
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x, values+=n )
+				std::copy( results.C.component(y,x), results.C.component(y,x)+n, values );
+		for ( unsigned int y=0; y<n_dofs; ++y, values+=n )
+			std::copy( results.d_sigma_d_phi.component(y), results.d_sigma_d_phi.component(y)+n, values );
+	 }
+
+	// Unpack the results of a batch with \a n points to the points \a offset ... \a offset+n-1 of the \a results
+	 inline void unpack_results ( const double *values, const unsigned int n, PointIO::PointResults &results, const unsigned int offset )
+	 {
+		for ( unsigned int y=0; y<n_dofs; ++y, values+=n )
+			std::copy( values, values+n, results.sigma.component(y)+offset );
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x, values+=n )
+				std::copy( values, values+n, results.C.component(y,x)+offset );
+		for ( unsigned int y=0; y<n_dofs; ++y, values+=n )
+			std::copy( values, values+n, results.d_sigma_d_phi.component(y)+offset );
+	 }
+
+
+	/*
+	 * The work of one rank, gathered on the master for the report
+	 */
+	struct RankStatistics
+	{
+		double n_points = 0;
+		double n_batches = 0;
+		double evaluation_time = 0;	// wall time spent in the model evaluation
+		double total_time = 0;		// wall time from the first request to the stop message
+	};
+
+
+	/*
+	 * Master: Hand out the points of the \a source in batches of \a batch_size points on request and write the results
+	 */
+	template<typename Source>
+	void run_master ( Source &source, const unsigned int batch_size, PointIO::ResultsWriter &writer, TimerOutput &timer )
+	{
+		const unsigned int n_workers = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD) - 1;
+		AssertThrow( n_workers>0, ExcMessage("MPIEnsemble: The master needs at least one worker.") );
+
+		const std::uint64_t n_total = n_points(source);
+		const std::uint64_t window_size = std::uint64_t(4) * n_workers * batch_size;
+
+		PointIO::PointResults results;
+		results.reinit( std::min(window_size, n_total) );
+
+		std::vector<double> work ( n_header + (n_dofs+1)*batch_size );
+		std::vector<double> received;
+		std::vector<int> idle_workers;
+
+		for ( std::uint64_t window_begin=0; window_begin<n_total; window_begin+=window_size )
+		{
+			const std::uint64_t window_end = std::min( window_begin+window_size, n_total );
+			std::uint64_t next_begin = window_begin;
+			std::uint64_t n_received = 0;
+
+			timer.enter_subsection("Distribute and gather (MPI)");
+			 // Send a batch of the window to the \a worker, returns false if the window has been handed out completely
+			  auto send_work = [&] ( const int worker ) -> bool
+			  {
+				if ( next_begin>=window_end )
+					return false;
+				const unsigned int n = std::min<std::uint64_t>( batch_size, window_end-next_begin );
+				work[0] = next_begin;
+				work[1] = n;
+				pack_points( source, next_begin, n, work.data()+n_header );
+				MPI_Send( work.data(), n_header+(n_dofs+1)*n, MPI_DOUBLE, worker, tag_work, MPI_COMM_WORLD );
+				next_begin += n;
+				return true;
+			  };
+
+			 // Serve the workers that waited for the previous window to be written
+			  std::vector<int> still_idle;
+			  for ( const int worker : idle_workers )
+				if ( !send_work(worker) )
+					still_idle.push_back(worker);
+			  idle_workers.swap(still_idle);
+
+			 while ( n_received < window_end-window_begin )
+			 {
+				MPI_Status status;
+				MPI_Probe( MPI_ANY_SOURCE, tag_results, MPI_COMM_WORLD, &status );
+				int count = 0;
+				MPI_Get_count( &status, MPI_DOUBLE, &count );
+				received.resize( count );
+				MPI_Recv( received.data(), count, MPI_DOUBLE, status.MPI_SOURCE, tag_results, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+
+				if ( count>0 )
+				{
+					const std::uint64_t begin = received[0];
+					const unsigned int n = received[1];
+					unpack_results( received.data()+n_header, n, results, begin-window_begin );
+					n_received += n;
+				}
+
+				if ( !send_work(status.MPI_SOURCE) )
+					idle_workers.push_back(status.MPI_SOURCE);
+			 }
+			timer.leave_subsection();
+
+			timer.enter_subsection("Write results");
+			 writer.write( results, window_end-window_begin );
+			timer.leave_subsection();
+		}
+
+		// Collect the first requests of workers that did not get any work and stop all workers
+		 while ( idle_workers.size()<n_workers )
+		 {
+			MPI_Status status;
+			MPI_Recv( nullptr, 0, MPI_DOUBLE, MPI_ANY_SOURCE, tag_results, MPI_COMM_WORLD, &status );
+			idle_workers.push_back(status.MPI_SOURCE);
+		 }
+		 for ( const int worker : idle_workers )
+			MPI_Send( nullptr, 0, MPI_DOUBLE, worker, tag_stop, MPI_COMM_WORLD );
+	}
+
+
+	/*
+	 * Worker: Request batches, evaluate them with the threads of the \a pool and send the results back until the master stops
+	 */
+	template<typename Model>
+	RankStatistics run_worker ( const Model &model, ThreadPool &pool, const unsigned int chunk_size )
+	{
+		RankStatistics statistics;
+		Timer total_timer, evaluation_timer;
+		evaluation_timer.stop();
+
+		std::vector<typename Model::Scratch> scratch ( pool.n_threads() );
+		std::vector<double> work, results_buffer;
+		PointIO::PointResults results;
+		Sacado_Wrapper::SymTensorBatch<3> eps;
+
+		// The first request
+		 MPI_Send( nullptr, 0, MPI_DOUBLE, 0, tag_results, MPI_COMM_WORLD );
+
+		while ( true )
+		{
+			MPI_Status status;
+			MPI_Probe( 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status );
+			int count = 0;
+			MPI_Get_count( &status, MPI_DOUBLE, &count );
+			work.resize( count );
+			MPI_Recv( work.data(), count, MPI_DOUBLE, 0, status.MPI_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE );
+			if ( status.MPI_TAG==tag_stop )
+				break;
+
+			const unsigned int n = work[1];
+			results.reinit(n);
+			// View the strains in the message buffer (zero-copy), phi follows the six components
+			 eps.reinit_view( work.data()+n_header, n, n );
+			 const double *phi = work.data() + n_header + n_dofs*n;
+
+			evaluation_timer.start();
+			 pool.parallel_for( 0, n, chunk_size, [&] (const unsigned int begin, const unsigned int end, const unsigned int thread)
+			 {
+				SymmetricTensor<2,3> sigma, d_sigma_d_phi;
+				SymmetricTensor<4,3> C;
+				for ( unsigned int p=begin; p<end; ++p )
+				{
+					model.evaluate( eps.get(p), phi[p], scratch[thread], sigma, C, d_sigma_d_phi );
+					results.sigma.set(p, sigma);
+					results.C.set(p, C);
+					results.d_sigma_d_phi.set(p, d_sigma_d_phi);
+				}
+			 });
+			evaluation_timer.stop();
+
+			results_buffer.resize( n_header + PointIO::ResultsWriter::n_result_fields*n );
+			results_buffer[0] = work[0];
+			results_buffer[1] = n;
+			pack_results( results, n, results_buffer );
+			MPI_Send( results_buffer.data(), results_buffer.size(), MPI_DOUBLE, 0, tag_results, MPI_COMM_WORLD );
+
+			statistics.n_points += n;
+			statistics.n_batches += 1;
+		}
+
+		statistics.evaluation_time = evaluation_timer.wall_time();
+		statistics.total_time = total_timer.wall_time();
+		return statistics;
+	}
+
+
+	/*
+	 * Gather the statistics of all ranks on the master and print the throughput per rank and the load imbalance of the
+	 * workers (maximum over mean evaluation time minus one, 0 for a perfect balance)
+	 */
+	inline void report ( const RankStatistics &statistics, const double wall_time )
+	{
+		const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+		const unsigned int n_values = sizeof(RankStatistics)/sizeof(double);
+
+		std::vector<RankStatistics> all ( n_ranks );
+		MPI_Gather( &statistics, n_values, MPI_DOUBLE, all.data(), n_values, MPI_DOUBLE, 0, MPI_COMM_WORLD );
+
+		if ( Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)!=0 )
+			return;
+
+		double n_points = 0, max_time = 0, sum_time = 0;
+		std::cout << std::endl << "rank   points      batches   evaluation [s]   points/s" << std::endl;
+		for ( unsigned int rank=1; rank<n_ranks; ++rank )
+		{
+			const RankStatistics &s = all[rank];
+			std::cout << std::setw(4) << rank << "   " << std::setw(10) << s.n_points << "  " << std::setw(8) << s.n_batches
+					  << "   " << std::setw(14) << s.evaluation_time << "   "
+					  << ( (s.evaluation_time>0) ? s.n_points/s.evaluation_time : 0. ) << std::endl;
+			n_points += s.n_points;
+			max_time = std::max( max_time, s.evaluation_time );
+			sum_time += s.evaluation_time;
+		}
+		const double mean_time = sum_time / (n_ranks-1);
+		std::cout << "Ensemble: " << n_points << " points on " << n_ranks-1 << " workers, " << n_points/wall_time << " points/s, "
+				  << "imbalance " << ( (mean_time>0) ? max_time/mean_time-1. : 0. ) << std::endl;
+	}
+}
+
+#endif // DEAL_II_WITH_MPI
+
+#endif // mpi_ensemble_H
@@ -0,0 +1,375 @@
+#ifndef point_binary_io_H
+#define point_binary_io_H
+
+#include <deal.II/base/exceptions.h>
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+
+// POSIX memory mapping
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Sacado-qp_batch.h"
+
+using namespace dealii;
+
+/*
+ * Compact binary layout for large strain paths and results of the material point driver
+ *
+ * A file consists of a header of 64 bytes followed by blocks of \a block_size points. Every block stores the \a n_fields
+ * values of its points field-major (all points of field 0, then all points of field 1, ...), which is the component-major
+ * layout of the batch containers in Sacado-qp_batch.h. Hence, the first six fields of a block can be viewed by a
+ * SymTensorBatch without copying anything (see \a BinaryPointFile::view). The last block is padded with zeros, such that
+ * all blocks have the same size and the file can be appended to block by block.
+ *
+ * Field conventions of the driver:
+ * - strain path: eps (6 components in the dof order of the wrapper), phi, optionally further scalar fields
+ * - results: sigma (6), C (6x6, row-major in the dof order), d_sigma_d_phi (6), optionally internal variables
+ *
+ * The values are stored as double in the byte order of the machine that wrote the file, so the files are meant for
+ * the exchange between runs on the same kind of machine and not as an archive format.
+ */
+namespace PointIO
+{
+	struct BinaryHeader
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t n_fields;
+		std::uint32_t block_size;
+		std::uint32_t reserved_0;
+		std::uint64_t n_points;
+		std::uint64_t reserved[4];
+
+		static const char *magic_string () { return "SWPOINT"; }
+		static const std::uint32_t current_version = 1;
+
+		// The block size is a multiple of 8, such that every field of a block starts at a 64 byte boundary
+		 static const std::uint32_t block_alignment = 8;
+
+		BinaryHeader ( const unsigned int n_fields=0, const unsigned int block_size=1024 );
+
+		void check ( const std::string &filename ) const;
+
+		std::uint64_t n_blocks () const { return (n_points+block_size-1)/block_size; }
+
+		// Number of doubles per block and the offset of the block \a b from the begin of the file in bytes
+		 std::uint64_t block_length () const { return std::uint64_t(n_fields)*block_size; }
+		 std::uint64_t block_offset ( const std::uint64_t b ) const { return sizeof(BinaryHeader) + b*block_length()*sizeof(double); }
+	};
+
+	static_assert( sizeof(BinaryHeader)==64, "PointIO::BinaryHeader: The header must occupy 64 bytes." );
+
+
+	inline BinaryHeader::BinaryHeader ( const unsigned int n_fields, const unsigned int block_size )
+	:
+	version(current_version),
+	n_fields(n_fields),
+	block_size(block_size),
+	reserved_0(0),
+	n_points(0)
+	{
+		std::memset( magic, 0, sizeof(magic) );
+		std::memcpy( magic, magic_string(), std::strlen(magic_string()) );
+		std::fill( reserved, reserved+4, 0 );
+	}
+
+
+	inline void BinaryHeader::check ( const std::string &filename ) const
+	{
+		AssertThrow( std::strncmp(magic, magic_string(), sizeof(magic))==0,
+					 ExcMessage("PointIO: '"+filename+"' is not a binary point file.") );
+		AssertThrow( version==current_version,
+					 ExcMessage("PointIO: '"+filename+"' has the unsupported version "+std::to_string(version)+".") );
+		AssertThrow( n_fields>0 && block_size>0 && block_size%block_alignment==0,
+					 ExcMessage("PointIO: The header of '"+filename+"' is corrupted.") );
+	}
+
+
+	/*
+	 * Read-only access to a binary point file via mmap
+	 *
+	 * The file is mapped privately (copy-on-write), so the blocks can be handed to the batch containers as \a double*
+	 * without ever modifying the file. The mapping lives as long as the BinaryPointFile, hence all views must be dropped
+	 * before it is destroyed.
+	 */
+	class BinaryPointFile
+	{
+	public:
+		explicit BinaryPointFile ( const std::string &filename );
+
+		~BinaryPointFile ();
+
+		BinaryPointFile ( const BinaryPointFile & ) = delete;
+		BinaryPointFile &operator= ( const BinaryPointFile & ) = delete;
+
+		const BinaryHeader &header () const { return *reinterpret_cast<const BinaryHeader*>(mapping); }
+
+		unsigned int n_fields () const { return header().n_fields; }
+		unsigned int block_size () const { return header().block_size; }
+		std::uint64_t n_points () const { return header().n_points; }
+		std::uint64_t n_blocks () const { return header().n_blocks(); }
+
+		// The number of valid (not padded) points in the block \a b
+		 unsigned int n_points_in_block ( const std::uint64_t b ) const;
+
+		// The values of the field \a field for all points of the block \a b
+		 double *field ( const std::uint64_t b, const unsigned int field );
+
+		/*
+		 * Let the \a batch view the six consecutive fields starting at \a first_field of the block \a b (zero-copy)
+		 */
+		 void view ( const std::uint64_t b, const unsigned int first_field, Sacado_Wrapper::SymTensorBatch<3> &batch );
+
+	private:
+		std::string filename;
+		char *mapping = nullptr;
+		std::size_t mapping_size = 0;
+	};
+
+
+	inline BinaryPointFile::BinaryPointFile ( const std::string &filename )
+	:
+	filename(filename)
+	{
+		const int fd = ::open( filename.c_str(), O_RDONLY );
+		AssertThrow( fd>=0, ExcMessage("PointIO: Cannot open the binary point file '"+filename+"'.") );
+
+		struct stat file_status;
+		const bool stat_ok = ( ::fstat(fd, &file_status)==0 );
+		mapping_size = stat_ok ? file_status.st_size : 0;
+		if ( mapping_size>=sizeof(BinaryHeader) )
+		{
+			void *address = ::mmap( nullptr, mapping_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0 );
+			mapping = ( address==MAP_FAILED ) ? nullptr : static_cast<char*>(address);
+		}
+		::close(fd);
+
+		AssertThrow( mapping!=nullptr, ExcMessage("PointIO: Cannot map the binary point file '"+filename+"'.") );
+
+		// The destructor does not run if the constructor throws, so unmap the file here
+		 try
+		 {
+			header().check(filename);
+			AssertThrow( header().block_offset(n_blocks())<=mapping_size,
+						 ExcMessage("PointIO: The binary point file '"+filename+"' is truncated.") );
+		 }
+		 catch ( ... )
+		 {
+			::munmap( mapping, mapping_size );
+			mapping = nullptr;
+			throw;
+		 }
+	}
+
+
+	inline BinaryPointFile::~BinaryPointFile ()
+	{
+		if ( mapping!=nullptr )
+			::munmap( mapping, mapping_size );
+	}
+
+
+	inline unsigned int BinaryPointFile::n_points_in_block ( const std::uint64_t b ) const
+	{
+		Assert( b<n_blocks(), ExcIndexRange(b,0,n_blocks()) );
+		return std::min<std::uint64_t>( block_size(), n_points() - b*block_size() );
+	}
+
+
+	inline double *BinaryPointFile::field ( const std::uint64_t b, const unsigned int field )
+	{
+		Assert( b<n_blocks(), ExcIndexRange(b,0,n_blocks()) );
+		Assert( field<n_fields(), ExcIndexRange(field,0,n_fields()) );
+		return reinterpret_cast<double*>( mapping + header().block_offset(b) ) + std::uint64_t(field)*block_size();
+	}
+
+
+	inline void BinaryPointFile::view ( const std::uint64_t b, const unsigned int first_field, Sacado_Wrapper::SymTensorBatch<3> &batch )
+	{
+		AssertThrow( first_field + Sacado_Wrapper::SymTensorBatch<3>::n_dofs <= n_fields(),
+					 ExcMessage("PointIO: '"+filename+"' has too few fields for a SymmetricTensor.") );
+		batch.reinit_view( field(b,first_field), n_points_in_block(b), block_size() );
+	}
+
+
+	/*
+	 * Appending writer for binary point files
+	 *
+	 * The points are collected in a buffer of one block, which is written once it is full. An existing file with the same
+	 * number of fields is continued: its padded last block is read back into the buffer and overwritten later on. The header
+	 * (number of points) is updated by \a flush and by the destructor.
+	 */
+	class BinaryPointWriter
+	{
+	public:
+		// Create the file \a filename or append to it, if it exists (\a block_size is only used for new files)
+		 BinaryPointWriter ( const std::string &filename, const unsigned int n_fields, const unsigned int block_size=1024 );
+
+		~BinaryPointWriter ();
+
+		BinaryPointWriter ( const BinaryPointWriter & ) = delete;
+		BinaryPointWriter &operator= ( const BinaryPointWriter & ) = delete;
+
+		unsigned int n_fields () const { return header.n_fields; }
+		std::uint64_t n_points () const { return header.n_points; }
+
+		// Append one point with the \a n_fields() values \a point_values
+		 void append ( const double *point_values );
+
+		/*
+		 * Append \a n_points points, where \a field_values[f] points to the contiguous values of the field f, e.g. the
+		 * components of the batch containers
+		 */
+		 void append ( const std::vector<const double*> &field_values, const unsigned int n_points );
+
+		// Write the partially filled block and the header
+		 void flush ();
+
+	private:
+		void write_block ();
+
+		std::string filename;
+		// Closes the file also if the constructor throws
+		 std::unique_ptr<std::FILE, decltype(&std::fclose)> file;
+		BinaryHeader header;
+
+		// The values of the current block (field-major) and the number of points in it
+		 std::vector<double> block;
+		 unsigned int n_points_in_block = 0;
+	};
+
+
+	inline BinaryPointWriter::BinaryPointWriter ( const std::string &filename, const unsigned int n_fields, const unsigned int block_size )
+	:
+	filename(filename),
+	file(nullptr, &std::fclose),
+	header(n_fields, block_size)
+	{
+		AssertThrow( block_size>0 && block_size%BinaryHeader::block_alignment==0,
+					 ExcMessage("PointIO: The block size must be a positive multiple of "+std::to_string(BinaryHeader::block_alignment)+".") );
+
+		file.reset( std::fopen( filename.c_str(), "r+b" ) );
+		if ( file!=nullptr )
+		{
+			// Continue the existing file
+			 AssertThrow( std::fread(&header, sizeof(BinaryHeader), 1, file.get())==1,
+						  ExcMessage("PointIO: Cannot read the header of '"+filename+"'.") );
+			 header.check(filename);
+			 AssertThrow( header.n_fields==n_fields,
+						  ExcMessage("PointIO: Cannot append "+std::to_string(n_fields)+" fields to '"+filename+"' with "
+									 +std::to_string(header.n_fields)+" fields.") );
+
+			block.resize( header.block_length() );
+			n_points_in_block = header.n_points % header.block_size;
+			if ( n_points_in_block>0 )
+			{
+				// Read back the last, partially filled block, which is overwritten by the next write
+				 std::fseek( file.get(), header.block_offset(header.n_points/header.block_size), SEEK_SET );
+				 AssertThrow( std::fread(block.data(), sizeof(double), block.size(), file.get())==block.size(),
+							  ExcMessage("PointIO: The binary point file '"+filename+"' is truncated.") );
+			}
+		}
+		else
+		{
+			file.reset( std::fopen( filename.c_str(), "w+b" ) );
+			AssertThrow( file!=nullptr, ExcMessage("PointIO: Cannot create the binary point file '"+filename+"'.") );
+			block.resize( header.block_length() );
+			flush();
+		}
+	}
+
+
+	inline BinaryPointWriter::~BinaryPointWriter ()
+	{
+		if ( file==nullptr )
+			return;
+
+		// No exceptions out of the destructor, the user calls flush() to see the errors
+		 try
+		 {
+			flush();
+		 }
+		 catch ( ... )
+		 {
+		 }
+	}
+
+
+	inline void BinaryPointWriter::append ( const double *point_values )
+	{
+		for ( unsigned int f=0; f<header.n_fields; ++f )
+			block[f*header.block_size + n_points_in_block] = point_values[f];
+		++n_points_in_block;
+		++header.n_points;
+
+		if ( n_points_in_block==header.block_size )
+			write_block();
+	}
+
+
+	inline void BinaryPointWriter::append ( const std::vector<const double*> &field_values, const unsigned int n_points )
+	{
+		AssertDimension( field_values.size(), header.n_fields );
+
+		unsigned int p = 0;
+		while ( p<n_points )
+		{
+			const unsigned int n_copy = std::min( n_points-p, header.block_size-n_points_in_block );
+			for ( unsigned int f=0; f<header.n_fields; ++f )
+				std::copy( field_values[f] + p, field_values[f] + p + n_copy, block.begin() + f*header.block_size + n_points_in_block );
+			p += n_copy;
+			n_points_in_block += n_copy;
+			header.n_points += n_copy;
+
+			if ( n_points_in_block==header.block_size )
+				write_block();
+		}
+	}
+
+
+	inline void BinaryPointWriter::write_block ()
+	{
+		// The block that contains the point n_points-1, i.e. the current (full or partial) block
+		 const std::uint64_t b = ( header.n_points - n_points_in_block ) / header.block_size;
+		std::fseek( file.get(), header.block_offset(b), SEEK_SET );
+		AssertThrow( std::fwrite(block.data(), sizeof(double), block.size(), file.get())==block.size(),
+					 ExcMessage("PointIO: Cannot write to the binary point file '"+filename+"'.") );
+
+		if ( n_points_in_block==header.block_size )
+		{
+			std::fill( block.begin(), block.end(), 0. );
+			n_points_in_block = 0;
+		}
+	}
+
+
+	inline void BinaryPointWriter::flush ()
+	{
+		if ( n_points_in_block>0 )
+			write_block();
+
+		std::fseek( file.get(), 0, SEEK_SET );
+		AssertThrow( std::fwrite(&header, sizeof(BinaryHeader), 1, file.get())==1 && std::fflush(file.get())==0,
+					 ExcMessage("PointIO: Cannot write the header of '"+filename+"'.") );
+	}
+
+
+	// Whether the \a filename denotes a binary point file (by the extension ".bin")
+	 inline bool is_binary_file ( const std::string &filename )
+	 {
+		const std::string extension = ".bin";
+		return filename.size()>extension.size()
+			   && filename.compare( filename.size()-extension.size(), extension.size(), extension )==0;
+	 }
+}
+
+#endif // point_binary_io_H
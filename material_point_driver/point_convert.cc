@@ -0,0 +1,121 @@
+/*
+ * Converter between text (CSV) and binary point files of the material point driver, e.g. to prepare large strain paths
+ * or to look at binary results for debugging
+ *
+ * Usage:
+ * @code
+ * 	point_convert [--block-size n] input.csv output.bin		// text to binary (appends, if output.bin exists)
+ * 	point_convert input.bin output.csv						// binary to text
+ * @endcode
+ * The text files contain one point per line with the values of all fields separated by commas or blanks, lines starting
+ * with '#' are comments. All lines need the same number of fields, which becomes the number of fields of the binary file.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/exceptions.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <cstdint>
+
+#include "point_binary_io.h"
+
+using namespace dealii;
+
+
+void text_to_binary ( const std::string &input, const std::string &output, const unsigned int block_size )
+{
+	std::ifstream file (input);
+	AssertThrow( file.good(), ExcMessage("point_convert: Cannot open '"+input+"'.") );
+
+	std::unique_ptr<PointIO::BinaryPointWriter> writer;
+	std::string line;
+	unsigned int line_nbr = 0;
+	std::vector<double> entries;
+	while ( std::getline(file, line) )
+	{
+		++line_nbr;
+		if ( line.empty() || line[0]=='#' )
+			continue;
+		std::replace( line.begin(), line.end(), ',', ' ' );
+
+		std::istringstream stream (line);
+		entries.clear();
+		double entry;
+		while ( stream >> entry )
+			entries.push_back(entry);
+		if ( entries.empty() )
+			continue;
+
+		// The first line with values defines the number of fields
+		 if ( !writer )
+			writer.reset( new PointIO::BinaryPointWriter(output, entries.size(), block_size) );
+		AssertThrow( entries.size()==writer->n_fields(),
+					 ExcMessage("point_convert: Line "+std::to_string(line_nbr)+" of '"+input+"' has "+std::to_string(entries.size())
+								+" instead of "+std::to_string(writer->n_fields())+" fields.") );
+		writer->append( entries.data() );
+	}
+	AssertThrow( writer, ExcMessage("point_convert: '"+input+"' does not contain any points.") );
+
+	writer->flush();
+	std::cout << "point_convert: " << input << " -> " << output << ", " << writer->n_points() << " points with "
+			  << writer->n_fields() << " fields" << std::endl;
+}
+
+
+void binary_to_text ( const std::string &input, const std::string &output )
+{
+	PointIO::BinaryPointFile file (input);
+
+	std::ofstream text (output);
+	AssertThrow( text.good(), ExcMessage("point_convert: Cannot write '"+output+"'.") );
+
+	text << "# " << file.n_points() << " points with " << file.n_fields() << " fields (block size " << file.block_size() << ")" << std::endl;
+	text << std::setprecision(17);
+	for ( std::uint64_t b=0; b<file.n_blocks(); ++b )
+		for ( unsigned int p=0; p<file.n_points_in_block(b); ++p )
+			for ( unsigned int f=0; f<file.n_fields(); ++f )
+				text << file.field(b,f)[p] << ( (f+1<file.n_fields()) ? "," : "\n" );
+
+	AssertThrow( text.good(), ExcMessage("point_convert: Cannot write '"+output+"'.") );
+	std::cout << "point_convert: " << input << " -> " << output << ", " << file.n_points() << " points with "
+			  << file.n_fields() << " fields" << std::endl;
+}
+
+
+int main ( int argc, char **argv )
+{
+	try
+	{
+		unsigned int block_size = 1024;
+		std::vector<std::string> files;
+		for ( int i=1; i<argc; ++i )
+		{
+			const std::string arg = argv[i];
+			if ( arg=="--block-size" && i+1<argc )
+				block_size = std::atoi(argv[++i]);
+			else
+				files.push_back(arg);
+		}
+		AssertThrow( files.size()==2, ExcMessage("point_convert: Give an input and an output file (see point_convert.cc).") );
+
+		if ( PointIO::is_binary_file(files[0]) )
+			binary_to_text( files[0], files[1] );
+		else
+			text_to_binary( files[0], files[1], block_size );
+	}
+	catch ( std::exception &exc )
+	{
+		std::cerr << exc.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
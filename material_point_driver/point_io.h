@@ -0,0 +1,215 @@
+#ifndef point_io_H
+#define point_io_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-qp_batch.h"
+#include "benchmark_models.h"
+#include "point_binary_io.h"
+
+using namespace dealii;
+
+/*
+ * Inputs and outputs of the material point driver, stored component-major in the batch containers of the wrapper
+ * (see Sacado-qp_batch.h), such that the threads write their points without any reordering.
+ *
+ * Strain path (binary): A binary point file (see point_binary_io.h) with the fields eps (6) and phi, which is evaluated block
+ * by block directly from the memory-mapped file.
+ *
+ * Strain path (text): One point per line with the six independent strain components in the dof order of the wrapper
+ * and optionally the scalar phi (default 0), separated by blanks or commas. Lines starting with '#' are comments.
+ * @code
+ * 	# eps_00 eps_01 eps_02 eps_11 eps_12 eps_22 phi
+ * 	1e-3 0 0 -3e-4 0 -3e-4 0.3
+ * @endcode
+ */
+namespace PointIO
+{
+	struct StrainPath
+	{
+		Sacado_Wrapper::SymTensorBatch<3> eps;
+		std::vector<double> phi;
+
+		unsigned int size () const { return phi.size(); }
+
+		void reinit ( const unsigned int n_points )
+		{
+			eps.reinit(n_points);
+			phi.resize(n_points);
+		}
+	};
+
+
+	struct PointResults
+	{
+		Sacado_Wrapper::SymTensorBatch<3> sigma;
+		Sacado_Wrapper::SymTangentBatch<3> C;
+		Sacado_Wrapper::SymTensorBatch<3> d_sigma_d_phi;
+
+		void reinit ( const unsigned int n_points )
+		{
+			sigma.reinit(n_points);
+			C.reinit(n_points);
+			d_sigma_d_phi.reinit(n_points);
+		}
+	};
+
+
+	inline StrainPath read_strain_path_text ( const std::string &filename )
+	{
+		std::ifstream file (filename);
+		AssertThrow( file.good(), ExcMessage("PointIO: Cannot open the strain path '"+filename+"'.") );
+
+		const unsigned int n_dofs = Sacado_Wrapper::SymTensorBatch<3>::n_dofs;
+
+		// Read point-major and reorder afterwards, because the number of points is not known in advance
+		 std::vector<double> values;
+		 std::vector<double> phi;
+		 std::string line;
+		 unsigned int line_nbr = 0;
+		 while ( std::getline(file, line) )
+		 {
+			++line_nbr;
+			if ( line.empty() || line[0]=='#' )
+				continue;
+			std::replace( line.begin(), line.end(), ',', ' ' );
+
+			std::istringstream stream (line);
+			std::vector<double> entries;
+			double entry;
+			while ( stream >> entry )
+				entries.push_back(entry);
+			if ( entries.empty() )
+				continue;
+
+			AssertThrow( entries.size()==n_dofs || entries.size()==n_dofs+1,
+						 ExcMessage("PointIO: Line "+std::to_string(line_nbr)+" of '"+filename+"' needs 6 strain components and optionally phi.") );
+			values.insert( values.end(), entries.begin(), entries.begin()+n_dofs );
+			phi.push_back( (entries.size()>n_dofs) ? entries[n_dofs] : 0. );
+		 }
+
+		StrainPath path;
+		path.reinit( phi.size() );
+		path.phi = phi;
+		for ( unsigned int x=0; x<n_dofs; ++x )
+		{
+			double *eps_x = path.eps.component(x);
+			for ( unsigned int p=0; p<path.size(); ++p )
+				eps_x[p] = values[p*n_dofs+x];
+		}
+		return path;
+	}
+
+
+	/*
+	 * A synthetic strain path of \a n_points points (the strains of the benchmarks and phi cycling in [0,1)), e.g. to measure
+	 * the throughput without an input file
+	 */
+	 inline StrainPath synthetic_strain_path ( const unsigned int n_points )
+	 {
+		StrainPath path;
+		path.reinit(n_points);
+		for ( unsigned int p=0; p<n_points; ++p )
+		{
+			path.eps.set( p, strain_at_qp<3>(p) );
+			path.phi[p] = 1e-3 * (p%1000);
+		}
+		return path;
+	 }
+
+
+	/*
+	 * Output of the results, either as text or appended to a binary point file (by the extension ".bin", see point_binary_io.h)
+	 *
+	 * Text: One line per point with the stress (6 components), the tangent (6x6, row-major as the SymmetricTensor<4,3>
+	 * components in the dof order) and the coupling d_sigma_d_phi (6 components).
+	 * Binary: The same 48 values per point as fields, see \a n_result_fields.
+	 *
+	 * The results are written batch by batch, so the driver does not need to keep the results of all points.
+	 */
+	class ResultsWriter
+	{
+	public:
+		static const unsigned int n_result_fields = 6 + 6*6 + 6;
+
+		// Write to \a filename ("none" to skip the output) and append to an existing binary file only if \a append
+		 ResultsWriter ( const std::string &filename, const bool append=false );
+
+		// Write the first \a n_points points of the \a results
+		 void write ( const PointResults &results, const unsigned int n_points );
+
+	private:
+		std::unique_ptr<BinaryPointWriter> binary;
+		std::ofstream text;
+	};
+
+
+	inline ResultsWriter::ResultsWriter ( const std::string &filename, const bool append )
+	{
+		if ( filename=="none" )
+			return;
+
+		if ( is_binary_file(filename) )
+		{
+			if ( !append )
+				std::remove( filename.c_str() );
+			binary.reset( new BinaryPointWriter(filename, n_result_fields) );
+		}
+		else
+		{
+			text.open( filename, append ? std::ios::app : std::ios::trunc );
+			AssertThrow( text.good(), ExcMessage("PointIO: Cannot write the results to '"+filename+"'.") );
+			if ( !append )
+				text << "# sigma[6] C[6x6] d_sigma_d_phi[6]" << std::endl;
+			text << std::setprecision(12);
+		}
+	}
+
+
+	inline void ResultsWriter::write ( const PointResults &results, const unsigned int n_points )
+	{
+		const unsigned int n_dofs = Sacado_Wrapper::SymTensorBatch<3>::n_dofs;
+
+		if ( binary )
+		{
+			std::vector<const double*> fields;
+			fields.reserve(n_result_fields);
+			for ( unsigned int y=0; y<n_dofs; ++y )
+				fields.push_back( results.sigma.component(y) );
+			for ( unsigned int y=0; y<n_dofs; ++y )
+				for ( unsigned int x=0; x<n_dofs; ++x )
+					fields.push_back( results.C.component(y,x) );
+			for ( unsigned int y=0; y<n_dofs; ++y )
+				fields.push_back( results.d_sigma_d_phi.component(y) );
+
+			binary->append( fields, n_points );
+		}
+		else if ( text.is_open() )
+		{
+			for ( unsigned int p=0; p<n_points; ++p )
+			{
+				for ( unsigned int y=0; y<n_dofs; ++y )
+					text << results.sigma.component(y)[p] << " ";
+				for ( unsigned int y=0; y<n_dofs; ++y )
+					for ( unsigned int x=0; x<n_dofs; ++x )
+						text << results.C.component(y,x)[p] << " ";
+				for ( unsigned int y=0; y<n_dofs; ++y )
+					text << results.d_sigma_d_phi.component(y)[p] << ( (y+1<n_dofs) ? " " : "\n" );
+			}
+			AssertThrow( text.good(), ExcMessage("PointIO: Cannot write the results.") );
+		}
+	}
+}
+
+#endif // point_io_H
@@ -0,0 +1,137 @@
+#ifndef point_models_H
+#define point_models_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <string>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+/*
+ * Material models for the material point driver, each evaluating the model equations from the examples through the
+ * wrapper with statically sized Sacado data types. Every model provides
+ * - \a Scratch: the wrapper variables, created once per thread and reseeded for every point
+ * - \a evaluate: the stress \a sigma, the tangent \a C = d_sigma/d_eps and the coupling \a d_sigma_d_phi at the strain
+ *   \a eps_d and the scalar \a phi_d
+ * The driver is templated on the model, so further models only need to provide the same interface.
+ */
+namespace PointModels
+{
+	// The values of the components of a first-order tensor \a argument
+	 template<typename Number>
+	 SymmetricTensor<2,3> values ( const SymmetricTensor<2,3,Number> &argument )
+	 {
+		SymmetricTensor<2,3> tmp;
+		for ( unsigned int i=0; i<3; ++i )
+			for ( unsigned int j=i; j<3; ++j )
+				tmp[i][j] = argument[i][j].val();
+		return tmp;
+	 }
+
+
+	/*
+	 * Linear elasticity from \ref Ex10 "example 10" (\a phi is not used, the coupling is zero)
+	 */
+	struct Elastic
+	{
+		static std::string name () { return "elastic"; }
+
+		static const unsigned int N = Sacado_Wrapper::n_total_dofs<3>::value;
+
+		struct Scratch
+		{
+			Sacado_Wrapper::SymTensor_SFad<3,N> eps;
+		};
+
+		double kappa = 5;
+		double mu = 2;
+
+		void evaluate ( const SymmetricTensor<2,3> &eps_d, const double /*phi_d*/, Scratch &scratch,
+						SymmetricTensor<2,3> &sigma_d, SymmetricTensor<4,3> &C, SymmetricTensor<2,3> &d_sigma_d_phi ) const
+		{
+			scratch.eps.reseed(eps_d);
+
+			const SymmetricTensor<2,3,Sacado::Fad::SFad<double,N> > sigma = stress_strain_relation( scratch.eps, kappa, mu );
+
+			scratch.eps.get_tangent(C, sigma);
+			sigma_d = values(sigma);
+			d_sigma_d_phi = SymmetricTensor<2,3>();
+		}
+	};
+
+
+	/*
+	 * Stress with the strain and the damage variable from \ref Ex4 "example 4" (see \a stress_eps_phi)
+	 */
+	struct EpsPhi
+	{
+		static std::string name () { return "eps_phi"; }
+
+		static const unsigned int N = Sacado_Wrapper::n_total_dofs<3,1>::value;
+
+		struct Scratch
+		{
+			Sacado_Wrapper::SymTensor_SFad<3,N> eps;
+			Sacado_Wrapper::SW_double_SFad<3,N> phi;
+			Sacado_Wrapper::DoFs_summary_SFad<3,N> DoFs_summary;
+		};
+
+		void evaluate ( const SymmetricTensor<2,3> &eps_d, const double phi_d, Scratch &scratch,
+						SymmetricTensor<2,3> &sigma_d, SymmetricTensor<4,3> &C, SymmetricTensor<2,3> &d_sigma_d_phi ) const
+		{
+			typedef Sacado::Fad::SFad<double,N> Number;
+
+			scratch.DoFs_summary.reseed(scratch.eps, eps_d, scratch.phi, phi_d);
+
+			const SymmetricTensor<2,3,Number> sigma = stress_eps_phi<3,Number>( scratch.eps, scratch.phi );
+
+			scratch.eps.get_tangent(C, sigma);
+			scratch.phi.get_tangent(d_sigma_d_phi, sigma);
+			sigma_d = values(sigma);
+		}
+	};
+
+
+	/*
+	 * Stress and tangent as first and second derivatives of the energy from \ref Ex8 "example 8" (see \a energy_eps_phi),
+	 * where the coupling is the mixed derivative d2_psi/d_eps_d_phi
+	 */
+	struct Energy
+	{
+		static std::string name () { return "energy"; }
+
+		static const unsigned int N = Sacado_Wrapper::n_total_dofs<3,1>::value;
+
+		struct Scratch
+		{
+			Sacado_Wrapper::SymTensor2_SFad<3,N> eps;
+			Sacado_Wrapper::SW_double2_SFad<3,N> phi;
+			Sacado_Wrapper::DoFs_summary_SFad<3,N> DoFs_summary;
+		};
+
+		double lambda = 1;
+		double mu = 2;
+
+		void evaluate ( const SymmetricTensor<2,3> &eps_d, const double phi_d, Scratch &scratch,
+						SymmetricTensor<2,3> &sigma_d, SymmetricTensor<4,3> &C, SymmetricTensor<2,3> &d_sigma_d_phi ) const
+		{
+			typedef Sacado::Fad::SFad< Sacado::Fad::SFad<double,N>, N > Number2;
+
+			scratch.DoFs_summary.reseed(scratch.eps, eps_d, scratch.phi, phi_d);
+
+			const Number2 energy = energy_eps_phi<3,Number2>( scratch.eps, scratch.phi, lambda, mu );
+
+			scratch.eps.get_tangent(sigma_d, energy);
+			scratch.eps.get_curvature(C, energy);
+			scratch.DoFs_summary.get_curvature(d_sigma_d_phi, energy, scratch.eps, scratch.phi);
+		}
+	};
+}
+
+#endif // point_models_H
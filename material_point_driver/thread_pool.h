@@ -0,0 +1,168 @@
+#ifndef thread_pool_H
+#define thread_pool_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <algorithm>
+
+/*
+ * Persistent pool of worker threads for the evaluation of large numbers of material points.
+ *
+ * The threads are started once in the constructor and wait for work, so repeated calls of \a parallel_for (e.g. one per
+ * load step of the strain path) do not pay for the creation of threads. The range [begin,end) is cut into chunks of
+ * \a chunk_size points, which the workers and the calling thread grab one after another via an atomic counter. The body
+ * gets the range of the chunk and the id of the thread (0 ... n_threads()-1), e.g. to pick its per-thread wrapper variables:
+ * @code
+ * 	ThreadPool pool (n_threads);
+ * 	std::vector<Scratch> scratch (pool.n_threads());
+ * 	pool.parallel_for( 0, n_points, 1000, [&] (const unsigned int begin, const unsigned int end, const unsigned int thread)
+ * 	{
+ * 		for ( unsigned int p=begin; p<end; ++p )
+ * 			evaluate( p, scratch[thread] );
+ * 	});
+ * @endcode
+ * An exception thrown by the body stops the handing out of further chunks and is rethrown by \a parallel_for once all
+ * threads finished their current chunks (the first one, if several threads throw).
+ */
+class ThreadPool
+{
+public:
+	typedef std::function<void(const unsigned int, const unsigned int, const unsigned int)> Body;
+
+	// Start \a n_threads-1 workers (the calling thread takes part in the work as thread 0)
+	 ThreadPool ( const unsigned int n_threads=std::thread::hardware_concurrency() );
+
+	~ThreadPool ();
+
+	ThreadPool ( const ThreadPool & ) = delete;
+	ThreadPool &operator= ( const ThreadPool & ) = delete;
+
+	unsigned int n_threads () const { return workers.size()+1; }
+
+	// Evaluate \a body for all chunks of [begin,end) and return once all of them are done (or rethrow the exception of a chunk)
+	 void parallel_for ( const unsigned int begin, const unsigned int end, const unsigned int chunk_size, const Body &body );
+
+private:
+	void worker_loop ( const unsigned int thread );
+
+	// Grab and evaluate chunks of the current job until none are left, where an exception is stored in \a exception
+	 void work_on_chunks ( const unsigned int thread );
+
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable job_available;
+	std::condition_variable job_done;
+
+	// The current job, guarded by \a mutex (\a generation counts the jobs, such that a worker takes part only once per job)
+	 const Body *body = nullptr;
+	 unsigned int job_end = 0;
+	 unsigned int job_chunk_size = 1;
+	 unsigned long generation = 0;
+	 unsigned int n_busy = 0;
+	 bool stop = false;
+	 std::exception_ptr exception;
+
+	std::atomic<unsigned int> next_begin;
+};
+
+
+inline ThreadPool::ThreadPool ( const unsigned int n_threads )
+:
+next_begin(0)
+{
+	for ( unsigned int thread=1; thread<std::max(n_threads,1u); ++thread )
+		workers.emplace_back( &ThreadPool::worker_loop, this, thread );
+}
+
+
+inline ThreadPool::~ThreadPool ()
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		stop = true;
+	}
+	job_available.notify_all();
+	for ( std::thread &worker : workers )
+		worker.join();
+}
+
+
+inline void ThreadPool::parallel_for ( const unsigned int begin, const unsigned int end, const unsigned int chunk_size, const Body &body_in )
+{
+	if ( begin>=end )
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		body = &body_in;
+		job_end = end;
+		job_chunk_size = std::max(chunk_size,1u);
+		next_begin = begin;
+		n_busy = workers.size();
+		exception = nullptr;
+		++generation;
+	}
+	job_available.notify_all();
+
+	work_on_chunks(0);
+
+	// Wait for the workers to finish their last chunks
+	 std::unique_lock<std::mutex> lock (mutex);
+	 job_done.wait( lock, [this] () { return n_busy==0; } );
+	 body = nullptr;
+
+	if ( exception )
+		std::rethrow_exception( exception );
+}
+
+
+inline void ThreadPool::work_on_chunks ( const unsigned int thread )
+{
+	try
+	{
+		for ( unsigned int chunk_begin = next_begin.fetch_add(job_chunk_size); chunk_begin<job_end;
+			  chunk_begin = next_begin.fetch_add(job_chunk_size) )
+			(*body)( chunk_begin, std::min(chunk_begin+job_chunk_size, job_end), thread );
+	}
+	catch ( ... )
+	{
+		// Keep the first exception and let the other threads stop after their current chunks
+		 std::lock_guard<std::mutex> lock (mutex);
+		 if ( !exception )
+			exception = std::current_exception();
+		 next_begin = job_end;
+	}
+}
+
+
+inline void ThreadPool::worker_loop ( const unsigned int thread )
+{
+	unsigned long last_generation = 0;
+
+	while ( true )
+	{
+		{
+			std::unique_lock<std::mutex> lock (mutex);
+			job_available.wait( lock, [&] () { return stop || generation!=last_generation; } );
+			if ( stop )
+				return;
+			last_generation = generation;
+		}
+
+		work_on_chunks(thread);
+
+		{
+			std::lock_guard<std::mutex> lock (mutex);
+			--n_busy;
+		}
+		job_done.notify_one();
+	}
+}
+
+#endif // thread_pool_H
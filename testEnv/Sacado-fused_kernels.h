@@ -0,0 +1,254 @@
+#ifndef Sacado_fused_kernels_H
+#define Sacado_fused_kernels_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <cmath>
+#include <algorithm>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-mixed_tensor_ops.h"
+
+/*
+ * Fused tensor kernels for SymmetricTensors of Sacado data types
+ *
+ * The generic deal.II functions treat the Sacado data type as a black box: e.g. \a stress_strain_relation calls
+ * trace(eps) and deviator(eps) inside the (i,j)-loop, so the whole deviator including all derivatives is computed 9 times,
+ * and every operation creates a temporary tensor of Sacado numbers (each with its own derivative array for DFad).
+ * The kernels below instead work directly on the values and the derivative arrays of the independent components: each
+ * result is created once with its final number of derivatives and filled in a single pass over the derivatives, e.g.
+ * @code
+ * 	const Number tr = Sacado_Wrapper::fused::trace(eps);
+ * 	SymmetricTensor<2,dim,Number> sigma = Sacado_Wrapper::fused::deviator(eps);
+ * 	sigma *= 2.*mu;
+ * 	for ( unsigned int i=0; i<dim; ++i )
+ * 		sigma[i][i] += kappa * tr;
+ * @endcode
+ * The kernels work for first-order data types (value_type double) as well as for nested ones (e.g. SFad<SFad<double,N>,N>
+ * of the SymTensor2), where the derivatives are themselves Sacado numbers. Components without derivatives (size 0, e.g. a
+ * constant DFad) are treated as constants.
+ * @note Call the kernels qualified (Sacado_Wrapper::fused::...), their names equal those of the deal.II functions.
+ */
+namespace Sacado_Wrapper
+{
+	namespace fused
+	{
+		namespace internal
+		{
+			/*
+			 * Pointers to the values and the derivative arrays of the independent components of the tensor \a A
+			 */
+			template<int dim, typename Number>
+			struct Components
+			{
+				typedef typename Number::value_type value_type;
+				static const unsigned int n_dofs = SymmetricTensor<2,dim>::n_independent_components;
+
+				explicit Components ( const SymmetricTensor<2,dim,Number> &A )
+				:
+				n_derivs(0)
+				{
+					for ( unsigned int x=0; x<n_dofs; ++x )
+					{
+						const Number &A_x = A[index_i<dim>(x)][index_j<dim>(x)];
+						val[x] = &A_x.val();
+						dx[x] = ( A_x.size()>0 ) ? &A_x.fastAccessDx(0) : nullptr;
+						n_derivs = std::max<unsigned int>( n_derivs, A_x.size() );
+					}
+				}
+
+				const value_type *val[n_dofs];
+				const value_type *dx[n_dofs];	// nullptr for components without derivatives
+				unsigned int n_derivs;
+			};
+
+			// A Sacado number with the value \a value and \a n_derivs zero derivatives
+			 template<typename Number>
+			 Number create ( const unsigned int n_derivs, const typename Number::value_type &value )
+			 {
+				return ( n_derivs>0 ) ? Number( n_derivs, value ) : Number( value );
+			 }
+		}
+
+
+		/*
+		 * Trace of \a A
+		 */
+		template<int dim, typename Number>
+		Number trace ( const SymmetricTensor<2,dim,Number> &A )
+		{
+			const internal::Components<dim,Number> A_c (A);
+
+			Number tmp = internal::create<Number>( A_c.n_derivs, 0. );
+			for ( unsigned int i=0; i<dim; ++i )
+			{
+				const unsigned int x = dof_index<dim>(i,i);
+				tmp.val() += *A_c.val[x];
+				if ( A_c.dx[x]!=nullptr )
+					for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+						tmp.fastAccessDx(k) += A_c.dx[x][k];
+			}
+			return tmp;
+		}
+
+
+		/*
+		 * Deviator of \a A, where the trace (value and derivatives) is computed only once
+		 */
+		template<int dim, typename Number>
+		SymmetricTensor<2,dim,Number> deviator ( const SymmetricTensor<2,dim,Number> &A )
+		{
+			const internal::Components<dim,Number> A_c (A);
+			const Number tr_dim = fused::trace(A) / double(dim);
+
+			SymmetricTensor<2,dim,Number> tmp;
+			for ( unsigned int x=0; x<internal::Components<dim,Number>::n_dofs; ++x )
+			{
+				const bool diagonal = ( index_i<dim>(x)==index_j<dim>(x) );
+				Number &tmp_x = tmp[index_i<dim>(x)][index_j<dim>(x)];
+				tmp_x = internal::create<Number>( A_c.n_derivs, *A_c.val[x] );
+				if ( diagonal )
+					tmp_x.val() -= tr_dim.val();
+
+				for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+				{
+					if ( A_c.dx[x]!=nullptr )
+						tmp_x.fastAccessDx(k) += A_c.dx[x][k];
+					if ( diagonal )
+						tmp_x.fastAccessDx(k) -= tr_dim.fastAccessDx(k);
+				}
+			}
+			return tmp;
+		}
+
+
+		/*
+		 * Frobenius norm of \a A (the derivatives are set to zero for \a A = 0, where the norm is not differentiable)
+		 */
+		template<int dim, typename Number>
+		Number norm ( const SymmetricTensor<2,dim,Number> &A )
+		{
+			typedef typename Number::value_type value_type;
+			using std::sqrt;
+
+			const internal::Components<dim,Number> A_c (A);
+
+			value_type norm_squared = 0.;
+			for ( unsigned int x=0; x<internal::Components<dim,Number>::n_dofs; ++x )
+				norm_squared += Sacado_Wrapper::internal::contraction_weight<dim>(x) * (*A_c.val[x]) * (*A_c.val[x]);
+
+			Number tmp = internal::create<Number>( A_c.n_derivs, sqrt(norm_squared) );
+			if ( tmp.val()==0. )
+				return tmp;
+
+			// d|A|/dA_x = w_x A_x / |A|
+			 for ( unsigned int x=0; x<internal::Components<dim,Number>::n_dofs; ++x )
+			 {
+				if ( A_c.dx[x]==nullptr )
+					continue;
+				const value_type factor = Sacado_Wrapper::internal::contraction_weight<dim>(x) * (*A_c.val[x]) / tmp.val();
+				for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+					tmp.fastAccessDx(k) += factor * A_c.dx[x][k];
+			 }
+			return tmp;
+		}
+
+
+		/*
+		 * Square \a A.A (= A_im * A_mj, symmetric for symmetric \a A), e.g. eps.eps in the energy of example 7
+		 */
+		template<int dim, typename Number>
+		SymmetricTensor<2,dim,Number> square ( const SymmetricTensor<2,dim,Number> &A )
+		{
+			typedef typename Number::value_type value_type;
+			const internal::Components<dim,Number> A_c (A);
+
+			SymmetricTensor<2,dim,Number> tmp;
+			for ( unsigned int y=0; y<internal::Components<dim,Number>::n_dofs; ++y )
+			{
+				const unsigned int i = index_i<dim>(y), j = index_j<dim>(y);
+
+				value_type value = 0.;
+				for ( unsigned int m=0; m<dim; ++m )
+					value += (*A_c.val[dof_index<dim>(i,m)]) * (*A_c.val[dof_index<dim>(m,j)]);
+
+				Number &tmp_y = tmp[i][j];
+				tmp_y = internal::create<Number>( A_c.n_derivs, value );
+
+				// Product rule: d(A_im A_mj) = dA_im A_mj + A_im dA_mj
+				 for ( unsigned int m=0; m<dim; ++m )
+				 {
+					const unsigned int im = dof_index<dim>(i,m), mj = dof_index<dim>(m,j);
+					if ( A_c.dx[im]!=nullptr )
+						for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+							tmp_y.fastAccessDx(k) += A_c.dx[im][k] * (*A_c.val[mj]);
+					if ( A_c.dx[mj]!=nullptr )
+						for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+							tmp_y.fastAccessDx(k) += (*A_c.val[im]) * A_c.dx[mj][k];
+				 }
+			}
+			return tmp;
+		}
+
+
+		/*
+		 * Outer product \a A x \a B = A_ij * B_kl of two Sacado tensors (e.g. the dyadic products in hyperelastic tangents)
+		 */
+		template<int dim, typename Number>
+		SymmetricTensor<4,dim,Number> outer_product ( const SymmetricTensor<2,dim,Number> &A, const SymmetricTensor<2,dim,Number> &B )
+		{
+			const unsigned int n_dofs = internal::Components<dim,Number>::n_dofs;
+			const internal::Components<dim,Number> A_c (A), B_c (B);
+			const unsigned int n_derivs = std::max( A_c.n_derivs, B_c.n_derivs );
+
+			SymmetricTensor<4,dim,Number> tmp;
+			for ( unsigned int y=0; y<n_dofs; ++y )
+				for ( unsigned int x=0; x<n_dofs; ++x )
+				{
+					Number &tmp_yx = tmp[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)];
+					tmp_yx = internal::create<Number>( n_derivs, (*A_c.val[y]) * (*B_c.val[x]) );
+
+					// Product rule: d(A_y B_x) = dA_y B_x + A_y dB_x
+					 if ( A_c.dx[y]!=nullptr )
+						for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+							tmp_yx.fastAccessDx(k) += A_c.dx[y][k] * (*B_c.val[x]);
+					 if ( B_c.dx[x]!=nullptr )
+						for ( unsigned int k=0; k<B_c.n_derivs; ++k )
+							tmp_yx.fastAccessDx(k) += (*A_c.val[y]) * B_c.dx[x][k];
+				}
+			return tmp;
+		}
+
+
+		/*
+		 * Double contraction \a C : \a A = C_ijkl * A_kl with a constant fourth-order tensor \a C (zero entries are skipped)
+		 */
+		template<int dim, typename Number>
+		SymmetricTensor<2,dim,Number> double_contract ( const SymmetricTensor<4,dim> &C, const SymmetricTensor<2,dim,Number> &A )
+		{
+			const unsigned int n_dofs = internal::Components<dim,Number>::n_dofs;
+			const internal::Components<dim,Number> A_c (A);
+
+			SymmetricTensor<2,dim,Number> tmp;
+			for ( unsigned int y=0; y<n_dofs; ++y )
+			{
+				Number &tmp_y = tmp[index_i<dim>(y)][index_j<dim>(y)];
+				tmp_y = internal::create<Number>( A_c.n_derivs, 0. );
+
+				for ( unsigned int x=0; x<n_dofs; ++x )
+				{
+					const double C_yx = Sacado_Wrapper::internal::contraction_weight<dim>(x) * C[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)];
+					if ( C_yx==0. )
+						continue;
+					tmp_y.val() += C_yx * (*A_c.val[x]);
+					if ( A_c.dx[x]!=nullptr )
+						for ( unsigned int k=0; k<A_c.n_derivs; ++k )
+							tmp_y.fastAccessDx(k) += C_yx * A_c.dx[x][k];
+				}
+			}
+			return tmp;
+		}
+	}
+}
+
+#endif // Sacado_fused_kernels_H
@@ -0,0 +1,473 @@
+#ifndef Sacado_hyper_dual_H
+#define Sacado_hyper_dual_H
+
+// The elementary functions must be declared in std before the deal.II templates (see Sacado-number_type_traits.h)
+#include "Sacado-number_type_traits.h"
+SACADO_WRAPPER_STD_FUNCTIONS(HyperDual)
+
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <iostream>
+#include <cmath>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * A second-order forward AD number type that only propagates the upper triangle of the Hessian.
+ *
+ * The nested Sacado::Fad::DFad<Sacado::Fad::DFad<double>> computes the full n x n matrix of second derivatives
+ * d2f/dx_i dx_j, although this matrix is symmetric for every scalar function f. For the energy-based tangents
+ * of \ref Ex7 "example 7" and \ref Ex8 "example 8" this means that half of the second derivatives are computed twice.
+ * The HyperDual<N> stores the value, the N first derivatives and the N*(N+1)/2 second derivatives with i<=j
+ * in fixed-size arrays (no heap allocations) and evaluates the product and chain rules only for the upper triangle.
+ *
+ * The interface is close to Sacado's Fad types: \a val(), \a dx(i), \a diff(i) and additionally \a dx2(i,j)
+ * for the second derivative, which may be called with i>j as well.
+ * Together with the elementary functions and the deal.II traits below, HyperDual<N> is a drop-in replacement for the
+ * nested Sacado data type in SymTensor2, SW_double2 and DoFs_summary (see the aliases SymTensor2_HyperDual, ... at the end):
+ * @code
+ * 	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+ * 	Sacado_Wrapper::SymTensor2_HyperDual<dim,N> eps;
+ * 	Sacado_Wrapper::SW_double2_HyperDual<dim,N> phi;
+ * 	Sacado_Wrapper::DoFs_summary_HyperDual<dim,N> DoFs_summary;
+ * 	Sacado_Wrapper::HyperDual<N> energy = ...;
+ * 	eps.get_curvature(C, energy);
+ * @endcode
+ * For N=7 these are 36 instead of 64 doubles (DFad<DFad> additionally allocates 8 derivative arrays on the heap).
+ * @note The number of independent variables N must be known at compile time, e.g. Sacado_Wrapper::n_total_dofs<dim,1>::value.
+ * @note Include this header before the deal.II headers, otherwise deal.II's std::sqrt (e.g. in the norm) does not find
+ * the overload for HyperDual<N> (see Sacado-number_type_traits.h).
+ */
+namespace Sacado_Wrapper
+{
+	template<unsigned int N>
+	class HyperDual
+	{
+	  public:
+		typedef double value_type;
+
+		// Number of the independent variables and of the stored second derivatives (upper triangle)
+		 static const unsigned int n_dofs = N;
+		 static const unsigned int n_hessian = N*(N+1)/2;
+
+		HyperDual ( const double value=0. );
+
+		// Constructor similar to Sacado's Fad(n,i,x): the value \a x is the i-th of the N independent variables
+		 HyperDual ( const unsigned int n, const unsigned int i, const double x );
+
+		// Declare this number as the i-th independent variable (the derivatives are reset)
+		 void diff ( const unsigned int i, const unsigned int n=N );
+
+		const double &val () const { return v; }
+		double &val () { return v; }
+
+		// First derivative df/dx_i
+		 const double &dx ( const unsigned int i ) const { return g[i]; }
+		 double &dx ( const unsigned int i ) { return g[i]; }
+		 const double &fastAccessDx ( const unsigned int i ) const { return g[i]; }
+
+		// Second derivative d2f/dx_i dx_j, only the upper triangle is stored, hence (i,j) and (j,i) share one entry
+		 const double &dx2 ( const unsigned int i, const unsigned int j ) const { return h[hessian_index(i,j)]; }
+		 double &dx2 ( const unsigned int i, const unsigned int j ) { return h[hessian_index(i,j)]; }
+
+		// Row-wise index of the entry (i,j) in the packed upper triangle
+		 static constexpr unsigned int hessian_index ( const unsigned int i, const unsigned int j )
+		 {
+			return ( i<=j ) ? ( i*N - (i*(i-1))/2 + (j-i) ) : hessian_index(j,i);
+		 }
+
+		/*
+		 * Chain rule for an elementary function f of this number: returns f(this) given the
+		 * value f0=f(v), the first derivative f1=f'(v) and the second derivative f2=f''(v):
+		 * \f[ \frac{d^2 f}{dx_i dx_j} = f' \cdot h_{ij} + f'' \cdot g_i \cdot g_j \f]
+		 */
+		 HyperDual<N> chain ( const double f0, const double f1, const double f2 ) const;
+
+		HyperDual<N> &operator+= ( const HyperDual<N> &b );
+		HyperDual<N> &operator-= ( const HyperDual<N> &b );
+		HyperDual<N> &operator*= ( const HyperDual<N> &b );
+		HyperDual<N> &operator/= ( const HyperDual<N> &b );
+		HyperDual<N> &operator+= ( const double b ) { v += b; return *this; }
+		HyperDual<N> &operator-= ( const double b ) { v -= b; return *this; }
+		HyperDual<N> &operator*= ( const double b );
+		HyperDual<N> &operator/= ( const double b ) { return (*this) *= (1./b); }
+
+	  private:
+		double v;
+		double g[N];
+		double h[n_hessian];
+	};
+
+
+	template<unsigned int N>
+	HyperDual<N>::HyperDual ( const double value )
+	:
+	v(value)
+	{
+		for ( unsigned int i=0; i<N; ++i )
+			g[i] = 0.;
+		for ( unsigned int ij=0; ij<n_hessian; ++ij )
+			h[ij] = 0.;
+	}
+
+
+	template<unsigned int N>
+	HyperDual<N>::HyperDual ( const unsigned int n, const unsigned int i, const double x )
+	:
+	HyperDual(x)
+	{
+		diff(i,n);
+	}
+
+
+	template<unsigned int N>
+	void HyperDual<N>::diff ( const unsigned int i, const unsigned int n )
+	{
+		(void)n;
+		for ( unsigned int k=0; k<N; ++k )
+			g[k] = 0.;
+		for ( unsigned int ij=0; ij<n_hessian; ++ij )
+			h[ij] = 0.;
+		g[i] = 1.;
+	}
+
+
+	template<unsigned int N>
+	HyperDual<N> HyperDual<N>::chain ( const double f0, const double f1, const double f2 ) const
+	{
+		HyperDual<N> result;
+		result.v = f0;
+		for ( unsigned int i=0; i<N; ++i )
+			result.g[i] = f1 * g[i];
+
+		unsigned int ij=0;
+		for ( unsigned int i=0; i<N; ++i )
+		{
+			const double f2_gi = f2 * g[i];
+			for ( unsigned int j=i; j<N; ++j, ++ij )
+				result.h[ij] = f1 * h[ij] + f2_gi * g[j];
+		}
+		return result;
+	}
+
+
+	template<unsigned int N>
+	HyperDual<N> &HyperDual<N>::operator+= ( const HyperDual<N> &b )
+	{
+		v += b.v;
+		for ( unsigned int i=0; i<N; ++i )
+			g[i] += b.g[i];
+		for ( unsigned int ij=0; ij<n_hessian; ++ij )
+			h[ij] += b.h[ij];
+		return *this;
+	}
+
+
+	template<unsigned int N>
+	HyperDual<N> &HyperDual<N>::operator-= ( const HyperDual<N> &b )
+	{
+		v -= b.v;
+		for ( unsigned int i=0; i<N; ++i )
+			g[i] -= b.g[i];
+		for ( unsigned int ij=0; ij<n_hessian; ++ij )
+			h[ij] -= b.h[ij];
+		return *this;
+	}
+
+
+	/*
+	 * Product rule, where the mixed first-order terms make up for the missing lower triangle:
+	 * \f[ h_{ij} = h^a_{ij} \cdot b + a \cdot h^b_{ij} + g^a_i \cdot g^b_j + g^a_j \cdot g^b_i \f]
+	 */
+	template<unsigned int N>
+	HyperDual<N> &HyperDual<N>::operator*= ( const HyperDual<N> &b )
+	{
+		// The Hessian needs the old gradient and value of this number, so it is updated first
+		 unsigned int ij=0;
+		 for ( unsigned int i=0; i<N; ++i )
+			for ( unsigned int j=i; j<N; ++j, ++ij )
+				h[ij] = h[ij] * b.v + v * b.h[ij] + g[i] * b.g[j] + g[j] * b.g[i];
+
+		for ( unsigned int i=0; i<N; ++i )
+			g[i] = g[i] * b.v + v * b.g[i];
+
+		v *= b.v;
+		return *this;
+	}
+
+
+	template<unsigned int N>
+	HyperDual<N> &HyperDual<N>::operator/= ( const HyperDual<N> &b )
+	{
+		// a/b = a * (1/b) with the chain rule for the reciprocal
+		 const double inv_b = 1./b.v;
+		 return (*this) *= b.chain( inv_b, -inv_b*inv_b, 2.*inv_b*inv_b*inv_b );
+	}
+
+
+	template<unsigned int N>
+	HyperDual<N> &HyperDual<N>::operator*= ( const double b )
+	{
+		v *= b;
+		for ( unsigned int i=0; i<N; ++i )
+			g[i] *= b;
+		for ( unsigned int ij=0; ij<n_hessian; ++ij )
+			h[ij] *= b;
+		return *this;
+	}
+
+
+	// Arithmetic operators for all combinations of HyperDual and double
+	 template<unsigned int N>
+	 inline HyperDual<N> operator- ( const HyperDual<N> &a ) { HyperDual<N> r(a); return r *= -1.; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator+ ( const HyperDual<N> &a ) { return a; }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> operator+ ( HyperDual<N> a, const HyperDual<N> &b ) { return a += b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator+ ( HyperDual<N> a, const double b ) { return a += b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator+ ( const double a, HyperDual<N> b ) { return b += a; }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> operator- ( HyperDual<N> a, const HyperDual<N> &b ) { return a -= b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator- ( HyperDual<N> a, const double b ) { return a -= b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator- ( const double a, const HyperDual<N> &b ) { HyperDual<N> r(-b); return r += a; }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> operator* ( HyperDual<N> a, const HyperDual<N> &b ) { return a *= b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator* ( HyperDual<N> a, const double b ) { return a *= b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator* ( const double a, HyperDual<N> b ) { return b *= a; }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> operator/ ( HyperDual<N> a, const HyperDual<N> &b ) { return a /= b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator/ ( HyperDual<N> a, const double b ) { return a /= b; }
+	 template<unsigned int N>
+	 inline HyperDual<N> operator/ ( const double a, const HyperDual<N> &b ) { const double inv_b = 1./b.val(); return b.chain( a*inv_b, -a*inv_b*inv_b, 2.*a*inv_b*inv_b*inv_b ); }
+
+
+	// Comparisons (of the values, as for the Sacado data types)
+	 #define HYPER_DUAL_COMPARISON(OP) \
+	 template<unsigned int N> \
+	 inline bool operator OP ( const HyperDual<N> &a, const HyperDual<N> &b ) { return a.val() OP b.val(); } \
+	 template<unsigned int N> \
+	 inline bool operator OP ( const HyperDual<N> &a, const double b ) { return a.val() OP b; } \
+	 template<unsigned int N> \
+	 inline bool operator OP ( const double a, const HyperDual<N> &b ) { return a OP b.val(); }
+
+	 HYPER_DUAL_COMPARISON(==)
+	 HYPER_DUAL_COMPARISON(!=)
+	 HYPER_DUAL_COMPARISON(<)
+	 HYPER_DUAL_COMPARISON(>)
+	 HYPER_DUAL_COMPARISON(<=)
+	 HYPER_DUAL_COMPARISON(>=)
+	 #undef HYPER_DUAL_COMPARISON
+
+
+	/*
+	 * Elementary functions via HyperDual::chain with the first and second derivative of the function.
+	 * They are found via argument-dependent lookup and, because they are also declared in std at the top of this header,
+	 * by the qualified calls in deal.II (e.g. std::sqrt in SymmetricTensor::norm).
+	 */
+	 template<unsigned int N>
+	 inline HyperDual<N> sqrt ( const HyperDual<N> &a )
+	 {
+		const double f0 = std::sqrt(a.val());
+		return a.chain( f0, 0.5/f0, -0.25/(f0*a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> cbrt ( const HyperDual<N> &a )
+	 {
+		const double f0 = std::cbrt(a.val());
+		const double f1 = f0/(3.*a.val());
+		return a.chain( f0, f1, -2.*f1/(3.*a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> exp ( const HyperDual<N> &a )
+	 {
+		const double f0 = std::exp(a.val());
+		return a.chain( f0, f0, f0 );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> log ( const HyperDual<N> &a )
+	 {
+		const double inv_a = 1./a.val();
+		return a.chain( std::log(a.val()), inv_a, -inv_a*inv_a );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> log10 ( const HyperDual<N> &a )
+	 {
+		const double inv_a_ln10 = 1./(a.val()*std::log(10.));
+		return a.chain( std::log10(a.val()), inv_a_ln10, -inv_a_ln10/a.val() );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> pow ( const HyperDual<N> &a, const double b )
+	 {
+		const double f2 = ( b==1. ) ? 0. : b*(b-1.)*std::pow(a.val(),b-2.);
+		return a.chain( std::pow(a.val(),b), b*std::pow(a.val(),b-1.), f2 );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> pow ( const HyperDual<N> &a, const HyperDual<N> &b )
+	 {
+		return exp( b * log(a) );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> pow ( const double a, const HyperDual<N> &b )
+	 {
+		return exp( std::log(a) * b );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> sin ( const HyperDual<N> &a )
+	 {
+		const double sin_a = std::sin(a.val());
+		return a.chain( sin_a, std::cos(a.val()), -sin_a );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> cos ( const HyperDual<N> &a )
+	 {
+		const double cos_a = std::cos(a.val());
+		return a.chain( cos_a, -std::sin(a.val()), -cos_a );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> tan ( const HyperDual<N> &a )
+	 {
+		const double tan_a = std::tan(a.val());
+		const double f1 = 1. + tan_a*tan_a;
+		return a.chain( tan_a, f1, 2.*tan_a*f1 );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> atan ( const HyperDual<N> &a )
+	 {
+		const double f1 = 1./(1.+a.val()*a.val());
+		return a.chain( std::atan(a.val()), f1, -2.*a.val()*f1*f1 );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> sinh ( const HyperDual<N> &a )
+	 {
+		const double sinh_a = std::sinh(a.val());
+		return a.chain( sinh_a, std::cosh(a.val()), sinh_a );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> cosh ( const HyperDual<N> &a )
+	 {
+		const double cosh_a = std::cosh(a.val());
+		return a.chain( cosh_a, std::sinh(a.val()), cosh_a );
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> tanh ( const HyperDual<N> &a )
+	 {
+		const double tanh_a = std::tanh(a.val());
+		const double f1 = 1. - tanh_a*tanh_a;
+		return a.chain( tanh_a, f1, -2.*tanh_a*f1 );
+	 }
+
+	 // The kink at zero is treated as for the Sacado data types (derivative of the positive branch)
+	 template<unsigned int N>
+	 inline HyperDual<N> abs ( const HyperDual<N> &a )
+	 {
+		return ( a.val()<0. ) ? -a : a;
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> fabs ( const HyperDual<N> &a )
+	 {
+		return abs(a);
+	 }
+
+	 template<unsigned int N>
+	 inline HyperDual<N> max ( const HyperDual<N> &a, const HyperDual<N> &b ) { return ( a.val()<b.val() ) ? b : a; }
+	 template<unsigned int N>
+	 inline HyperDual<N> min ( const HyperDual<N> &a, const HyperDual<N> &b ) { return ( b.val()<a.val() ) ? b : a; }
+
+
+	/*
+	 * Accessors for the second-order wrapper classes (see value2, d_dx, d2_dxdy and seed2 in Sacado_Wrapper.h)
+	 */
+	 template<unsigned int N>
+	 inline double value2 ( const HyperDual<N> &argument )
+	 {
+		return argument.val();
+	 }
+
+	 template<unsigned int N>
+	 inline double d_dx ( const HyperDual<N> &argument, const unsigned int x )
+	 {
+		return argument.dx(x);
+	 }
+
+	 template<unsigned int N>
+	 inline double d2_dxdy ( const HyperDual<N> &argument, const unsigned int x, const unsigned int y )
+	 {
+		return argument.dx2(x,y);
+	 }
+
+	 template<unsigned int N>
+	 inline void seed2 ( HyperDual<N> &variable, const double value, const unsigned int dof, const unsigned int nbr_total_dofs )
+	 {
+		Assert( nbr_total_dofs<=N, ExcMessage("HyperDual<N>: The total number of dofs exceeds N.") );
+		variable.val() = value;
+		variable.diff( dof, nbr_total_dofs );
+	 }
+
+
+	template<unsigned int N>
+	std::ostream &operator<< ( std::ostream &os, const HyperDual<N> &a )
+	{
+		os << a.val() << " [";
+		for ( unsigned int i=0; i<N; ++i )
+			os << " " << a.dx(i);
+		os << " ] [";
+		for ( unsigned int i=0; i<N; ++i )
+			for ( unsigned int j=i; j<N; ++j )
+				os << " " << a.dx2(i,j);
+		return os << " ]";
+	}
+}
+
+
+
+/*
+ * deal.II traits, such that HyperDual<N> can be used as the number type of SymmetricTensor and Tensor
+ * (e.g. multiplication with scalars, norm, unit_symmetric_tensor), see Sacado-number_type_traits.h
+ */
+ SACADO_WRAPPER_DEAL_II_NUMBER_TRAITS(HyperDual)
+
+
+namespace Sacado_Wrapper
+{
+	/*
+	 * Second-order wrapper data types based on HyperDual<N> (first-order data type: Sacado::Fad::SFad<double,N>),
+	 * where N must be exactly the total number of dofs (e.g. n_total_dofs<dim,1>::value for eps and phi).
+	 */
+	 template<int dim, unsigned int N>
+	 using SymTensor2_HyperDual = SymTensor2<dim, HyperDual<N> >;
+	 template<int dim, unsigned int N>
+	 using SW_double2_HyperDual = SW_double2<dim, HyperDual<N> >;
+	 template<int dim, unsigned int N>
+	 using DoFs_summary_HyperDual = DoFs_summary<dim, Sacado::Fad::SFad<double,N>, HyperDual<N> >;
+	 template<unsigned int N>
+	 using HyperDual_policy = FadPolicy< Sacado::Fad::SFad<double,N>, HyperDual<N> >;
+}
+
+#endif // Sacado_hyper_dual_H
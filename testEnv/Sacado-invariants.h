@@ -0,0 +1,176 @@
+#ifndef Sacado_invariants_H
+#define Sacado_invariants_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <array>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Invariant-based second derivatives: AD only with respect to the invariants I1, I2, I3 of the strain
+ *
+ * Many energies depend on the strain only through its invariants, e.g. the energy of \ref Ex7 "example 7" with
+ * trace(eps²) = I1² - 2 I2. With the SymTensor2 all 6 strain components (plus e.g. phi) are seeded, so the nested Sacado
+ * data type has 7 dofs and 49 second derivatives. The StrainInvariants instead seed only the 3 invariants and the
+ * \a n_scalar_dofs additional scalars (4 dofs, 16 second derivatives for phi). The stress and the tangent are assembled by
+ * the chain rule with the analytical derivatives of the invariants:
+ * \f[ \sigma = \sum_a \frac{\partial \Psi}{\partial I_a} \frac{\partial I_a}{\partial \varepsilon} \qquad
+ * 	   C = \sum_{a,b} \frac{\partial^2 \Psi}{\partial I_a \partial I_b} \frac{\partial I_a}{\partial \varepsilon} \otimes \frac{\partial I_b}{\partial \varepsilon}
+ * 	   + \sum_a \frac{\partial \Psi}{\partial I_a} \frac{\partial^2 I_a}{\partial \varepsilon^2} \f]
+ * @code
+ * 	Sacado_Wrapper::StrainInvariants<3,1> invariants;	// 3 invariants + phi
+ * 	invariants.reseed( eps_d, {{phi_d}} );
+ * 	const fad2_double energy = energy_invariants<fad2_double>( invariants.I1(), invariants.I2(), invariants.I3(), invariants.scalar(0) );
+ * 	invariants.get_tangent(sigma, energy);
+ * 	invariants.get_curvature(C, energy);
+ * 	invariants.get_curvature(d2_psi_d_eps_d_phi, energy, 0);
+ * @endcode
+ * With I2 = (I1² - trace(eps²))/2 and I3 = det(eps) the derivatives of I3 follow from the Cayley-Hamilton theorem
+ * (dI3/d_eps = eps² - I1 eps + I2 I), so they also exist for a singular strain.
+ * @note Only for dim=3. \a Number2 is a nested second-order data type with at least 3+n_scalar_dofs dofs, e.g.
+ * Sacado::Fad::SFad<Sacado::Fad::SFad<double,4>,4> for the invariants and phi.
+ */
+namespace Sacado_Wrapper
+{
+	template<int dim, unsigned int n_scalar_dofs=0, typename Number2=Sacado::Fad::DFad<DFadType> >
+	class StrainInvariants
+	{
+		static_assert( dim==3, "StrainInvariants: only implemented for dim=3." );
+
+	  public:
+		// Number of the seeded dofs: I1, I2, I3 and the additional scalars
+		 static const unsigned int n_dofs = 3 + n_scalar_dofs;
+
+		StrainInvariants ();
+
+		// Compute the invariants of the strain \a eps and their derivatives and seed them together with the \a scalars
+		 void reseed ( const SymmetricTensor<2,dim> &eps, const std::array<double,n_scalar_dofs> &scalars = std::array<double,n_scalar_dofs>() );
+
+		const Number2 &I1 () const { return invariants[0]; }
+		const Number2 &I2 () const { return invariants[1]; }
+		const Number2 &I3 () const { return invariants[2]; }
+
+		// The k-th additional scalar (e.g. phi)
+		 const Number2 &scalar ( const unsigned int k ) const { return scalars[k]; }
+
+		// First derivative d_argument/d_eps (e.g. the stress for the energy)
+		 void get_tangent ( SymmetricTensor<2,dim> &Tangent, const Number2 &argument ) const;
+
+		// First derivative d_argument/d_scalar_k
+		 void get_tangent ( double &Tangent, const Number2 &argument, const unsigned int k ) const;
+
+		// Second derivative d2_argument/d_eps2 (e.g. the tangent for the energy)
+		 void get_curvature ( SymmetricTensor<4,dim> &Curvature, const Number2 &argument ) const;
+
+		// Mixed second derivative d2_argument/d_eps_d_scalar_k
+		 void get_curvature ( SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const unsigned int k ) const;
+
+		// Second derivative d2_argument/d_scalar_k_d_scalar_l
+		 void get_curvature ( double &Curvature, const Number2 &argument, const unsigned int k, const unsigned int l ) const;
+
+	  private:
+		Number2 invariants[3];
+		std::array<Number2,n_scalar_dofs> scalars;
+
+		// Analytical first and second derivatives of the invariants with respect to the strain (d2_I1/d_eps2 = 0)
+		 SymmetricTensor<2,dim> dI_deps[3];
+		 SymmetricTensor<4,dim> d2I_deps2[3];
+	};
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	StrainInvariants<dim,n_scalar_dofs,Number2>::StrainInvariants ()
+	{
+		// The constant derivatives: dI1/d_eps = I and d2_I2/d_eps2 = I x I - II^sym
+		 const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+		 dI_deps[0] = I;
+		 d2I_deps2[1] = dealii::outer_product(I, I) - identity_tensor<dim>();
+	}
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	void StrainInvariants<dim,n_scalar_dofs,Number2>::reseed ( const SymmetricTensor<2,dim> &eps, const std::array<double,n_scalar_dofs> &scalars_d )
+	{
+		const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+
+		// eps² = eps_im * eps_mj
+		 SymmetricTensor<2,dim> eps_squared;
+		 for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				for ( unsigned int m=0; m<dim; ++m )
+					eps_squared[i][j] += eps[i][m] * eps[m][j];
+
+		const double I1_d = trace(eps);
+		const double I2_d = 0.5 * ( I1_d*I1_d - trace(eps_squared) );
+		const double I3_d = determinant(eps);
+
+		dI_deps[1] = I1_d * I - eps;
+		dI_deps[2] = eps_squared - I1_d * eps + I2_d * I;
+
+		// d2_I3/d_eps2 = d(eps²)/d_eps - I1 II^sym - eps x I - I x eps + I1 I x I,
+		// with the symmetrised d(eps²)_ij/d_eps_kl = ( delta_ik eps_jl + delta_il eps_jk + eps_ik delta_jl + eps_il delta_jk )/2
+		 SymmetricTensor<4,dim> &d2I3 = d2I_deps2[2];
+		 for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				for ( unsigned int k=0; k<dim; ++k )
+					for ( unsigned int l=k; l<dim; ++l )
+						d2I3[i][j][k][l] = 0.5 * ( I[i][k]*eps[j][l] + I[i][l]*eps[j][k] + eps[i][k]*I[j][l] + eps[i][l]*I[j][k] )
+										   - 0.5 * I1_d * ( I[i][k]*I[j][l] + I[i][l]*I[j][k] )
+										   - eps[i][j]*I[k][l] - I[i][j]*eps[k][l] + I1_d * I[i][j]*I[k][l];
+
+		seed2( invariants[0], I1_d, 0, n_dofs );
+		seed2( invariants[1], I2_d, 1, n_dofs );
+		seed2( invariants[2], I3_d, 2, n_dofs );
+		for ( unsigned int k=0; k<n_scalar_dofs; ++k )
+			seed2( scalars[k], scalars_d[k], 3+k, n_dofs );
+	}
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	void StrainInvariants<dim,n_scalar_dofs,Number2>::get_tangent ( SymmetricTensor<2,dim> &Tangent, const Number2 &argument ) const
+	{
+		Tangent = d_dx(argument,0) * dI_deps[0];
+		for ( unsigned int a=1; a<3; ++a )
+			Tangent += d_dx(argument,a) * dI_deps[a];
+	}
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	void StrainInvariants<dim,n_scalar_dofs,Number2>::get_tangent ( double &Tangent, const Number2 &argument, const unsigned int k ) const
+	{
+		Tangent = d_dx( argument, 3+k );
+	}
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	void StrainInvariants<dim,n_scalar_dofs,Number2>::get_curvature ( SymmetricTensor<4,dim> &Curvature, const Number2 &argument ) const
+	{
+		// The second derivatives with respect to the invariants (the 3x3 matrix is symmetric)
+		 Curvature = d_dx(argument,1) * d2I_deps2[1] + d_dx(argument,2) * d2I_deps2[2];
+		 for ( unsigned int a=0; a<3; ++a )
+		 {
+			Curvature += d2_dxdy(argument,a,a) * dealii::outer_product( dI_deps[a], dI_deps[a] );
+			for ( unsigned int b=a+1; b<3; ++b )
+				Curvature += d2_dxdy(argument,a,b) * ( dealii::outer_product(dI_deps[a], dI_deps[b]) + dealii::outer_product(dI_deps[b], dI_deps[a]) );
+		 }
+	}
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	void StrainInvariants<dim,n_scalar_dofs,Number2>::get_curvature ( SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const unsigned int k ) const
+	{
+		Curvature = d2_dxdy(argument,0,3+k) * dI_deps[0];
+		for ( unsigned int a=1; a<3; ++a )
+			Curvature += d2_dxdy(argument,a,3+k) * dI_deps[a];
+	}
+
+
+	template<int dim, unsigned int n_scalar_dofs, typename Number2>
+	void StrainInvariants<dim,n_scalar_dofs,Number2>::get_curvature ( double &Curvature, const Number2 &argument, const unsigned int k, const unsigned int l ) const
+	{
+		Curvature = d2_dxdy( argument, 3+k, 3+l );
+	}
+}
+
+#endif // Sacado_invariants_H
@@ -0,0 +1,187 @@
+#ifndef Sacado_kokkos_batch_H
+#define Sacado_kokkos_batch_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+// Sacado with the specialisations of the Kokkos views for Fad types (Trilinos configured with Kokkos)
+#include <Sacado.hpp>
+#include <Kokkos_Core.hpp>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Kokkos backend: The inputs and outputs of a whole batch of points (e.g. all quadrature points of a cell batch) stored
+ * in Kokkos views of Sacado data types.
+ *
+ * The strains, phi and the stresses live in Kokkos::View<Sacado::Fad::SFad<double,N>*> with the contiguous Fad layout of
+ * Sacado (Kokkos::LayoutContiguous), i.e. the value and the N derivatives of every entry are stored next to each other, and
+ * the entries of a point are stored next to each other (point-major). The tangents and the coupling are extracted to views
+ * of double. The model is evaluated by one Kokkos::parallel_for over the points on the OpenMP host execution space, where
+ * every point is seeded with the same dof order as the wrapper (the strain components 0 ... n_dofs-1 and phi as dof n_dofs),
+ * so the values of the tangent are the same as those of SymTensor::get_tangent.
+ * @code
+ * 	Kokkos::initialize(argc, argv);
+ * 	{
+ * 		Sacado_Wrapper::KokkosPointBatch<3,7> batch (n_points);
+ * 		for ( unsigned int p=0; p<n_points; ++p )
+ * 			batch.set( p, eps_d[p], phi_d[p] );
+ * 		batch.evaluate( [] (const SymmetricTensor<2,3,Sacado::Fad::SFad<double,7> > &eps, const Sacado::Fad::SFad<double,7> &phi)
+ * 		{
+ * 			return stress_eps_phi<3,Sacado::Fad::SFad<double,7> >( eps, phi );
+ * 		});
+ * 		SymmetricTensor<4,3> C = batch.get_tangent(0);
+ * 	}
+ * 	Kokkos::finalize();
+ * @endcode
+ * @note The backend is optional, it is only built with the CMake option SACADO_WRAPPER_WITH_KOKKOS (see CMakeLists.txt).
+ * The model uses the deal.II tensors, so it runs on host execution spaces only.
+ */
+namespace Sacado_Wrapper
+{
+#ifdef KOKKOS_ENABLE_OPENMP
+	typedef Kokkos::OpenMP kokkos_execution_space;
+#else
+	typedef Kokkos::DefaultHostExecutionSpace kokkos_execution_space;
+#endif
+
+	template<int dim, int N>
+	class KokkosPointBatch
+	{
+	public:
+		typedef Sacado::Fad::SFad<double,N> Number;
+		typedef kokkos_execution_space ExecutionSpace;
+
+		typedef Kokkos::View<Number*, Kokkos::LayoutContiguous<Kokkos::LayoutRight>, ExecutionSpace> FadView;
+		typedef Kokkos::View<double*, Kokkos::LayoutRight, ExecutionSpace> ValueView;
+
+		static const unsigned int n_dofs = ((dim==2)?3:6);
+
+		static_assert( N>n_dofs, "KokkosPointBatch: N must contain the dofs of the strain and of phi." );
+
+		explicit KokkosPointBatch ( const unsigned int n_points );
+
+		unsigned int size () const { return n_points; }
+
+		// Set the strain \a eps and the scalar \a phi of the point \a p (on the host)
+		 void set ( const unsigned int p, const dealii::SymmetricTensor<2,dim> &eps, const double phi );
+
+		/*
+		 * Evaluate the stress \a model(eps,phi) at all points, where \a model maps the SymmetricTensor<2,dim,Number> of the
+		 * strain and the Number of phi to the SymmetricTensor<2,dim,Number> of the stress
+		 */
+		 template<typename Model>
+		 void evaluate ( const Model &model );
+
+		dealii::SymmetricTensor<2,dim> get_stress ( const unsigned int p ) const;
+		dealii::SymmetricTensor<4,dim> get_tangent ( const unsigned int p ) const;
+		dealii::SymmetricTensor<2,dim> get_d_sigma_d_phi ( const unsigned int p ) const;
+
+		// The strains and phi (seeded), the stresses (with the derivatives), each point-major
+		 FadView eps;
+		 FadView phi;
+		 FadView sigma;
+
+		// The values of the strains and phi, the tangents (n_dofs x n_dofs per point) and the coupling d_sigma_d_phi
+		 ValueView eps_values;
+		 ValueView phi_values;
+		 ValueView C;
+		 ValueView d_sigma_d_phi;
+
+	private:
+		unsigned int n_points;
+	};
+
+
+	template<int dim, int N>
+	KokkosPointBatch<dim,N>::KokkosPointBatch ( const unsigned int n_points )
+	:
+	// The last argument of the Fad views is the size of the Fad (the value and the N derivatives)
+	 eps("eps", n_points*n_dofs, N+1),
+	 phi("phi", n_points, N+1),
+	 sigma("sigma", n_points*n_dofs, N+1),
+	eps_values("eps_values", n_points*n_dofs),
+	phi_values("phi_values", n_points),
+	C("C", n_points*n_dofs*n_dofs),
+	d_sigma_d_phi("d_sigma_d_phi", n_points*n_dofs),
+	n_points(n_points)
+	{
+	}
+
+
+	template<int dim, int N>
+	void KokkosPointBatch<dim,N>::set ( const unsigned int p, const dealii::SymmetricTensor<2,dim> &eps_d, const double phi_d )
+	{
+		for ( unsigned int x=0; x<n_dofs; ++x )
+			eps_values(p*n_dofs+x) = eps_d[index_i<dim>(x)][index_j<dim>(x)];
+		phi_values(p) = phi_d;
+	}
+
+
+	template<int dim, int N>
+	template<typename Model>
+	void KokkosPointBatch<dim,N>::evaluate ( const Model &model )
+	{
+		// The lambda captures by value, which copies the handles of the views and not the data
+		 const FadView eps = this->eps, phi = this->phi, sigma = this->sigma;
+		 const ValueView eps_values = this->eps_values, phi_values = this->phi_values, C = this->C, d_sigma_d_phi = this->d_sigma_d_phi;
+
+		Kokkos::parallel_for( "Sacado_Wrapper::KokkosPointBatch::evaluate", Kokkos::RangePolicy<ExecutionSpace>(0,n_points),
+							  [=] ( const int p )
+		{
+			// Seed the strain and phi, the derivatives of the strain components are those of the SymmetricTensor entries
+			 dealii::SymmetricTensor<2,dim,Number> eps_p;
+			 for ( unsigned int x=0; x<n_dofs; ++x )
+			 {
+				eps(p*n_dofs+x) = Number( N, x, eps_values(p*n_dofs+x) );
+				eps_p[index_i<dim>(x)][index_j<dim>(x)] = eps(p*n_dofs+x);
+			 }
+			 phi(p) = Number( N, n_dofs, phi_values(p) );
+			 const Number phi_p = phi(p);
+
+			const dealii::SymmetricTensor<2,dim,Number> sigma_p = model( eps_p, phi_p );
+
+			for ( unsigned int y=0; y<n_dofs; ++y )
+			{
+				const Number &sigma_y = sigma_p[index_i<dim>(y)][index_j<dim>(y)];
+				sigma(p*n_dofs+y) = sigma_y;
+				for ( unsigned int x=0; x<n_dofs; ++x )
+					C((p*n_dofs+y)*n_dofs+x) = voigt_scale<dim>(x) * sigma_y.fastAccessDx(x);
+				d_sigma_d_phi(p*n_dofs+y) = sigma_y.fastAccessDx(n_dofs);
+			}
+		});
+		Kokkos::fence();
+	}
+
+
+	template<int dim, int N>
+	dealii::SymmetricTensor<2,dim> KokkosPointBatch<dim,N>::get_stress ( const unsigned int p ) const
+	{
+		dealii::SymmetricTensor<2,dim> tmp;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			tmp[index_i<dim>(y)][index_j<dim>(y)] = sigma(p*n_dofs+y).val();
+		return tmp;
+	}
+
+
+	template<int dim, int N>
+	dealii::SymmetricTensor<4,dim> KokkosPointBatch<dim,N>::get_tangent ( const unsigned int p ) const
+	{
+		dealii::SymmetricTensor<4,dim> tmp;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				tmp[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = C((p*n_dofs+y)*n_dofs+x);
+		return tmp;
+	}
+
+
+	template<int dim, int N>
+	dealii::SymmetricTensor<2,dim> KokkosPointBatch<dim,N>::get_d_sigma_d_phi ( const unsigned int p ) const
+	{
+		dealii::SymmetricTensor<2,dim> tmp;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			tmp[index_i<dim>(y)][index_j<dim>(y)] = d_sigma_d_phi(p*n_dofs+y);
+		return tmp;
+	}
+}
+
+#endif // Sacado_kokkos_batch_H
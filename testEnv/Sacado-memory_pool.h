@@ -0,0 +1,631 @@
+#ifndef Sacado_memory_pool_H
+#define Sacado_memory_pool_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+#include <thread>
+
+// Sacado (from Trilinos, data types, operations, ...), including the expression framework Sacado::Fad::Exp
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Memory pools for the derivative arrays of the dynamically sized data types.
+ *
+ * Every Sacado::Fad::DFad variable (the wrapper variables, but also all the intermediates such as \a sigma, \a eps_squared or
+ * the \a energy) allocates its derivative array on the heap. With many threads assembling at the same time these calls to
+ * malloc/free contend for the heap. Two modes avoid this:
+ * - Sacado::Fad::DMFad with the Sacado::Fad::MemPoolManager: The derivative arrays are taken from a pool of fixed-size
+ *   blocks. However, the active pool is a static member of DMFad, so this mode is limited to a single thread (the
+ *   pool selection throws when called from a second thread).
+ * - Sacado_Wrapper::PoolFad: The Sacado expression data type Sacado::Fad::Exp::GeneralFad with the storage PoolStorage,
+ *   which takes the derivative arrays from the free lists of the calling thread (ThreadLocalPool). No locks are needed,
+ *   so it scales with the number of threads.
+ *
+ * In both modes the DoFs_summary selects the pool for the total number of dofs whenever the dofs are set or reseeded
+ * (see internal::pool_selector), so the material model itself remains unchanged:
+ * @code
+ * 	Sacado_Wrapper::SymTensor2_pool<dim> eps;
+ * 	Sacado_Wrapper::SW_double2_pool<dim> phi;
+ * 	Sacado_Wrapper::DoFs_summary_pool<dim> DoFs_summary;
+ * 	DoFs_summary.reseed(eps, eps_d, phi, phi_d); // reserves blocks of 7 derivatives in the pool of this thread
+ * 	...
+ * 	Sacado_Wrapper::PoolStatistics statistics = Sacado_Wrapper::ThreadLocalPool<double>::statistics();
+ * @endcode
+ * @note The expression framework Sacado::Fad::Exp is part of Sacado.hpp since Trilinos 12.12.
+ * @note The pools of a thread are destroyed when the thread exits, so PoolFad variables must not outlive the thread that
+ * uses them (e.g. as static or global variables).
+ */
+namespace Sacado_Wrapper
+{
+	/*
+	 * Statistics of the pool of one thread (all sizes of blocks)
+	 */
+	struct PoolStatistics
+	{
+		unsigned long n_allocations = 0;		// blocks requested
+		unsigned long n_heap_allocations = 0;	// blocks that had to be allocated on the heap (free list empty)
+		unsigned long n_deallocations = 0;		// blocks returned to the free lists
+		unsigned long n_heap_deallocations = 0;	// blocks returned to the heap instead (free list at its bound)
+		unsigned long n_in_use = 0;				// blocks currently held by variables (or by the entries of free blocks of the nested data type)
+		unsigned long max_in_use = 0;			// peak of \a n_in_use
+
+		// Add the counters of the pool of another thread. The peaks of different threads need not coincide in time, so
+		// \a max_in_use becomes the largest peak of a single thread.
+		 PoolStatistics &operator+= ( const PoolStatistics &other );
+
+		// Fraction of the requests that were served from the free lists
+		 double hit_rate () const;
+
+		void print ( std::ostream &os ) const;
+	};
+
+
+	/*
+	 * Pool of derivative arrays of the entries \a T (double, or a Fad for the nested data types). Each thread owns a free list
+	 * for every size of block, so allocations and deallocations never synchronise. A block that is released on another thread
+	 * than it was taken on joins the free list of that thread. Each free list is bounded by the number of blocks its thread
+	 * created itself (at least \a n_pool_blocks), so the surplus from other threads goes back to the heap.
+	 * All the member functions act on the pool of the calling thread.
+	 */
+	template<typename T>
+	class ThreadLocalPool
+	{
+	public:
+		static T *allocate ( const unsigned int n );
+
+		static void deallocate ( T *block, const unsigned int n );
+
+		// Make sure that at least \a n_blocks blocks of size \a n were created by the pool of this thread
+		 static void reserve ( const unsigned int n, const unsigned int n_blocks );
+
+		static PoolStatistics statistics ();
+		static void reset_statistics ();
+
+		// Free all blocks in the free lists of this thread
+		 static void release ();
+
+		// Create the free lists of this thread (done by all the other member functions on first use)
+		 static void initialize ();
+
+	private:
+		struct FreeLists
+		{
+			std::vector< std::vector<T*> > blocks;	// blocks[n]: free blocks of n entries
+			std::vector<unsigned int> n_created;	// n_created[n]: number of blocks of n entries allocated on the heap
+			PoolStatistics statistics;
+
+			FreeLists ();
+			~FreeLists ();
+		};
+
+		static FreeLists &local ();
+
+		// Whether the free lists of this thread were already destroyed (at the exit of the thread)
+		 static bool &destroyed ();
+	};
+
+
+	/*
+	 * Storage of the value and the derivative array for Sacado::Fad::Exp::GeneralFad, analogous to Sacado's DynamicStorage,
+	 * but with the derivative array from the ThreadLocalPool
+	 */
+	template<typename T>
+	class PoolStorage
+	{
+	public:
+		typedef typename std::remove_cv<T>::type value_type;
+		static constexpr bool is_statically_sized = false;
+		static constexpr int static_size = 0;
+		static constexpr bool is_view = false;
+
+		// The same storage for another value type, or a given number of derivatives
+		 template<typename TT>
+		 struct apply { typedef PoolStorage<TT> type; };
+		 template<int N>
+		 struct apply_N { typedef PoolStorage<T> type; };
+
+		PoolStorage () : val_(), sz_(0), len_(0), dx_(nullptr) {}
+
+		PoolStorage ( const T &x ) : val_(x), sz_(0), len_(0), dx_(nullptr) {}
+
+		PoolStorage ( const int sz, const T &x, const Sacado::DerivInit zero_out=Sacado::InitDerivArray );
+
+		PoolStorage ( const int sz, const int i, const value_type &x );
+
+		PoolStorage ( const PoolStorage &x );
+
+		PoolStorage ( PoolStorage &&x );
+
+		~PoolStorage ();
+
+		PoolStorage &operator= ( const PoolStorage &x );
+
+		PoolStorage &operator= ( PoolStorage &&x );
+
+		int size () const { return sz_; }
+		int length () const { return len_; }
+
+		// Resize the derivative array (the derivatives are lost and zero if the array grows)
+		 void resize ( int sz );
+		 void resizeAndZero ( int sz );
+		// Resize and keep the existing derivatives
+		 void expand ( int sz );
+
+		void zero () { std::fill( dx_, dx_+sz_, T(0.) ); }
+
+		const T &val () const { return val_; }
+		T &val () { return val_; }
+
+		const T *dx () const { return dx_; }
+		T dx ( int i ) const { return sz_ ? dx_[i] : T(0.); }
+
+		T &fastAccessDx ( int i ) { return dx_[i]; }
+		const T &fastAccessDx ( int i ) const { return dx_[i]; }
+
+	private:
+		// Take a block of \a n entries from the pool and set all entries to zero
+		 static T *get_and_fill ( const int n );
+
+		T val_;
+		int sz_;	// number of derivatives in use
+		int len_;	// length of the block \a dx_
+		T *dx_;
+	};
+
+
+	/*
+	 * The Sacado expression data type with the thread-local pool storage (cf. Sacado::Fad::Exp::DFad)
+	 */
+	 template<typename T>
+	 using PoolFad = Sacado::Fad::Exp::GeneralFad< PoolStorage<T> >;
+
+	 typedef FadPolicy< PoolFad<double>, PoolFad< PoolFad<double> > > PoolFad_policy;
+
+	 template<int dim>
+	 using SymTensor_pool = SymTensor<dim, PoolFad<double> >;
+	 template<int dim>
+	 using SW_double_pool = SW_double<dim, PoolFad<double> >;
+	 template<int dim>
+	 using SymTensor2_pool = SymTensor2<dim, PoolFad< PoolFad<double> > >;
+	 template<int dim>
+	 using SW_double2_pool = SW_double2<dim, PoolFad< PoolFad<double> > >;
+	 template<int dim>
+	 using DoFs_summary_pool = DoFs_summary<dim, PoolFad<double>, PoolFad< PoolFad<double> > >;
+
+
+	// Number of blocks of each size reserved when DoFs_summary selects the pool of a thread
+	 static const unsigned int n_pool_blocks = 64;
+
+
+	namespace internal
+	{
+		/*
+		 * The pool of the entries of the blocks of \a T: none for double, the pool of \a U for the nested data type PoolFad<U>
+		 */
+		 template<typename T>
+		 struct inner_pool
+		 {
+			static void initialize () {}
+		 };
+
+		 template<typename U>
+		 struct inner_pool< PoolFad<U> >
+		 {
+			static void initialize ()
+			{
+				ThreadLocalPool<U>::initialize();
+			}
+		 };
+	}
+
+
+	//###########################################################################################################//
+
+
+	inline PoolStatistics &PoolStatistics::operator+= ( const PoolStatistics &other )
+	{
+		n_allocations += other.n_allocations;
+		n_heap_allocations += other.n_heap_allocations;
+		n_deallocations += other.n_deallocations;
+		n_heap_deallocations += other.n_heap_deallocations;
+		n_in_use += other.n_in_use;
+		max_in_use = std::max( max_in_use, other.max_in_use );
+		return *this;
+	}
+
+	inline double PoolStatistics::hit_rate () const
+	{
+		return ( n_allocations>0 ) ? 1. - double(n_heap_allocations)/double(n_allocations) : 1.;
+	}
+
+	inline void PoolStatistics::print ( std::ostream &os ) const
+	{
+		os << "allocations: " << n_allocations
+		   << ", from heap: " << n_heap_allocations
+		   << ", hit rate: " << hit_rate()
+		   << ", deallocations: " << n_deallocations
+		   << ", to heap: " << n_heap_deallocations
+		   << ", in use: " << n_in_use
+		   << ", max in use: " << max_in_use << std::endl;
+	}
+
+
+	template<typename T>
+	typename ThreadLocalPool<T>::FreeLists &ThreadLocalPool<T>::local ()
+	{
+		Assert( !destroyed(), dealii::ExcMessage("The pool of this thread was already destroyed (see Sacado-memory_pool.h).") );
+		static thread_local FreeLists lists;
+		return lists;
+	}
+
+	template<typename T>
+	bool &ThreadLocalPool<T>::destroyed ()
+	{
+		// A bool has no destructor, so it can still be read after the free lists were destroyed
+		 static thread_local bool flag = false;
+		return flag;
+	}
+
+	template<typename T>
+	ThreadLocalPool<T>::FreeLists::FreeLists ()
+	{
+		// The entries of the blocks of the nested data type own blocks of the inner pool, which they return when the blocks
+		// are deleted. Thread-local objects are destroyed in the reverse order of their construction, so the inner pool of
+		// this thread is created first to outlive this one.
+		 internal::inner_pool<T>::initialize();
+	}
+
+	template<typename T>
+	ThreadLocalPool<T>::FreeLists::~FreeLists ()
+	{
+		for ( unsigned int n=0; n<blocks.size(); ++n )
+			for ( T *block : blocks[n] )
+				delete[] block;
+		destroyed() = true;
+	}
+
+	template<typename T>
+	T *ThreadLocalPool<T>::allocate ( const unsigned int n )
+	{
+		FreeLists &lists = local();
+		PoolStatistics &statistics = lists.statistics;
+
+		++statistics.n_allocations;
+		++statistics.n_in_use;
+		statistics.max_in_use = std::max( statistics.max_in_use, statistics.n_in_use );
+
+		if ( n<lists.blocks.size() && !lists.blocks[n].empty() )
+		{
+			T *block = lists.blocks[n].back();
+			lists.blocks[n].pop_back();
+			return block;
+		}
+
+		++statistics.n_heap_allocations;
+		if ( n>=lists.n_created.size() )
+			lists.n_created.resize(n+1, 0);
+		++lists.n_created[n];
+		return new T[n];
+	}
+
+	template<typename T>
+	void ThreadLocalPool<T>::deallocate ( T *block, const unsigned int n )
+	{
+		FreeLists &lists = local();
+
+		++lists.statistics.n_deallocations;
+		// Blocks taken on another thread may bring the counter of this thread below zero
+		 if ( lists.statistics.n_in_use>0 )
+			--lists.statistics.n_in_use;
+
+		if ( n>=lists.blocks.size() )
+			lists.blocks.resize(n+1);
+
+		// Blocks taken on other threads would let the free list grow without limit
+		 const unsigned int n_created = ( n<lists.n_created.size() ) ? lists.n_created[n] : 0;
+		 if ( lists.blocks[n].size()>=std::max(n_created, n_pool_blocks) )
+		 {
+			++lists.statistics.n_heap_deallocations;
+			delete[] block;
+			return;
+		 }
+		lists.blocks[n].push_back(block);
+	}
+
+	template<typename T>
+	void ThreadLocalPool<T>::reserve ( const unsigned int n, const unsigned int n_blocks )
+	{
+		FreeLists &lists = local();
+
+		if ( n>=lists.n_created.size() )
+			lists.n_created.resize(n+1, 0);
+		if ( lists.n_created[n]>=n_blocks )
+			return;
+
+		if ( n>=lists.blocks.size() )
+			lists.blocks.resize(n+1);
+		for ( ; lists.n_created[n]<n_blocks; ++lists.n_created[n] )
+			lists.blocks[n].push_back( new T[n] );
+	}
+
+	template<typename T>
+	PoolStatistics ThreadLocalPool<T>::statistics ()
+	{
+		return local().statistics;
+	}
+
+	template<typename T>
+	void ThreadLocalPool<T>::reset_statistics ()
+	{
+		PoolStatistics &statistics = local().statistics;
+		const unsigned long n_in_use = statistics.n_in_use;
+		statistics = PoolStatistics();
+		statistics.n_in_use = n_in_use;
+		statistics.max_in_use = n_in_use;
+	}
+
+	template<typename T>
+	void ThreadLocalPool<T>::release ()
+	{
+		FreeLists &lists = local();
+		for ( unsigned int n=0; n<lists.blocks.size(); ++n )
+		{
+			for ( T *block : lists.blocks[n] )
+				delete[] block;
+			lists.blocks[n].clear();
+		}
+		lists.n_created.clear();
+	}
+
+	template<typename T>
+	void ThreadLocalPool<T>::initialize ()
+	{
+		local();
+	}
+
+
+	template<typename T>
+	T *PoolStorage<T>::get_and_fill ( const int n )
+	{
+		T *block = ThreadLocalPool<T>::allocate(n);
+		std::fill( block, block+n, T(0.) );
+		return block;
+	}
+
+	template<typename T>
+	PoolStorage<T>::PoolStorage ( const int sz, const T &x, const Sacado::DerivInit zero_out )
+	:
+	val_(x),
+	sz_(sz),
+	len_(sz),
+	dx_(nullptr)
+	{
+		if ( sz_>0 )
+		{
+			dx_ = ThreadLocalPool<T>::allocate(sz_);
+			if ( zero_out==Sacado::InitDerivArray )
+				(*this).zero();
+		}
+	}
+
+	template<typename T>
+	PoolStorage<T>::PoolStorage ( const int sz, const int i, const value_type &x )
+	:
+	PoolStorage(sz, x, Sacado::InitDerivArray)
+	{
+		dx_[i] = T(1.);
+	}
+
+	template<typename T>
+	PoolStorage<T>::PoolStorage ( const PoolStorage &x )
+	:
+	val_(x.val_),
+	sz_(x.sz_),
+	len_(x.sz_),
+	dx_(nullptr)
+	{
+		if ( sz_>0 )
+		{
+			dx_ = ThreadLocalPool<T>::allocate(sz_);
+			std::copy( x.dx_, x.dx_+sz_, dx_ );
+		}
+	}
+
+	template<typename T>
+	PoolStorage<T>::PoolStorage ( PoolStorage &&x )
+	:
+	val_(std::move(x.val_)),
+	sz_(x.sz_),
+	len_(x.len_),
+	dx_(x.dx_)
+	{
+		x.sz_ = 0;
+		x.len_ = 0;
+		x.dx_ = nullptr;
+	}
+
+	template<typename T>
+	PoolStorage<T>::~PoolStorage ()
+	{
+		if ( len_>0 )
+			ThreadLocalPool<T>::deallocate(dx_, len_);
+	}
+
+	template<typename T>
+	PoolStorage<T> &PoolStorage<T>::operator= ( const PoolStorage &x )
+	{
+		if ( this!=&x )
+		{
+			// Only exchange the block if it is too short
+			 if ( x.sz_>len_ )
+			 {
+				if ( len_>0 )
+					ThreadLocalPool<T>::deallocate(dx_, len_);
+				len_ = x.sz_;
+				dx_ = ThreadLocalPool<T>::allocate(len_);
+			 }
+			sz_ = x.sz_;
+			std::copy( x.dx_, x.dx_+sz_, dx_ );
+			val_ = x.val_;
+		}
+		return *this;
+	}
+
+	template<typename T>
+	PoolStorage<T> &PoolStorage<T>::operator= ( PoolStorage &&x )
+	{
+		if ( this!=&x )
+		{
+			std::swap( sz_, x.sz_ );
+			std::swap( len_, x.len_ );
+			std::swap( dx_, x.dx_ );
+			val_ = std::move(x.val_);
+		}
+		return *this;
+	}
+
+	template<typename T>
+	void PoolStorage<T>::resize ( int sz )
+	{
+		if ( sz>len_ )
+		{
+			if ( len_>0 )
+				ThreadLocalPool<T>::deallocate(dx_, len_);
+			dx_ = get_and_fill(sz);
+			len_ = sz;
+		}
+		sz_ = sz;
+	}
+
+	template<typename T>
+	void PoolStorage<T>::resizeAndZero ( int sz )
+	{
+		if ( sz>len_ )
+		{
+			if ( len_>0 )
+				ThreadLocalPool<T>::deallocate(dx_, len_);
+			dx_ = get_and_fill(sz);
+			len_ = sz;
+		}
+		else if ( sz>sz_ )
+			std::fill( dx_+sz_, dx_+sz, T(0.) );
+		sz_ = sz;
+	}
+
+	template<typename T>
+	void PoolStorage<T>::expand ( int sz )
+	{
+		if ( sz>len_ )
+		{
+			T *dx_new = get_and_fill(sz);
+			std::copy( dx_, dx_+sz_, dx_new );
+			if ( len_>0 )
+				ThreadLocalPool<T>::deallocate(dx_, len_);
+			dx_ = dx_new;
+			len_ = sz;
+		}
+		else if ( sz>sz_ )
+			std::fill( dx_+sz_, dx_+sz, T(0.) );
+		sz_ = sz;
+	}
+
+
+	namespace internal
+	{
+		/*
+		 * Thread-local pools: reserve blocks of the total number of dofs in the pool of the calling thread
+		 * (for the nested data type the pools of both levels)
+		 */
+		 template<typename T>
+		 struct pool_selector< PoolFad<T> >
+		 {
+			static void select ( const unsigned int nbr_total_dofs )
+			{
+				ThreadLocalPool<T>::reserve( nbr_total_dofs, n_pool_blocks );
+				pool_selector<T>::select( nbr_total_dofs );
+			}
+		 };
+
+		/*
+		 * Sacado's memory pool: activate the pool of the MemPoolManager for the total number of dofs as the default pool of DMFad
+		 * @note The default pool is a static member of DMFad and thus shared by all threads. The pools are owned by the
+		 * calling thread, and calls from a second thread throw, so use DMFad only for single-threaded runs (PoolFad otherwise).
+		 */
+		 template<typename T>
+		 struct pool_selector< Sacado::Fad::DMFad<T> >
+		 {
+			static void select ( const unsigned int nbr_total_dofs )
+			{
+				static const std::thread::id owner = std::this_thread::get_id();
+				AssertThrow( std::this_thread::get_id()==owner,
+							 dealii::ExcMessage("The memory pool of DMFad is shared by all threads, use PoolFad with several threads.") );
+
+				thread_local Sacado::Fad::MemPoolManager<T> pool_manager (n_pool_blocks);
+				thread_local unsigned int active_pool_size = 0;
+
+				if ( nbr_total_dofs!=active_pool_size )
+				{
+					Sacado::Fad::DMFad<T>::setDefaultPool( pool_manager.getMemoryPool(nbr_total_dofs) );
+					active_pool_size = nbr_total_dofs;
+				}
+				pool_selector<T>::select( nbr_total_dofs );
+			}
+		 };
+	}
+}
+
+
+/*
+ * deal.II traits, such that PoolFad can be used as the number type of SymmetricTensor (as the Sacado::Fad::DFad):
+ * EnableIfScalar for the products with scalars, numbers::NumberTraits for the norm and internal::NumberType for
+ * the constants and the Sacado expressions assigned to the entries (e.g. in trace and unit_symmetric_tensor)
+ */
+namespace dealii
+{
+	template<typename T>
+	struct EnableIfScalar< Sacado_Wrapper::PoolFad<T> >
+	{
+		typedef Sacado_Wrapper::PoolFad<T> type;
+	};
+
+	namespace numbers
+	{
+		template<typename T>
+		struct NumberTraits< Sacado_Wrapper::PoolFad<T> >
+		{
+			static const bool is_complex = false;
+			typedef Sacado_Wrapper::PoolFad<T> real_type;
+
+			static const Sacado_Wrapper::PoolFad<T> &conjugate ( const Sacado_Wrapper::PoolFad<T> &x ) { return x; }
+			static real_type abs_square ( const Sacado_Wrapper::PoolFad<T> &x ) { return x*x; }
+			static real_type abs ( const Sacado_Wrapper::PoolFad<T> &x )
+			{
+				using std::abs;
+				return abs(x);
+			}
+		};
+	}
+
+	namespace internal
+	{
+		template<typename T>
+		struct NumberType< Sacado_Wrapper::PoolFad<T> >
+		{
+			static const Sacado_Wrapper::PoolFad<T> &value ( const Sacado_Wrapper::PoolFad<T> &t ) { return t; }
+
+			// Constants and Sacado expressions
+			 template<typename T2>
+			 static Sacado_Wrapper::PoolFad<T> value ( const T2 &t ) { return Sacado_Wrapper::PoolFad<T>(t); }
+		};
+	}
+}
+
+#endif // Sacado_memory_pool_H
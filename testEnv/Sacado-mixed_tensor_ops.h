@@ -0,0 +1,232 @@
+#ifndef Sacado_mixed_tensor_ops_H
+#define Sacado_mixed_tensor_ops_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <type_traits>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Operations between constant tensors of double and tensors of Sacado data types
+ *
+ * The deal.II operators only combine tensors with the same number type, so the examples build e.g. the unit tensor and the
+ * deviatoric fourth-order tensor from Sacado data types and even declare the constant \a kappa as fad_double:
+ * @code
+ * 	SymmetricTensor<2,dim,fad_double> stdTensor_I (( unit_symmetric_tensor<dim,fad_double>()) );
+ * 	sigma = kappa * (trace(eps) * stdTensor_I);
+ * @endcode
+ * Then every constant carries (and multiplies) an empty or zero derivative array, for the deviatoric tensor in 3D 81 of
+ * them. The functions below take the constants as double, so only the entries of the Sacado tensors carry derivatives:
+ * @code
+ * 	const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+ * 	sigma = Sacado_Wrapper::scale( kappa*trace(eps), I ) + Sacado_Wrapper::scale( 2.*mu, deviator(eps) );
+ * 	// or with the constant tangent C = kappa I x I + 2 mu I^dev
+ * 	sigma = Sacado_Wrapper::double_contract( C, eps );
+ * @endcode
+ * The loops run over the independent components only (with the factor 2 for the off-diagonal components in the
+ * contractions) and skip the zero entries of the constant tensors, e.g. the off-diagonal entries of the unit tensor.
+ * @note Call the functions qualified (Sacado_Wrapper::...), because the deal.II functions with the same names are
+ * templates for equal number types and would also be found by the argument-dependent lookup.
+ */
+namespace Sacado_Wrapper
+{
+	namespace internal
+	{
+		// The factor of the dof \a x in a double contraction over the independent components (2 for the off-diagonals)
+		 template<int dim>
+		 constexpr double contraction_weight ( const unsigned int x )
+		 {
+			return (index_i<dim>(x)==index_j<dim>(x)) ? 1. : 2.;
+		 }
+
+		/*
+		 * The Sacado data type of the scalar \a Scalar, which may also be an expression template (e.g. kappa*trace(eps)),
+		 * whose result is stored as the underlying Fad type. Only defined for Sacado data types, so double falls back to
+		 * the other overloads.
+		 */
+		 template<typename Scalar>
+		 using fad_type_of = typename std::enable_if< Sacado::IsADType<Scalar>::value, typename Sacado::BaseExprType<Scalar>::type >::type;
+	}
+
+
+	/*
+	 * Scaling of a constant tensor \a B with a Sacado scalar \a a, e.g. trace(eps)*I
+	 */
+	template<int dim, typename Scalar>
+	SymmetricTensor<2,dim,internal::fad_type_of<Scalar> > scale ( const Scalar &a, const SymmetricTensor<2,dim> &B )
+	{
+		typedef internal::fad_type_of<Scalar> Number;
+
+		// Binds to a Fad type directly, an expression template is evaluated once into a temporary
+		 const Number &a_fad = a;
+
+		SymmetricTensor<2,dim,Number> tmp;
+		for ( unsigned int x=0; x<SymmetricTensor<2,dim>::n_independent_components; ++x )
+		{
+			const double B_x = B[index_i<dim>(x)][index_j<dim>(x)];
+			if ( B_x!=0. )
+				tmp[index_i<dim>(x)][index_j<dim>(x)] = B_x * a_fad;
+		}
+		return tmp;
+	}
+
+	/*
+	 * Scaling of a Sacado tensor \a A with a constant \a a, without converting \a a to the Sacado data type
+	 */
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim,Number> scale ( const double a, const SymmetricTensor<2,dim,Number> &A )
+	{
+		SymmetricTensor<2,dim,Number> tmp;
+		for ( unsigned int x=0; x<SymmetricTensor<2,dim>::n_independent_components; ++x )
+			tmp[index_i<dim>(x)][index_j<dim>(x)] = a * A[index_i<dim>(x)][index_j<dim>(x)];
+		return tmp;
+	}
+
+
+	/*
+	 * Sum of a Sacado tensor \a A and a constant tensor \a B (only the values of \a A change)
+	 */
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim,Number> add ( const SymmetricTensor<2,dim,Number> &A, const SymmetricTensor<2,dim> &B )
+	{
+		SymmetricTensor<2,dim,Number> tmp (A);
+		for ( unsigned int x=0; x<SymmetricTensor<2,dim>::n_independent_components; ++x )
+			tmp[index_i<dim>(x)][index_j<dim>(x)] += B[index_i<dim>(x)][index_j<dim>(x)];
+		return tmp;
+	}
+
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim,Number> add ( const SymmetricTensor<2,dim> &B, const SymmetricTensor<2,dim,Number> &A )
+	{
+		return add( A, B );
+	}
+
+	// Difference \a A - \a B of a Sacado tensor \a A and a constant tensor \a B
+	 template<int dim, typename Number>
+	 SymmetricTensor<2,dim,Number> subtract ( const SymmetricTensor<2,dim,Number> &A, const SymmetricTensor<2,dim> &B )
+	 {
+		SymmetricTensor<2,dim,Number> tmp (A);
+		for ( unsigned int x=0; x<SymmetricTensor<2,dim>::n_independent_components; ++x )
+			tmp[index_i<dim>(x)][index_j<dim>(x)] -= B[index_i<dim>(x)][index_j<dim>(x)];
+		return tmp;
+	 }
+
+	// Difference \a B - \a A of a constant tensor \a B and a Sacado tensor \a A
+	 template<int dim, typename Number>
+	 SymmetricTensor<2,dim,Number> subtract ( const SymmetricTensor<2,dim> &B, const SymmetricTensor<2,dim,Number> &A )
+	 {
+		SymmetricTensor<2,dim,Number> tmp;
+		for ( unsigned int x=0; x<SymmetricTensor<2,dim>::n_independent_components; ++x )
+			tmp[index_i<dim>(x)][index_j<dim>(x)] = B[index_i<dim>(x)][index_j<dim>(x)] - A[index_i<dim>(x)][index_j<dim>(x)];
+		return tmp;
+	 }
+
+
+	/*
+	 * Double contraction \a A : \a B = A_ij * B_ij of a constant tensor \a A and a Sacado tensor \a B
+	 */
+	template<int dim, typename Number>
+	Number scalar_product ( const SymmetricTensor<2,dim> &A, const SymmetricTensor<2,dim,Number> &B )
+	{
+		Number tmp = 0.;
+		for ( unsigned int x=0; x<SymmetricTensor<2,dim>::n_independent_components; ++x )
+		{
+			const double A_x = internal::contraction_weight<dim>(x) * A[index_i<dim>(x)][index_j<dim>(x)];
+			if ( A_x!=0. )
+				tmp += A_x * B[index_i<dim>(x)][index_j<dim>(x)];
+		}
+		return tmp;
+	}
+
+	template<int dim, typename Number>
+	Number scalar_product ( const SymmetricTensor<2,dim,Number> &B, const SymmetricTensor<2,dim> &A )
+	{
+		return scalar_product( A, B );
+	}
+
+
+	/*
+	 * Double contraction \a C : \a eps = C_ijkl * eps_kl of a constant fourth-order tensor \a C (e.g. an elasticity tensor)
+	 * and a Sacado tensor \a eps
+	 */
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim,Number> double_contract ( const SymmetricTensor<4,dim> &C, const SymmetricTensor<2,dim,Number> &eps )
+	{
+		const unsigned int n_dofs = SymmetricTensor<2,dim>::n_independent_components;
+
+		SymmetricTensor<2,dim,Number> tmp;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+		{
+			Number &tmp_y = tmp[index_i<dim>(y)][index_j<dim>(y)];
+			for ( unsigned int x=0; x<n_dofs; ++x )
+			{
+				const double C_yx = internal::contraction_weight<dim>(x) * C[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)];
+				if ( C_yx!=0. )
+					tmp_y += C_yx * eps[index_i<dim>(x)][index_j<dim>(x)];
+			}
+		}
+		return tmp;
+	}
+
+	// Double contraction \a eps : \a C = eps_ij * C_ijkl
+	 template<int dim, typename Number>
+	 SymmetricTensor<2,dim,Number> double_contract ( const SymmetricTensor<2,dim,Number> &eps, const SymmetricTensor<4,dim> &C )
+	 {
+		const unsigned int n_dofs = SymmetricTensor<2,dim>::n_independent_components;
+
+		SymmetricTensor<2,dim,Number> tmp;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+		{
+			Number &tmp_y = tmp[index_i<dim>(y)][index_j<dim>(y)];
+			for ( unsigned int x=0; x<n_dofs; ++x )
+			{
+				const double C_xy = internal::contraction_weight<dim>(x) * C[index_i<dim>(x)][index_j<dim>(x)][index_i<dim>(y)][index_j<dim>(y)];
+				if ( C_xy!=0. )
+					tmp_y += C_xy * eps[index_i<dim>(x)][index_j<dim>(x)];
+			}
+		}
+		return tmp;
+	 }
+
+
+	/*
+	 * Outer product \a A x \a B = A_ij * B_kl of a constant tensor \a A and a Sacado tensor \a B (and vice versa)
+	 */
+	template<int dim, typename Number>
+	SymmetricTensor<4,dim,Number> outer_product ( const SymmetricTensor<2,dim> &A, const SymmetricTensor<2,dim,Number> &B )
+	{
+		const unsigned int n_dofs = SymmetricTensor<2,dim>::n_independent_components;
+
+		SymmetricTensor<4,dim,Number> tmp;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+		{
+			const double A_y = A[index_i<dim>(y)][index_j<dim>(y)];
+			if ( A_y!=0. )
+				for ( unsigned int x=0; x<n_dofs; ++x )
+					tmp[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = A_y * B[index_i<dim>(x)][index_j<dim>(x)];
+		}
+		return tmp;
+	}
+
+	template<int dim, typename Number>
+	SymmetricTensor<4,dim,Number> outer_product ( const SymmetricTensor<2,dim,Number> &B, const SymmetricTensor<2,dim> &A )
+	{
+		const unsigned int n_dofs = SymmetricTensor<2,dim>::n_independent_components;
+
+		SymmetricTensor<4,dim,Number> tmp;
+		for ( unsigned int x=0; x<n_dofs; ++x )
+		{
+			const double A_x = A[index_i<dim>(x)][index_j<dim>(x)];
+			if ( A_x!=0. )
+				for ( unsigned int y=0; y<n_dofs; ++y )
+					tmp[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = B[index_i<dim>(y)][index_j<dim>(y)] * A_x;
+		}
+		return tmp;
+	}
+}
+
+#endif // Sacado_mixed_tensor_ops_H
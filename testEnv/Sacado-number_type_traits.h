@@ -0,0 +1,113 @@
+#ifndef Sacado_number_type_traits_H
+#define Sacado_number_type_traits_H
+
+/*
+ * Elementary functions of the number types of the wrapper in the namespace std
+ *
+ * deal.II calls e.g. std::sqrt in SymmetricTensor::norm and Tensor::norm with the namespace written out. Such a qualified
+ * call is bound where the deal.II template is defined, so argument-dependent lookup does not find Sacado_Wrapper::sqrt
+ * and only the overloads that are already declared in std are candidates (Sacado adds its overloads to std as well).
+ * The macro declares the elementary functions of the class template \a Type<N> in the namespace Sacado_Wrapper and
+ * imports them into std:
+ * @code
+ * 	SACADO_WRAPPER_STD_FUNCTIONS(HyperDual)
+ * @endcode
+ * @note Expand the macro in the global namespace and before any deal.II header is included, i.e. include the headers
+ * of these number types (Sacado-hyper_dual.h, Sacado-padded_fad.h) before the deal.II headers.
+ */
+#define SACADO_WRAPPER_STD_FUNCTIONS(Type) \
+namespace Sacado_Wrapper \
+{ \
+	template<unsigned int N> class Type; \
+ \
+	template<unsigned int N> inline Type<N> sqrt ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> cbrt ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> exp ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> log ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> log10 ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> pow ( const Type<N> &a, const double b ); \
+	template<unsigned int N> inline Type<N> pow ( const Type<N> &a, const Type<N> &b ); \
+	template<unsigned int N> inline Type<N> pow ( const double a, const Type<N> &b ); \
+	template<unsigned int N> inline Type<N> sin ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> cos ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> tan ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> atan ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> sinh ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> cosh ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> tanh ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> abs ( const Type<N> &a ); \
+	template<unsigned int N> inline Type<N> fabs ( const Type<N> &a ); \
+} \
+ \
+namespace std \
+{ \
+	using Sacado_Wrapper::sqrt; \
+	using Sacado_Wrapper::cbrt; \
+	using Sacado_Wrapper::exp; \
+	using Sacado_Wrapper::log; \
+	using Sacado_Wrapper::log10; \
+	using Sacado_Wrapper::pow; \
+	using Sacado_Wrapper::sin; \
+	using Sacado_Wrapper::cos; \
+	using Sacado_Wrapper::tan; \
+	using Sacado_Wrapper::atan; \
+	using Sacado_Wrapper::sinh; \
+	using Sacado_Wrapper::cosh; \
+	using Sacado_Wrapper::tanh; \
+	using Sacado_Wrapper::abs; \
+	using Sacado_Wrapper::fabs; \
+}
+
+
+/*
+ * deal.II traits for the number types of the wrapper that are no Sacado data types (HyperDual<N>, PaddedFad<N>)
+ *
+ * deal.II knows the Sacado data types, but a SymmetricTensor or Tensor of any other number type additionally needs
+ * - EnableIfScalar (multiplication and division with scalars)
+ * - numbers::NumberTraits (e.g. abs_square in the norm)
+ * - internal::NumberType (e.g. the constants in the constructors and unit_symmetric_tensor)
+ * The macro specialises all three for the class template \a Type<N> in the namespace Sacado_Wrapper, which must
+ * provide the arithmetic operators and the function abs:
+ * @code
+ * 	SACADO_WRAPPER_DEAL_II_NUMBER_TRAITS(HyperDual)
+ * @endcode
+ * @note Expand the macro in the global namespace after the deal.II headers numbers.h and template_constraints.h.
+ */
+#define SACADO_WRAPPER_DEAL_II_NUMBER_TRAITS(Type) \
+namespace dealii \
+{ \
+	template<unsigned int N> \
+	struct EnableIfScalar< Sacado_Wrapper::Type<N> > \
+	{ \
+		typedef Sacado_Wrapper::Type<N> type; \
+	}; \
+ \
+	namespace numbers \
+	{ \
+		template<unsigned int N> \
+		struct NumberTraits< Sacado_Wrapper::Type<N> > \
+		{ \
+			static const bool is_complex = false; \
+			typedef Sacado_Wrapper::Type<N> real_type; \
+ \
+			static const Sacado_Wrapper::Type<N> &conjugate ( const Sacado_Wrapper::Type<N> &x ) { return x; } \
+			static real_type abs_square ( const Sacado_Wrapper::Type<N> &x ) { return x*x; } \
+			static real_type abs ( const Sacado_Wrapper::Type<N> &x ) { return Sacado_Wrapper::abs(x); } \
+		}; \
+	} \
+ \
+	namespace internal \
+	{ \
+		template<unsigned int N> \
+		struct NumberType< Sacado_Wrapper::Type<N> > \
+		{ \
+			static const Sacado_Wrapper::Type<N> &value ( const Sacado_Wrapper::Type<N> &t ) { return t; } \
+ \
+			/* Constants (e.g. the zero in the constructors of the tensors) without derivatives */ \
+			template<typename T> \
+			static Sacado_Wrapper::Type<N> value ( const T &t ) { return Sacado_Wrapper::Type<N>(t); } \
+		}; \
+	} \
+}
+
+#endif // Sacado_number_type_traits_H
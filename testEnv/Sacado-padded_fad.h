@@ -0,0 +1,436 @@
+#ifndef Sacado_padded_fad_H
+#define Sacado_padded_fad_H
+
+// The elementary functions must be declared in std before the deal.II templates (see Sacado-number_type_traits.h)
+#include "Sacado-number_type_traits.h"
+SACADO_WRAPPER_STD_FUNCTIONS(PaddedFad)
+
+// VectorizedArray: a short vector of doubles with the arithmetic operations as SIMD instructions
+#include <deal.II/base/vectorization.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <iostream>
+#include <cmath>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * A first-order forward AD number type with the derivative array padded to the SIMD width and aligned to 64 bytes.
+ *
+ * The typical numbers of dofs of the wrapper (3/4 in 2D, 6/7 in 3D for the strain and a scalar) do not fit the SIMD
+ * width (4 doubles with AVX2, 8 with AVX-512), so the loops over the derivatives inside the Sacado data types end with
+ * scalar remainders. The PaddedFad<N> stores the N derivatives in an array of \a n_padded doubles (N rounded up to the
+ * SIMD width), where the padding is always zero. Every operation (+, -, *, / and the chain rule of the elementary
+ * functions) processes the whole array with VectorizedArray<double> kernels without remainder loops, e.g. for N=7 and
+ * AVX2 the derivatives of a product are computed with 2 SIMD instructions instead of 7 scalar ones.
+ *
+ * The interface is the one of Sacado's Fad types that the first-order wrapper uses (\a val(), \a dx(i), \a fastAccessDx(i),
+ * \a diff(i,n)), so it can be used directly as the data type of SymTensor, SW_double and DoFs_summary:
+ * @code
+ * 	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+ * 	Sacado_Wrapper::SymTensor_padded<dim,N> eps;
+ * 	Sacado_Wrapper::SW_double_padded<dim,N> phi;
+ * 	Sacado_Wrapper::DoFs_summary_padded<dim,N> DoFs_summary;
+ * @endcode
+ * @note Works with deal.II 9.1 and newer, since only load, store and the arithmetic of VectorizedArray<double> are used.
+ * @note The type is over-aligned (alignas(64)). In containers such as std::vector use C++17 (aligned new) or
+ * deal.II's AlignedVector.
+ * @note Include this header before the deal.II headers, otherwise deal.II's std::sqrt (e.g. in eps.norm()) does not find
+ * the overload for PaddedFad<N> (see Sacado-number_type_traits.h).
+ */
+namespace Sacado_Wrapper
+{
+	template<unsigned int N>
+	class alignas(64) PaddedFad
+	{
+	  public:
+		typedef double value_type;
+
+		// SIMD width and the number of derivatives rounded up to it
+		 static const unsigned int width = internal::simd_width;
+		 static const unsigned int n_padded = ( (N+width-1)/width ) * width;
+
+		PaddedFad ( const double value=0. );
+
+		// Constructor similar to Sacado's Fad(n,i,x): the value \a x is the i-th of the N independent variables
+		 PaddedFad ( const unsigned int n, const unsigned int i, const double x );
+
+		PaddedFad<N> &operator= ( const double value );
+
+		// Declare this number as the i-th independent variable (the derivatives are reset)
+		 void diff ( const unsigned int i, const unsigned int n=N );
+
+		unsigned int size () const { return N; }
+
+		const double &val () const { return v; }
+		double &val () { return v; }
+
+		const double &dx ( const unsigned int i ) const { return dx_[i]; }
+		double &dx ( const unsigned int i ) { return dx_[i]; }
+		const double &fastAccessDx ( const unsigned int i ) const { return dx_[i]; }
+		double &fastAccessDx ( const unsigned int i ) { return dx_[i]; }
+
+		/*
+		 * Chain rule for an elementary function f of this number: returns f(this) given the
+		 * value f0=f(v) and the derivative f1=f'(v), i.e. d_f/d_x_i = f' * dx_i
+		 */
+		 PaddedFad<N> chain ( const double f0, const double f1 ) const;
+
+		PaddedFad<N> &operator+= ( const PaddedFad<N> &b );
+		PaddedFad<N> &operator-= ( const PaddedFad<N> &b );
+		PaddedFad<N> &operator*= ( const PaddedFad<N> &b );
+		PaddedFad<N> &operator/= ( const PaddedFad<N> &b );
+		PaddedFad<N> &operator+= ( const double b ) { v += b; return *this; }
+		PaddedFad<N> &operator-= ( const double b ) { v -= b; return *this; }
+		PaddedFad<N> &operator*= ( const double b );
+		PaddedFad<N> &operator/= ( const double b ) { return (*this) *= (1./b); }
+
+	  private:
+		// The derivative array first, such that it starts at the 64-byte boundary of the object
+		 double dx_[n_padded];
+		 double v;
+
+		// SIMD kernel for this->dx = a * this->dx + b * other.dx over the whole padded array
+		 void axpby ( const double a, const double b, const double *other_dx );
+	};
+
+
+	template<unsigned int N>
+	PaddedFad<N>::PaddedFad ( const double value )
+	:
+	v(value)
+	{
+		for ( unsigned int i=0; i<n_padded; ++i )
+			dx_[i] = 0.;
+	}
+
+
+	template<unsigned int N>
+	PaddedFad<N>::PaddedFad ( const unsigned int n, const unsigned int i, const double x )
+	:
+	PaddedFad(x)
+	{
+		diff(i,n);
+	}
+
+
+	template<unsigned int N>
+	PaddedFad<N> &PaddedFad<N>::operator= ( const double value )
+	{
+		v = value;
+		for ( unsigned int i=0; i<n_padded; ++i )
+			dx_[i] = 0.;
+		return *this;
+	}
+
+
+	template<unsigned int N>
+	void PaddedFad<N>::diff ( const unsigned int i, const unsigned int n )
+	{
+		Assert( n<=N, ExcMessage("PaddedFad<N>: The total number of dofs exceeds N.") );
+		(void)n;
+		for ( unsigned int k=0; k<n_padded; ++k )
+			dx_[k] = 0.;
+		dx_[i] = 1.;
+	}
+
+
+	template<unsigned int N>
+	inline void PaddedFad<N>::axpby ( const double a, const double b, const double *other_dx )
+	{
+		for ( unsigned int k=0; k<n_padded; k+=width )
+		{
+			VectorizedArray<double> this_k, other_k;
+			this_k.load( dx_+k );
+			other_k.load( other_dx+k );
+			this_k = a * this_k + b * other_k;
+			this_k.store( dx_+k );
+		}
+	}
+
+
+	template<unsigned int N>
+	PaddedFad<N> PaddedFad<N>::chain ( const double f0, const double f1 ) const
+	{
+		PaddedFad<N> result;
+		result.v = f0;
+		for ( unsigned int k=0; k<n_padded; k+=width )
+		{
+			VectorizedArray<double> dx_k;
+			dx_k.load( dx_+k );
+			dx_k = f1 * dx_k;
+			dx_k.store( result.dx_+k );
+		}
+		return result;
+	}
+
+
+	template<unsigned int N>
+	PaddedFad<N> &PaddedFad<N>::operator+= ( const PaddedFad<N> &b )
+	{
+		v += b.v;
+		for ( unsigned int k=0; k<n_padded; k+=width )
+		{
+			VectorizedArray<double> a_k, b_k;
+			a_k.load( dx_+k );
+			b_k.load( b.dx_+k );
+			a_k += b_k;
+			a_k.store( dx_+k );
+		}
+		return *this;
+	}
+
+
+	template<unsigned int N>
+	PaddedFad<N> &PaddedFad<N>::operator-= ( const PaddedFad<N> &b )
+	{
+		v -= b.v;
+		for ( unsigned int k=0; k<n_padded; k+=width )
+		{
+			VectorizedArray<double> a_k, b_k;
+			a_k.load( dx_+k );
+			b_k.load( b.dx_+k );
+			a_k -= b_k;
+			a_k.store( dx_+k );
+		}
+		return *this;
+	}
+
+
+	// Product rule: d(a*b) = b * da + a * db
+	template<unsigned int N>
+	PaddedFad<N> &PaddedFad<N>::operator*= ( const PaddedFad<N> &b )
+	{
+		(*this).axpby( b.v, v, b.dx_ );
+		v *= b.v;
+		return *this;
+	}
+
+
+	// Quotient rule: d(a/b) = da/b - a/b² * db
+	template<unsigned int N>
+	PaddedFad<N> &PaddedFad<N>::operator/= ( const PaddedFad<N> &b )
+	{
+		const double inv_b = 1./b.v;
+		(*this).axpby( inv_b, -v*inv_b*inv_b, b.dx_ );
+		v *= inv_b;
+		return *this;
+	}
+
+
+	template<unsigned int N>
+	PaddedFad<N> &PaddedFad<N>::operator*= ( const double b )
+	{
+		v *= b;
+		for ( unsigned int k=0; k<n_padded; k+=width )
+		{
+			VectorizedArray<double> a_k;
+			a_k.load( dx_+k );
+			a_k = b * a_k;
+			a_k.store( dx_+k );
+		}
+		return *this;
+	}
+
+
+	// Arithmetic operators for all combinations of PaddedFad and double
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator- ( const PaddedFad<N> &a ) { PaddedFad<N> r(a); return r *= -1.; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator+ ( const PaddedFad<N> &a ) { return a; }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator+ ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { PaddedFad<N> r(a); return r += b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator+ ( const PaddedFad<N> &a, const double b ) { PaddedFad<N> r(a); return r += b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator+ ( const double a, const PaddedFad<N> &b ) { PaddedFad<N> r(b); return r += a; }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator- ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { PaddedFad<N> r(a); return r -= b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator- ( const PaddedFad<N> &a, const double b ) { PaddedFad<N> r(a); return r -= b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator- ( const double a, const PaddedFad<N> &b ) { PaddedFad<N> r(-b); return r += a; }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator* ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { PaddedFad<N> r(a); return r *= b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator* ( const PaddedFad<N> &a, const double b ) { PaddedFad<N> r(a); return r *= b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator* ( const double a, const PaddedFad<N> &b ) { PaddedFad<N> r(b); return r *= a; }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator/ ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { PaddedFad<N> r(a); return r /= b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator/ ( const PaddedFad<N> &a, const double b ) { PaddedFad<N> r(a); return r /= b; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> operator/ ( const double a, const PaddedFad<N> &b ) { const double inv_b = 1./b.val(); return b.chain( a*inv_b, -a*inv_b*inv_b ); }
+
+
+	// Comparisons (of the values, as for the Sacado data types)
+	 #define PADDED_FAD_COMPARISON(OP) \
+	 template<unsigned int N> \
+	 inline bool operator OP ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { return a.val() OP b.val(); } \
+	 template<unsigned int N> \
+	 inline bool operator OP ( const PaddedFad<N> &a, const double b ) { return a.val() OP b; } \
+	 template<unsigned int N> \
+	 inline bool operator OP ( const double a, const PaddedFad<N> &b ) { return a OP b.val(); }
+
+	 PADDED_FAD_COMPARISON(==)
+	 PADDED_FAD_COMPARISON(!=)
+	 PADDED_FAD_COMPARISON(<)
+	 PADDED_FAD_COMPARISON(>)
+	 PADDED_FAD_COMPARISON(<=)
+	 PADDED_FAD_COMPARISON(>=)
+	 #undef PADDED_FAD_COMPARISON
+
+
+	// Elementary functions via PaddedFad::chain with the first derivative of the function (also declared in std, see HyperDual)
+	 template<unsigned int N>
+	 inline PaddedFad<N> sqrt ( const PaddedFad<N> &a )
+	 {
+		const double f0 = std::sqrt(a.val());
+		return a.chain( f0, 0.5/f0 );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> cbrt ( const PaddedFad<N> &a )
+	 {
+		const double f0 = std::cbrt(a.val());
+		return a.chain( f0, f0/(3.*a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> exp ( const PaddedFad<N> &a )
+	 {
+		const double f0 = std::exp(a.val());
+		return a.chain( f0, f0 );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> log ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::log(a.val()), 1./a.val() );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> log10 ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::log10(a.val()), 1./(a.val()*std::log(10.)) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> pow ( const PaddedFad<N> &a, const double b )
+	 {
+		return a.chain( std::pow(a.val(),b), b*std::pow(a.val(),b-1.) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> pow ( const PaddedFad<N> &a, const PaddedFad<N> &b )
+	 {
+		return exp( b * log(a) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> pow ( const double a, const PaddedFad<N> &b )
+	 {
+		return exp( std::log(a) * b );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> sin ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::sin(a.val()), std::cos(a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> cos ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::cos(a.val()), -std::sin(a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> tan ( const PaddedFad<N> &a )
+	 {
+		const double tan_a = std::tan(a.val());
+		return a.chain( tan_a, 1.+tan_a*tan_a );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> atan ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::atan(a.val()), 1./(1.+a.val()*a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> sinh ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::sinh(a.val()), std::cosh(a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> cosh ( const PaddedFad<N> &a )
+	 {
+		return a.chain( std::cosh(a.val()), std::sinh(a.val()) );
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> tanh ( const PaddedFad<N> &a )
+	 {
+		const double tanh_a = std::tanh(a.val());
+		return a.chain( tanh_a, 1.-tanh_a*tanh_a );
+	 }
+
+	 // The kink at zero is treated as for the Sacado data types (derivative of the positive branch)
+	 template<unsigned int N>
+	 inline PaddedFad<N> abs ( const PaddedFad<N> &a )
+	 {
+		return ( a.val()<0. ) ? -a : a;
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> fabs ( const PaddedFad<N> &a )
+	 {
+		return abs(a);
+	 }
+
+	 template<unsigned int N>
+	 inline PaddedFad<N> max ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { return ( a.val()<b.val() ) ? b : a; }
+	 template<unsigned int N>
+	 inline PaddedFad<N> min ( const PaddedFad<N> &a, const PaddedFad<N> &b ) { return ( b.val()<a.val() ) ? b : a; }
+
+
+	template<unsigned int N>
+	std::ostream &operator<< ( std::ostream &os, const PaddedFad<N> &a )
+	{
+		os << a.val() << " [";
+		for ( unsigned int i=0; i<N; ++i )
+			os << " " << a.dx(i);
+		return os << " ]";
+	}
+}
+
+
+// deal.II traits, such that PaddedFad<N> can be used as the number type of SymmetricTensor (see Sacado-number_type_traits.h)
+ SACADO_WRAPPER_DEAL_II_NUMBER_TRAITS(PaddedFad)
+
+
+namespace Sacado_Wrapper
+{
+	/*
+	 * First-order wrapper data types based on PaddedFad<N>, where N is the maximum number of dofs.
+	 * PaddedFad is first-order only, so the second-order data type of the DoFs_summary is PaddedFad<N> itself instead of
+	 * the default DFad<PaddedFad<N>>, whose heap-allocated derivative arrays would defeat the padding. Hence, the
+	 * second-order functions of DoFs_summary_padded do not compile.
+	 */
+	 template<int dim, unsigned int N>
+	 using SymTensor_padded = SymTensor<dim, PaddedFad<N> >;
+	 template<int dim, unsigned int N>
+	 using SW_double_padded = SW_double<dim, PaddedFad<N> >;
+	 template<int dim, unsigned int N>
+	 using DoFs_summary_padded = DoFs_summary<dim, PaddedFad<N>, PaddedFad<N> >;
+}
+
+#endif // Sacado_padded_fad_H
@@ -0,0 +1,279 @@
+#ifndef Sacado_qp_batch_H
+#define Sacado_qp_batch_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <vector>
+#include <algorithm>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Structure-of-arrays containers for the inputs and outputs of the wrapper at a block of quadrature points.
+ *
+ * A std::vector<SymmetricTensor<2,dim>> stores the quadrature points one after another (array of structures). The
+ * SymTensorBatch instead stores the independent components "component-major": All n_qps values of the dof x=0 (the
+ * (0,0) component), then all values of the dof x=1 (the (0,1) component) and so on (same dof order as the wrapper).
+ * Hence, the values of consecutive quadrature points are contiguous in memory, which is the layout needed to stream
+ * them from the quadrature point history and to load them into the lanes of SIMD data types.
+ * @code
+ * 	Sacado_Wrapper::SymTensorBatch<dim> eps_batch(n_q_points), sigma_batch(n_q_points);
+ * 	Sacado_Wrapper::SymTangentBatch<dim> C_batch(n_q_points);
+ * 	eps_batch.init(eps_d);
+ *
+ * 	Sacado_Wrapper::SymTensor_vectorized<dim,N> eps;	// or any other first-order SymTensor
+ * 	for ( unsigned int qp=0; qp<n_q_points; qp+=Sacado_Wrapper::n_lanes )
+ * 	{
+ * 		eps_batch.set_dofs(eps, qp);
+ * 		SymmetricTensor<2,dim,Sacado_Wrapper::fad_vectorized<N> > sigma = stress_strain_relation(eps, kappa, mu);
+ * 		sigma_batch.get_value(sigma, qp);
+ * 		C_batch.get_tangent(eps, sigma, qp);
+ * 	}
+ * @endcode
+ * With a scalar Sacado data type (e.g. SFad<double,N>) the same loop runs with qp+=1.
+ */
+namespace Sacado_Wrapper
+{
+	template<int dim>
+	class SymTensorBatch
+	{
+	public:
+		static const unsigned int n_dofs = ((dim==2)?3:6);
+
+		SymTensorBatch ( const unsigned int n_qps=0 );
+
+		void reinit ( const unsigned int n_qps );
+
+		/*
+		 * Use the external memory \a external_values instead of an own copy (zero-copy, e.g. a block of a memory-mapped file),
+		 * where the values of the dof x start at external_values + x*stride. The memory must outlive the SymTensorBatch.
+		 */
+		 void reinit_view ( double *external_values, const unsigned int n_qps, const unsigned int stride );
+
+		bool is_view () const { return external_values!=nullptr; }
+
+		unsigned int size () const { return n_qps; }
+
+		// The contiguous values of the dof \a x at all quadrature points
+		 double *component ( const unsigned int x ) { return base() + x*stride; }
+		 const double *component ( const unsigned int x ) const { return base() + x*stride; }
+
+		// Copy from and to the deal.II tensors (array of structures), e.g. the quadrature point history
+		 void init ( const std::vector< SymmetricTensor<2,dim> > &tensors );
+		 void set ( const unsigned int qp, const SymmetricTensor<2,dim> &tensor );
+		 SymmetricTensor<2,dim> get ( const unsigned int qp ) const;
+
+		// Copy n_dofs*n_qps values that are already stored component-major (no reordering)
+		 void init ( const double *component_major_values );
+
+		/*
+		 * Set the values of the quadrature points qp, qp+1, ... (one per lane of the value type of \a Number, see
+		 * internal::lanes) as the dofs of \a eps. Lanes beyond the last quadrature point repeat its values.
+		 */
+		 template<typename Number>
+		 void set_dofs ( SymTensor<dim,Number> &eps, const unsigned int qp, const unsigned int nbr_total_dofs=n_dofs ) const;
+
+		// Store the values of \a sigma as the quadrature points qp, qp+1, ...
+		 template<typename Number>
+		 void get_value ( const SymmetricTensor<2,dim,Number> &sigma, const unsigned int qp );
+
+	private:
+		double *base () { return is_view() ? external_values : values.data(); }
+		const double *base () const { return is_view() ? external_values : values.data(); }
+
+		unsigned int n_qps;
+		unsigned int stride;	// distance between the components (n_qps for the own storage)
+		std::vector<double> values;
+		double *external_values = nullptr;
+	};
+
+
+	/*
+	 * Tangents d_sigma/d_eps at a block of quadrature points, stored component-major as SymTensorBatch with the
+	 * n_dofs x n_dofs components (y,x) = d_sigma[i(y)][j(y)] / d_eps[i(x)][j(x)] (including the factor 0.5 for
+	 * the off-diagonal dofs x, i.e. the components of the SymmetricTensor<4,dim>)
+	 */
+	template<int dim>
+	class SymTangentBatch
+	{
+	public:
+		static const unsigned int n_dofs = ((dim==2)?3:6);
+		static const unsigned int n_components = n_dofs*n_dofs;
+
+		SymTangentBatch ( const unsigned int n_qps=0 );
+
+		void reinit ( const unsigned int n_qps );
+
+		unsigned int size () const { return n_qps; }
+
+		double *component ( const unsigned int y, const unsigned int x ) { return values.data() + (y*n_dofs+x)*n_qps; }
+		const double *component ( const unsigned int y, const unsigned int x ) const { return values.data() + (y*n_dofs+x)*n_qps; }
+
+		void set ( const unsigned int qp, const SymmetricTensor<4,dim> &Tangent );
+		SymmetricTensor<4,dim> get ( const unsigned int qp ) const;
+
+		// Store the tangent d_sigma/d_eps of the quadrature points qp, qp+1, ... (see SymTensorBatch::set_dofs)
+		 template<typename Number>
+		 void get_tangent ( const SymTensor<dim,Number> &eps, const SymmetricTensor<2,dim,Number> &sigma, const unsigned int qp );
+
+	private:
+		unsigned int n_qps;
+		std::vector<double> values;
+	};
+
+
+	//###########################################################################################################//
+
+
+	template<int dim>
+	SymTensorBatch<dim>::SymTensorBatch ( const unsigned int n_qps )
+	:
+	n_qps(n_qps),
+	stride(n_qps),
+	values(n_dofs*n_qps)
+	{
+	}
+
+	template<int dim>
+	void SymTensorBatch<dim>::reinit ( const unsigned int n_qps_new )
+	{
+		n_qps = n_qps_new;
+		stride = n_qps;
+		values.resize(n_dofs*n_qps);
+		external_values = nullptr;
+	}
+
+	template<int dim>
+	void SymTensorBatch<dim>::reinit_view ( double *external_values_in, const unsigned int n_qps_new, const unsigned int stride_new )
+	{
+		Assert( stride_new>=n_qps_new, ExcMessage("SymTensorBatch::reinit_view: The stride must not be smaller than the number of quadrature points.") );
+		n_qps = n_qps_new;
+		stride = stride_new;
+		values.clear();
+		external_values = external_values_in;
+	}
+
+	template<int dim>
+	void SymTensorBatch<dim>::init ( const std::vector< SymmetricTensor<2,dim> > &tensors )
+	{
+		(*this).reinit( tensors.size() );
+		// Component by component, such that the writes are contiguous
+		 for ( unsigned int x=0; x<n_dofs; ++x )
+		 {
+			double *values_x = component(x);
+			for ( unsigned int qp=0; qp<n_qps; ++qp )
+				values_x[qp] = tensors[qp][index_i<dim>(x)][index_j<dim>(x)];
+		 }
+	}
+
+	template<int dim>
+	void SymTensorBatch<dim>::init ( const double *component_major_values )
+	{
+		for ( unsigned int x=0; x<n_dofs; ++x )
+			std::copy( component_major_values + x*n_qps, component_major_values + (x+1)*n_qps, component(x) );
+	}
+
+	template<int dim>
+	void SymTensorBatch<dim>::set ( const unsigned int qp, const SymmetricTensor<2,dim> &tensor )
+	{
+		for ( unsigned int x=0; x<n_dofs; ++x )
+			component(x)[qp] = tensor[index_i<dim>(x)][index_j<dim>(x)];
+	}
+
+	template<int dim>
+	SymmetricTensor<2,dim> SymTensorBatch<dim>::get ( const unsigned int qp ) const
+	{
+		SymmetricTensor<2,dim> tensor;
+		for ( unsigned int x=0; x<n_dofs; ++x )
+			tensor[index_i<dim>(x)][index_j<dim>(x)] = component(x)[qp];
+		return tensor;
+	}
+
+	template<int dim>
+	template<typename Number>
+	void SymTensorBatch<dim>::set_dofs ( SymTensor<dim,Number> &eps, const unsigned int qp, const unsigned int nbr_total_dofs ) const
+	{
+		typedef internal::lanes<typename Number::value_type> lanes;
+
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			const double *values_x = component(x);
+			Number &eps_x = eps[index_i<dim>(x)][index_j<dim>(x)];
+			for ( unsigned int lane=0; lane<lanes::n; ++lane )
+				lanes::at( eps_x.val(), lane ) = values_x[ std::min(qp+lane, n_qps-1) ];
+		});
+		eps.set_dofs( nbr_total_dofs );
+	}
+
+	template<int dim>
+	template<typename Number>
+	void SymTensorBatch<dim>::get_value ( const SymmetricTensor<2,dim,Number> &sigma, const unsigned int qp )
+	{
+		typedef internal::lanes<typename Number::value_type> lanes;
+		const unsigned int n_active_lanes = ( qp+lanes::n<=n_qps ) ? lanes::n : n_qps-qp;
+
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			double *values_x = component(x);
+			const Number &sigma_x = sigma[index_i<dim>(x)][index_j<dim>(x)];
+			for ( unsigned int lane=0; lane<n_active_lanes; ++lane )
+				values_x[qp+lane] = lanes::at( sigma_x.val(), lane );
+		});
+	}
+
+
+	template<int dim>
+	SymTangentBatch<dim>::SymTangentBatch ( const unsigned int n_qps )
+	:
+	n_qps(n_qps),
+	values(n_components*n_qps)
+	{
+	}
+
+	template<int dim>
+	void SymTangentBatch<dim>::reinit ( const unsigned int n_qps_new )
+	{
+		n_qps = n_qps_new;
+		values.resize(n_components*n_qps);
+	}
+
+	template<int dim>
+	void SymTangentBatch<dim>::set ( const unsigned int qp, const SymmetricTensor<4,dim> &Tangent )
+	{
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				component(y,x)[qp] = Tangent[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)];
+	}
+
+	template<int dim>
+	SymmetricTensor<4,dim> SymTangentBatch<dim>::get ( const unsigned int qp ) const
+	{
+		SymmetricTensor<4,dim> Tangent;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				Tangent[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = component(y,x)[qp];
+		return Tangent;
+	}
+
+	template<int dim>
+	template<typename Number>
+	void SymTangentBatch<dim>::get_tangent ( const SymTensor<dim,Number> &eps, const SymmetricTensor<2,dim,Number> &sigma, const unsigned int qp )
+	{
+		typedef internal::lanes<typename Number::value_type> lanes;
+		const unsigned int n_active_lanes = ( qp+lanes::n<=n_qps ) ? lanes::n : n_qps-qp;
+
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			const Number &sigma_y = sigma[index_i<dim>(y)][index_j<dim>(y)];
+
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+			{
+				double *values_yx = component(y,x);
+				for ( unsigned int lane=0; lane<n_active_lanes; ++lane )
+					values_yx[qp+lane] = voigt_scale<dim>(x) * lanes::at( sigma_y.fastAccessDx(eps.start_index+x), lane );
+			});
+		});
+	}
+}
+
+#endif // Sacado_qp_batch_H
@@ -0,0 +1,277 @@
+#ifndef Sacado_spectral_H
+#define Sacado_spectral_H
+
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/tensor.h>
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Derivatives of isotropic tensor functions from the spectral decomposition
+ *
+ * An isotropic tensor function of a symmetric tensor C with the eigenvalues lambda_a and the eigenvectors n_a, e.g. the
+ * logarithmic (Hencky) strain ln(C), is
+ * \f[ F(C) = \sum_a f(\lambda_a) \cdot n_a \otimes n_a \f]
+ * The example ln_space_AD.cc differentiates straight through eigenvectors() with the SymTensor and SymTensor2, so the whole
+ * eigenvalue iteration runs with Sacado data types and the derivatives of the eigenvectors are undefined for repeated
+ * eigenvalues. The SpectralTensorFunction instead decomposes C with double and computes the tangent dF/dC and the
+ * curvature d2F/dC2 from the Daleckii-Krein formulas with the divided differences of f:
+ * \f[ dF = \sum_{a,b} f[\lambda_a,\lambda_b] \cdot (n_a \cdot dC \cdot n_b) \cdot n_a \otimes n_b \qquad
+ * 	   d^2F = \sum_{a,b,c} f[\lambda_a,\lambda_c,\lambda_b] \cdot \left( (n_a \cdot dC \cdot n_c)(n_c \cdot dK \cdot n_b) + (n_a \cdot dK \cdot n_c)(n_c \cdot dC \cdot n_b) \right) \cdot n_a \otimes n_b \f]
+ * Only the scalar function f is differentiated: it is evaluated once per eigenvalue with a Sacado::Tay::Taylor<double>
+ * of degree 2, which yields f, f' and f''. For (nearly) equal eigenvalues the divided differences are replaced by their
+ * confluent Taylor forms, which tend to f[x,x] = f'(x) and f[x,x,x] = f''(x)/2, so the derivatives also exist for C = I
+ * and do not lose digits to the cancellation in the difference quotients for close eigenvalues.
+ * @code
+ * 	Sacado_Wrapper::SpectralTensorFunction<dim> ln_C;
+ * 	ln_C.reinit( C, Sacado_Wrapper::SpectralFunctions::Logarithm() );
+ * 	const SymmetricTensor<2,dim> &H = ln_C.get_value();
+ * 	SymmetricTensor<4,dim> H_C;
+ * 	ln_C.get_tangent(H_C);
+ * 	Sacado_Wrapper::SymCurvature<dim> H_CC;
+ * 	ln_C.get_curvature(H_CC);
+ * @endcode
+ * The tangent and the curvature have the same layout (including the factors 0.5 for the off-diagonal components) as
+ * those from SymTensor::get_tangent and SymTensor2::get_curvature. The scalar function \a f must be a functor with a
+ * templated call operator, e.g. SpectralFunctions::Logarithm below.
+ */
+namespace Sacado_Wrapper
+{
+	namespace SpectralFunctions
+	{
+		// f(x) = ln(x) for the logarithmic strain ln(C)
+		 struct Logarithm
+		 {
+			template<typename Number>
+			Number operator() ( const Number &x ) const
+			{
+				using std::log;
+				return log(x);
+			}
+		 };
+
+		// f(x) = sqrt(x) for the right stretch tensor U = sqrt(C)
+		 struct SquareRoot
+		 {
+			template<typename Number>
+			Number operator() ( const Number &x ) const
+			{
+				using std::sqrt;
+				return sqrt(x);
+			}
+		 };
+	}
+
+
+	template<int dim>
+	class SpectralTensorFunction
+	{
+	  public:
+		static const unsigned int n_dofs = SymmetricTensor<2,dim>::n_independent_components;
+
+		/*
+		 * Three eigenvalues that differ by less than \a tolerance * max(1,|lambda|) use f[a,b,c] = f''/2 (averaged over
+		 * the eigenvalues), which is exact up to O(h^2) in the gap h. Above it, the rounding error of the difference
+		 * quotient grows as eps/h, so the default cbrt(eps) balances both at about 4e-11.
+		 */
+		 explicit SpectralTensorFunction ( const double tolerance=std::cbrt(std::numeric_limits<double>::epsilon()) );
+
+		// Decompose \a C and evaluate the scalar function \a f with its first and second derivative at the eigenvalues
+		 template<typename ScalarFunction>
+		 void reinit ( const SymmetricTensor<2,dim> &C, const ScalarFunction &f );
+
+		// The tensor function F(C)
+		 const SymmetricTensor<2,dim> &get_value () const { return value; }
+
+		// The tangent dF/dC
+		 void get_tangent ( SymmetricTensor<4,dim> &Tangent ) const;
+
+		// The curvature d2F/dC2 in the compact storage (see SymCurvature)
+		 void get_curvature ( SymCurvature<dim> &Curvature ) const;
+
+	  private:
+		// Whether the eigenvalues a and b differ by less than \a relative_gap * max(1,|lambda_a|,|lambda_b|)
+		 bool coincide ( const unsigned int a, const unsigned int b, const double relative_gap ) const
+		 {
+			return std::abs(lambda[a]-lambda[b]) <= relative_gap * std::max( 1., std::max(std::abs(lambda[a]), std::abs(lambda[b])) );
+		 }
+
+		// First divided difference f[lambda_a,lambda_b]
+		 double divided_difference ( const unsigned int a, const unsigned int b ) const;
+
+		// Second divided difference f[lambda_a,lambda_b,lambda_c]
+		 double divided_difference ( const unsigned int a, const unsigned int b, const unsigned int c ) const;
+
+		// The independent components of the symmetrised dyadic product sym(n_a x n_b), packed in the dof order
+		 void packed_dyad ( double (&M)[n_dofs], const unsigned int a, const unsigned int b ) const;
+
+		const double tolerance;
+
+		// The confluent form of f[a,b] is exact up to O(h^4), so it is used up to the larger gap sqrt(tolerance). This keeps
+		// the first divided differences in the recursion for f[a,b,c] accurate to about 1e-12.
+		 const double tolerance_pair;
+
+		double lambda[dim];
+		Tensor<1,dim> n[dim];
+
+		// f, f' and f'' at the eigenvalues
+		 double f0[dim], f1[dim], f2[dim];
+
+		SymmetricTensor<2,dim> value;
+	};
+
+
+	template<int dim>
+	SpectralTensorFunction<dim>::SpectralTensorFunction ( const double tolerance )
+	:
+	tolerance(tolerance),
+	tolerance_pair(std::sqrt(tolerance))
+	{}
+
+
+	template<int dim>
+	template<typename ScalarFunction>
+	void SpectralTensorFunction<dim>::reinit ( const SymmetricTensor<2,dim> &C, const ScalarFunction &f )
+	{
+		const std::array<std::pair<double,Tensor<1,dim> >,dim> eigensystem = eigenvectors(C);
+
+		value.clear();
+		for ( unsigned int a=0; a<dim; ++a )
+		{
+			lambda[a] = eigensystem[a].first;
+			n[a] = eigensystem[a].second;
+
+			// The Taylor polynomial f(lambda+t) = f0 + f1 t + f2/2 t² + ...
+			 Sacado::Tay::Taylor<double> x (2, lambda[a]);
+			 x.fastAccessCoeff(1) = 1.;
+			 const Sacado::Tay::Taylor<double> f_x = f(x);
+			 f0[a] = f_x.coeff(0);
+			 f1[a] = f_x.coeff(1);
+			 f2[a] = 2. * f_x.coeff(2);
+
+			for ( unsigned int i=0; i<dim; ++i )
+				for ( unsigned int j=i; j<dim; ++j )
+					value[i][j] += f0[a] * n[a][i] * n[a][j];
+		}
+	}
+
+
+	template<int dim>
+	double SpectralTensorFunction<dim>::divided_difference ( const unsigned int a, const unsigned int b ) const
+	{
+		// f[a,b] is the mean of f' over [lambda_b,lambda_a]; the trapezoidal rule with the end correction of f'' is exact for cubic f
+		 if ( coincide(a,b,tolerance_pair) )
+			return 0.5 * ( f1[a] + f1[b] ) - ( lambda[a] - lambda[b] ) / 12. * ( f2[a] - f2[b] );
+		return ( f0[a] - f0[b] ) / ( lambda[a] - lambda[b] );
+	}
+
+
+	template<int dim>
+	double SpectralTensorFunction<dim>::divided_difference ( const unsigned int a, const unsigned int b, const unsigned int c ) const
+	{
+		// f[x,y,z] is symmetric, so it is evaluated as (f[p,r]-f[r,q])/(lambda_p-lambda_q) with the most distant lambda_p and lambda_q
+		 const unsigned int abc[3] = {a, b, c};
+		 unsigned int p = 0, q = 1;
+		 for ( unsigned int i=0; i<3; ++i )
+			for ( unsigned int j=i+1; j<3; ++j )
+				if ( std::abs(lambda[abc[i]]-lambda[abc[j]]) > std::abs(lambda[abc[p]]-lambda[abc[q]]) )
+				{
+					p = i;
+					q = j;
+				}
+
+		// All three eigenvalues (nearly) coincide: half the mean of f'' at the eigenvalues, which is exact for cubic f
+		 if ( coincide(abc[p],abc[q],tolerance) )
+			return ( f2[a] + f2[b] + f2[c] ) / 6.;
+
+		const unsigned int r = abc[3-p-q];
+		return ( divided_difference(abc[p],r) - divided_difference(r,abc[q]) ) / ( lambda[abc[p]] - lambda[abc[q]] );
+	}
+
+
+	template<int dim>
+	void SpectralTensorFunction<dim>::packed_dyad ( double (&M)[n_dofs], const unsigned int a, const unsigned int b ) const
+	{
+		for ( unsigned int x=0; x<n_dofs; ++x )
+		{
+			const unsigned int i = index_i<dim>(x), j = index_j<dim>(x);
+			M[x] = 0.5 * ( n[a][i] * n[b][j] + n[a][j] * n[b][i] );
+		}
+	}
+
+
+	/*
+	 * Tangent_ijkl = sum_ab f[lambda_a,lambda_b] * sym(n_a x n_b)_ij * sym(n_a x n_b)_kl
+	 */
+	template<int dim>
+	void SpectralTensorFunction<dim>::get_tangent ( SymmetricTensor<4,dim> &Tangent ) const
+	{
+		double T[n_dofs][n_dofs] = {};
+		for ( unsigned int a=0; a<dim; ++a )
+			for ( unsigned int b=a; b<dim; ++b )
+			{
+				// The pairs (a,b) and (b,a) contribute equally
+				 const double f_ab = ( a==b ? 1. : 2. ) * divided_difference(a,b);
+				 double M_ab[n_dofs];
+				 packed_dyad( M_ab, a, b );
+
+				for ( unsigned int y=0; y<n_dofs; ++y )
+					for ( unsigned int x=0; x<n_dofs; ++x )
+						T[y][x] += f_ab * M_ab[y] * M_ab[x];
+			}
+
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				Tangent[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = T[y][x];
+	}
+
+
+	/*
+	 * Curvature_ijklop = sum_abc f[lambda_a,lambda_c,lambda_b] * sym(n_a x n_b)_op
+	 * 					  * ( sym(n_a x n_c)_ij * sym(n_c x n_b)_kl + sym(n_a x n_c)_kl * sym(n_c x n_b)_ij )
+	 */
+	template<int dim>
+	void SpectralTensorFunction<dim>::get_curvature ( SymCurvature<dim> &Curvature ) const
+	{
+		double M[dim][dim][n_dofs];
+		for ( unsigned int a=0; a<dim; ++a )
+			for ( unsigned int b=0; b<dim; ++b )
+				packed_dyad( M[a][b], a, b );
+
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x )
+				for ( unsigned int op=0; op<n_dofs; ++op )
+					Curvature(y,x,op) = 0.;
+
+		for ( unsigned int a=0; a<dim; ++a )
+			for ( unsigned int b=0; b<dim; ++b )
+				for ( unsigned int c=0; c<dim; ++c )
+				{
+					const double f_acb = divided_difference(a,c,b);
+					for ( unsigned int y=0; y<n_dofs; ++y )
+						for ( unsigned int x=y; x<n_dofs; ++x )
+						{
+							const double factor = f_acb * ( M[a][c][y] * M[c][b][x] + M[a][c][x] * M[c][b][y] );
+							for ( unsigned int op=0; op<n_dofs; ++op )
+								Curvature(y,x,op) += factor * M[a][b][op];
+						}
+				}
+
+		// Symmetry in the two derivatives (ij) and (kl)
+		 for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=y+1; x<n_dofs; ++x )
+				for ( unsigned int op=0; op<n_dofs; ++op )
+					Curvature(x,y,op) = Curvature(y,x,op);
+	}
+}
+
+#endif // Sacado_spectral_H
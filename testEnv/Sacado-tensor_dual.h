@@ -0,0 +1,352 @@
+#ifndef Sacado_tensor_dual_H
+#define Sacado_tensor_dual_H
+
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <cmath>
+
+#include "Sacado_Wrapper.h"
+
+/*
+ * Tensor-level forward mode: a strain-dependent tensor as one AD number
+ *
+ * The SymTensor seeds the six independent components of the strain as separate Sacado numbers, so every stress
+ * component carries its own derivative array and get_tangent reassembles the tangent entry by entry (with the factors
+ * 0.5 for the off-diagonal components). The TensorDual<dim> instead keeps the tensor structure: it holds the value
+ * as SymmetricTensor<2,dim> and the derivative with respect to the strain as SymmetricTensor<4,dim>, and the tensor
+ * operations below apply the chain rule to the whole tensors. Scalars that depend on the strain (e.g. the trace) are
+ * ScalarDual<dim> with the value and the gradient as SymmetricTensor<2,dim>:
+ * @code
+ * 	Sacado_Wrapper::TensorDual<dim> eps;
+ * 	eps.reseed(eps_d);
+ * 	const Sacado_Wrapper::TensorDual<dim> sigma = kappa * trace(eps) * unit_symmetric_tensor<dim>() + 2.*mu * deviator(eps);
+ * 	const SymmetricTensor<4,dim> &C = sigma.dx();
+ * @endcode
+ * The derivatives follow the convention of deal.II (and get_tangent), i.e. dA = A.dx() : d_eps, and every operation
+ * is a double contraction or an outer product of SymmetricTensors, which deal.II evaluates as dense 6x6 (in 3D)
+ * kernels on the independent components.
+ * @note Only first derivatives with respect to one symmetric tensor (the strain) are available. Call the functions
+ * unqualified, they are found via argument-dependent lookup like the deal.II functions with the same names.
+ */
+namespace Sacado_Wrapper
+{
+	namespace internal
+	{
+		// The constant fourth-order tensors, built only once
+		 template<int dim>
+		 const SymmetricTensor<4,dim> &identity_tensor ()
+		 {
+			static const SymmetricTensor<4,dim> tmp = dealii::identity_tensor<dim>();
+			return tmp;
+		 }
+
+		 template<int dim>
+		 const SymmetricTensor<4,dim> &deviator_tensor ()
+		 {
+			static const SymmetricTensor<4,dim> tmp = dealii::deviator_tensor<dim>();
+			return tmp;
+		 }
+	}
+
+
+	/*
+	 * A scalar depending on the strain: the value and the gradient d(value)/d_eps
+	 */
+	template<int dim>
+	class ScalarDual
+	{
+	  public:
+		ScalarDual ( const double value=0. )
+		:
+		v(value)
+		{}
+
+		ScalarDual ( const double value, const SymmetricTensor<2,dim> &derivative )
+		:
+		v(value),
+		d(derivative)
+		{}
+
+		const double &val () const { return v; }
+		double &val () { return v; }
+
+		const SymmetricTensor<2,dim> &dx () const { return d; }
+		SymmetricTensor<2,dim> &dx () { return d; }
+
+		// Chain rule for an elementary function f of this number with the value f0=f(v) and the derivative f1=f'(v)
+		 ScalarDual<dim> chain ( const double f0, const double f1 ) const
+		 {
+			return ScalarDual<dim>( f0, f1 * d );
+		 }
+
+		ScalarDual<dim> &operator+= ( const ScalarDual<dim> &b ) { v += b.v; d += b.d; return *this; }
+		ScalarDual<dim> &operator-= ( const ScalarDual<dim> &b ) { v -= b.v; d -= b.d; return *this; }
+		ScalarDual<dim> &operator*= ( const ScalarDual<dim> &b ) { d = b.v * d + v * b.d; v *= b.v; return *this; }
+		ScalarDual<dim> &operator/= ( const ScalarDual<dim> &b ) { return (*this) *= b.chain( 1./b.v, -1./(b.v*b.v) ); }
+		ScalarDual<dim> &operator+= ( const double b ) { v += b; return *this; }
+		ScalarDual<dim> &operator-= ( const double b ) { v -= b; return *this; }
+		ScalarDual<dim> &operator*= ( const double b ) { v *= b; d *= b; return *this; }
+		ScalarDual<dim> &operator/= ( const double b ) { return (*this) *= (1./b); }
+
+	  private:
+		double v;
+		SymmetricTensor<2,dim> d;
+	};
+
+
+	/*
+	 * A symmetric second-order tensor depending on the strain: the value and the derivative d(value)/d_eps
+	 */
+	template<int dim>
+	class TensorDual
+	{
+	  public:
+		TensorDual () {}
+
+		// A constant tensor (zero derivative)
+		 explicit TensorDual ( const SymmetricTensor<2,dim> &value )
+		 :
+		 v(value)
+		 {}
+
+		TensorDual ( const SymmetricTensor<2,dim> &value, const SymmetricTensor<4,dim> &derivative )
+		:
+		v(value),
+		d(derivative)
+		{}
+
+		// Declare this tensor as the strain (the independent variable) with the value \a tensor_double (see SymTensor::reseed)
+		 void reseed ( const SymmetricTensor<2,dim> &tensor_double )
+		 {
+			v = tensor_double;
+			d = internal::identity_tensor<dim>();
+		 }
+
+		const SymmetricTensor<2,dim> &val () const { return v; }
+		SymmetricTensor<2,dim> &val () { return v; }
+
+		// The derivative with respect to the strain, e.g. the tangent for the stress
+		 const SymmetricTensor<4,dim> &dx () const { return d; }
+		 SymmetricTensor<4,dim> &dx () { return d; }
+
+		TensorDual<dim> &operator+= ( const TensorDual<dim> &B ) { v += B.v; d += B.d; return *this; }
+		TensorDual<dim> &operator-= ( const TensorDual<dim> &B ) { v -= B.v; d -= B.d; return *this; }
+		TensorDual<dim> &operator+= ( const SymmetricTensor<2,dim> &B ) { v += B; return *this; }
+		TensorDual<dim> &operator-= ( const SymmetricTensor<2,dim> &B ) { v -= B; return *this; }
+		TensorDual<dim> &operator*= ( const double b ) { v *= b; d *= b; return *this; }
+		TensorDual<dim> &operator/= ( const double b ) { return (*this) *= (1./b); }
+
+		// Product rule: d(s A) = s dA + A x ds
+		 TensorDual<dim> &operator*= ( const ScalarDual<dim> &s )
+		 {
+			d *= s.val();
+			d += dealii::outer_product( v, s.dx() );
+			v *= s.val();
+			return *this;
+		 }
+
+	  private:
+		SymmetricTensor<2,dim> v;
+		SymmetricTensor<4,dim> d;
+	};
+
+
+	// Arithmetic operators of ScalarDual for all combinations with double
+	 template<int dim>
+	 inline ScalarDual<dim> operator- ( const ScalarDual<dim> &a ) { ScalarDual<dim> r(a); return r *= -1.; }
+
+	 template<int dim>
+	 inline ScalarDual<dim> operator+ ( ScalarDual<dim> a, const ScalarDual<dim> &b ) { return a += b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator+ ( ScalarDual<dim> a, const double b ) { return a += b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator+ ( const double a, ScalarDual<dim> b ) { return b += a; }
+
+	 template<int dim>
+	 inline ScalarDual<dim> operator- ( ScalarDual<dim> a, const ScalarDual<dim> &b ) { return a -= b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator- ( ScalarDual<dim> a, const double b ) { return a -= b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator- ( const double a, const ScalarDual<dim> &b ) { ScalarDual<dim> r(-b); return r += a; }
+
+	 template<int dim>
+	 inline ScalarDual<dim> operator* ( ScalarDual<dim> a, const ScalarDual<dim> &b ) { return a *= b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator* ( ScalarDual<dim> a, const double b ) { return a *= b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator* ( const double a, ScalarDual<dim> b ) { return b *= a; }
+
+	 template<int dim>
+	 inline ScalarDual<dim> operator/ ( ScalarDual<dim> a, const ScalarDual<dim> &b ) { return a /= b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator/ ( ScalarDual<dim> a, const double b ) { return a /= b; }
+	 template<int dim>
+	 inline ScalarDual<dim> operator/ ( const double a, const ScalarDual<dim> &b ) { return b.chain( a/b.val(), -a/(b.val()*b.val()) ); }
+
+
+	// Elementary functions of ScalarDual (call them unqualified, e.g. sqrt(x) instead of std::sqrt(x))
+	 template<int dim>
+	 inline ScalarDual<dim> sqrt ( const ScalarDual<dim> &a )
+	 {
+		const double f0 = std::sqrt(a.val());
+		return a.chain( f0, 0.5/f0 );
+	 }
+
+	 template<int dim>
+	 inline ScalarDual<dim> exp ( const ScalarDual<dim> &a )
+	 {
+		const double f0 = std::exp(a.val());
+		return a.chain( f0, f0 );
+	 }
+
+	 template<int dim>
+	 inline ScalarDual<dim> log ( const ScalarDual<dim> &a )
+	 {
+		return a.chain( std::log(a.val()), 1./a.val() );
+	 }
+
+	 template<int dim>
+	 inline ScalarDual<dim> pow ( const ScalarDual<dim> &a, const double b )
+	 {
+		return a.chain( std::pow(a.val(),b), b*std::pow(a.val(),b-1.) );
+	 }
+
+
+	// Arithmetic operators of TensorDual with TensorDual, constant tensors, double and ScalarDual
+	 template<int dim>
+	 inline TensorDual<dim> operator- ( const TensorDual<dim> &A ) { TensorDual<dim> R(A); return R *= -1.; }
+
+	 template<int dim>
+	 inline TensorDual<dim> operator+ ( TensorDual<dim> A, const TensorDual<dim> &B ) { return A += B; }
+	 template<int dim>
+	 inline TensorDual<dim> operator+ ( TensorDual<dim> A, const SymmetricTensor<2,dim> &B ) { return A += B; }
+	 template<int dim>
+	 inline TensorDual<dim> operator+ ( const SymmetricTensor<2,dim> &B, TensorDual<dim> A ) { return A += B; }
+
+	 template<int dim>
+	 inline TensorDual<dim> operator- ( TensorDual<dim> A, const TensorDual<dim> &B ) { return A -= B; }
+	 template<int dim>
+	 inline TensorDual<dim> operator- ( TensorDual<dim> A, const SymmetricTensor<2,dim> &B ) { return A -= B; }
+	 template<int dim>
+	 inline TensorDual<dim> operator- ( const SymmetricTensor<2,dim> &B, const TensorDual<dim> &A ) { TensorDual<dim> R(-A); return R += B; }
+
+	 template<int dim>
+	 inline TensorDual<dim> operator* ( TensorDual<dim> A, const double b ) { return A *= b; }
+	 template<int dim>
+	 inline TensorDual<dim> operator* ( const double b, TensorDual<dim> A ) { return A *= b; }
+	 template<int dim>
+	 inline TensorDual<dim> operator/ ( TensorDual<dim> A, const double b ) { return A /= b; }
+
+	 template<int dim>
+	 inline TensorDual<dim> operator* ( TensorDual<dim> A, const ScalarDual<dim> &s ) { return A *= s; }
+	 template<int dim>
+	 inline TensorDual<dim> operator* ( const ScalarDual<dim> &s, TensorDual<dim> A ) { return A *= s; }
+	 template<int dim>
+	 inline TensorDual<dim> operator/ ( TensorDual<dim> A, const ScalarDual<dim> &s ) { return A *= (1./s); }
+
+	 // A constant tensor \a B scaled with the scalar \a s: d(s B) = B x ds
+	 template<int dim>
+	 inline TensorDual<dim> operator* ( const ScalarDual<dim> &s, const SymmetricTensor<2,dim> &B )
+	 {
+		return TensorDual<dim>( s.val() * B, dealii::outer_product( B, s.dx() ) );
+	 }
+	 template<int dim>
+	 inline TensorDual<dim> operator* ( const SymmetricTensor<2,dim> &B, const ScalarDual<dim> &s ) { return s * B; }
+
+
+	/*
+	 * Trace: d(tr A) = I : dA
+	 */
+	template<int dim>
+	ScalarDual<dim> trace ( const TensorDual<dim> &A )
+	{
+		return ScalarDual<dim>( trace(A.val()), unit_symmetric_tensor<dim>() * A.dx() );
+	}
+
+
+	/*
+	 * Deviator: d(A^dev) = I^dev : dA
+	 */
+	template<int dim>
+	TensorDual<dim> deviator ( const TensorDual<dim> &A )
+	{
+		return TensorDual<dim>( deviator(A.val()), internal::deviator_tensor<dim>() * A.dx() );
+	}
+
+
+	/*
+	 * Inverse: d(A^-1)_ij = -A^-1_im dA_mn A^-1_nj, with the symmetrised derivative of the inverse
+	 */
+	template<int dim>
+	TensorDual<dim> invert ( const TensorDual<dim> &A )
+	{
+		const SymmetricTensor<2,dim> A_inv = invert(A.val());
+
+		SymmetricTensor<4,dim> dA_inv_dA;
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				for ( unsigned int m=0; m<dim; ++m )
+					for ( unsigned int n=m; n<dim; ++n )
+						dA_inv_dA[i][j][m][n] = -0.5 * ( A_inv[i][m] * A_inv[j][n] + A_inv[i][n] * A_inv[j][m] );
+
+		return TensorDual<dim>( A_inv, dA_inv_dA * A.dx() );
+	}
+
+
+	/*
+	 * Determinant: d(det A) = det A * A^-1 : dA
+	 */
+	template<int dim>
+	ScalarDual<dim> determinant ( const TensorDual<dim> &A )
+	{
+		const double det_A = determinant(A.val());
+		return ScalarDual<dim>( det_A, det_A * ( invert(A.val()) * A.dx() ) );
+	}
+
+
+	/*
+	 * Frobenius norm: d|A| = A : dA / |A| (the derivative is set to zero for A = 0)
+	 */
+	template<int dim>
+	ScalarDual<dim> norm ( const TensorDual<dim> &A )
+	{
+		const double norm_A = A.val().norm();
+		if ( norm_A==0. )
+			return ScalarDual<dim>( 0. );
+		return ScalarDual<dim>( norm_A, ( A.val() * A.dx() ) / norm_A );
+	}
+
+
+	/*
+	 * Double contractions A : B = A_ij * B_ij with another TensorDual or a constant tensor
+	 */
+	template<int dim>
+	ScalarDual<dim> scalar_product ( const TensorDual<dim> &A, const TensorDual<dim> &B )
+	{
+		return ScalarDual<dim>( A.val() * B.val(), A.val() * B.dx() + B.val() * A.dx() );
+	}
+
+	template<int dim>
+	ScalarDual<dim> scalar_product ( const TensorDual<dim> &A, const SymmetricTensor<2,dim> &B )
+	{
+		return ScalarDual<dim>( A.val() * B, B * A.dx() );
+	}
+
+	template<int dim>
+	ScalarDual<dim> scalar_product ( const SymmetricTensor<2,dim> &B, const TensorDual<dim> &A )
+	{
+		return scalar_product( A, B );
+	}
+
+
+	/*
+	 * Double contraction \a C : \a A = C_ijkl * A_kl with a constant fourth-order tensor \a C (e.g. an elasticity tensor)
+	 */
+	template<int dim>
+	TensorDual<dim> double_contract ( const SymmetricTensor<4,dim> &C, const TensorDual<dim> &A )
+	{
+		return TensorDual<dim>( C * A.val(), C * A.dx() );
+	}
+}
+
+#endif // Sacado_tensor_dual_H
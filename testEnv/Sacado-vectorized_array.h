@@ -0,0 +1,199 @@
+#ifndef Sacado_vectorized_array_H
+#define Sacado_vectorized_array_H
+
+// VectorizedArray: a short vector of doubles (4 with AVX2, 8 with AVX-512) with the arithmetic operations as SIMD instructions
+#include <deal.II/base/vectorization.h>
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <string>
+#include <type_traits>
+
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+
+// Sacado's SFad creates the derivatives as T(0.), which needs the constructor VectorizedArray(const double) from deal.II 9.2
+#if !DEAL_II_VERSION_GTE(9,2,0)
+#  error "Sacado-vectorized_array.h requires deal.II 9.2 or newer (VectorizedArray<double> from a double)."
+#endif
+
+/*
+ * SIMD evaluation of the first-order wrapper across quadrature points with the data type
+ * Sacado::Fad::SFad<VectorizedArray<double>,N>: The value and each of the N derivatives of a component hold the
+ * numbers of \a n_lanes quadrature points, so the material model (e.g. \a stress_strain_relation) is evaluated
+ * for \a n_lanes quadrature points with every instruction.
+ * @code
+ * 	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+ * 	Sacado_Wrapper::SymTensor_vectorized<dim,N> eps;
+ * 	for ( unsigned int qp=0; qp<n_q_points; qp+=Sacado_Wrapper::n_lanes )
+ * 	{
+ * 		for ( unsigned int lane=0; lane<Sacado_Wrapper::n_lanes; ++lane )
+ * 			eps.init( eps_d[qp+lane], lane );
+ * 		eps.set_dofs();
+ *
+ * 		SymmetricTensor<2,dim,Sacado_Wrapper::fad_vectorized<N> > sigma = stress_strain_relation(eps, kappa, mu);
+ *
+ * 		for ( unsigned int lane=0; lane<Sacado_Wrapper::n_lanes; ++lane )
+ * 		{
+ * 			eps.get_tangent(C[qp+lane], sigma, lane);
+ * 			sigma_d[qp+lane] = Sacado_Wrapper::get_value(sigma, lane);
+ * 		}
+ * 	}
+ * @endcode
+ * @note Only the operations that act on all lanes alike can be used in the material model. Branches on values
+ * (e.g. if ( phi > 0 )) must be written lane by lane or via compare_and_apply_mask.
+ * @note Requires deal.II 9.2 or newer (the constructor VectorizedArray(const double) that Sacado's SFad and the mixed
+ * operations with double constants use, and VectorizedArray::size()). The CMakeLists.txt skips the benchmarks with
+ * this header (benchmark_vectorized, benchmark_batch) for deal.II 9.1.
+ */
+
+
+/*
+ * Traits for Sacado to use dealii::VectorizedArray<double> as the value type of the Fad data types
+ * (analogous to the traits of the Sacado data types themselves in Sacado_Traits.hpp)
+ */
+namespace Sacado
+{
+	template<>
+	struct ScalarType< dealii::VectorizedArray<double> >
+	{
+		typedef double type;
+	};
+
+	template<>
+	struct ValueType< dealii::VectorizedArray<double> >
+	{
+		typedef dealii::VectorizedArray<double> type;
+	};
+
+	template<>
+	struct IsADType< dealii::VectorizedArray<double> >
+	{
+		static const bool value = false;
+	};
+
+	template<>
+	struct IsScalarType< dealii::VectorizedArray<double> >
+	{
+		static const bool value = false;
+	};
+
+	template<>
+	struct IsStaticallySized< dealii::VectorizedArray<double> >
+	{
+		static const bool value = true;
+	};
+
+	template<>
+	struct Value< dealii::VectorizedArray<double> >
+	{
+		typedef dealii::VectorizedArray<double> value_type;
+		static const dealii::VectorizedArray<double> &eval ( const dealii::VectorizedArray<double> &x ) { return x; }
+	};
+
+	template<>
+	struct ScalarValue< dealii::VectorizedArray<double> >
+	{
+		typedef dealii::VectorizedArray<double> value_type;
+		static const dealii::VectorizedArray<double> &eval ( const dealii::VectorizedArray<double> &x ) { return x; }
+	};
+
+	template<>
+	struct StringName< dealii::VectorizedArray<double> >
+	{
+		static std::string eval () { return "dealii::VectorizedArray<double>"; }
+	};
+
+	template<>
+	struct IsEqual< dealii::VectorizedArray<double> >
+	{
+		static bool eval ( const dealii::VectorizedArray<double> &x, const dealii::VectorizedArray<double> &y )
+		{
+			for ( unsigned int lane=0; lane<Sacado_Wrapper::internal::simd_width; ++lane )
+				if ( x[lane]!=y[lane] )
+					return false;
+			return true;
+		}
+	};
+
+	// Mixed operations with double constants result in a VectorizedArray (the double is broadcast to all lanes)
+	 template<>
+	 struct Promote< dealii::VectorizedArray<double>, double >
+	 {
+		typedef dealii::VectorizedArray<double> type;
+	 };
+
+	 template<>
+	 struct Promote< double, dealii::VectorizedArray<double> >
+	 {
+		typedef dealii::VectorizedArray<double> type;
+	 };
+}
+
+
+namespace Sacado_Wrapper
+{
+	/*
+	 * Number of quadrature points evaluated at once (the SIMD width for doubles of the instruction set deal.II
+	 * was compiled for, e.g. 4 for AVX2 and 8 for AVX-512)
+	 */
+	 static const unsigned int n_lanes = internal::simd_width;
+
+	namespace internal
+	{
+		template<>
+		struct lanes< VectorizedArray<double> >
+		{
+			static const unsigned int n = simd_width;
+			static double &at ( VectorizedArray<double> &value, const unsigned int lane ) { return value[lane]; }
+			static const double &at ( const VectorizedArray<double> &value, const unsigned int lane ) { return value[lane]; }
+		};
+	}
+
+	// The SIMD Sacado data type with exactly N dofs
+	 template<unsigned int N>
+	 using fad_vectorized = Sacado::Fad::SFad< VectorizedArray<double>, N >;
+
+	/*
+	 * First-order wrapper data types for the SIMD evaluation of \a n_lanes quadrature points
+	 * (use SymTensor::init(*,lane), get_tangent(*,lane), ... to fill and unpack the individual quadrature points)
+	 */
+	 template<int dim, unsigned int N>
+	 using SymTensor_vectorized = SymTensor<dim, fad_vectorized<N> >;
+	 template<int dim, unsigned int N>
+	 using SW_double_vectorized = SW_double<dim, fad_vectorized<N> >;
+	 template<int dim, unsigned int N>
+	 using DoFs_summary_vectorized = DoFs_summary<dim, fad_vectorized<N>, Sacado::Fad::SFad<fad_vectorized<N>,N> >;
+
+
+	/*
+	 * Restrict the lane extraction to Sacado data types whose values are VectorizedArray<double>, so the
+	 * overload does not capture the scalar get_value of the other Sacado data types
+	 */
+	 template<typename Number, typename T=void>
+	 using enable_if_vectorized = typename std::enable_if< Sacado::IsADType<Number>::value
+														   && std::is_same<typename Number::value_type, VectorizedArray<double> >::value, T >::type;
+
+	/*
+	 * Extract the values of the quadrature point \a lane from a SIMD variable, e.g. the stress computed from the
+	 * SymTensor_vectorized (\a Number is the SIMD data type fad_vectorized<N>)
+	 */
+	 template<typename Number>
+	 inline enable_if_vectorized<Number,double> get_value ( const Number &argument, const unsigned int lane )
+	 {
+		return argument.val()[lane];
+	 }
+
+	 template<int dim, typename Number>
+	 enable_if_vectorized<Number,SymmetricTensor<2,dim> > get_value ( const SymmetricTensor<2,dim,Number> &argument, const unsigned int lane )
+	 {
+		SymmetricTensor<2,dim> tmp;
+		unrolled_loop<0,SymTensor<dim>::n_dofs>::run( [&] (const unsigned int x)
+		{
+			tmp[index_i<dim>(x)][index_j<dim>(x)] = argument[index_i<dim>(x)][index_j<dim>(x)].val()[lane];
+		});
+		return tmp;
+	 }
+}
+
+#endif // Sacado_vectorized_array_H
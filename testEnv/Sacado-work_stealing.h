@@ -0,0 +1,371 @@
+#ifndef Sacado_work_stealing_H
+#define Sacado_work_stealing_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+namespace Sacado_Wrapper
+{
+	/*
+	 * Work-stealing scheduler for quadrature points of very different cost
+	 *
+	 * In models with an elastic shortcut and nested-Fad local iterations (damage, plasticity), the cost of a quadrature point
+	 * easily differs by a factor of 10 to 50 and the expensive points are clustered in the mesh (e.g. in a localisation
+	 * band), so chunks of equal numbers of quadrature points leave most threads idle.
+	 *
+	 * The scheduler therefore
+	 * - measures the wall time of every task and uses it, shared equally by the quadrature points of the task, as the cost
+	 *   estimate for the next call of \a run (the previous Newton iteration or load step), where the first call assumes
+	 *   equal costs,
+	 * - cuts the quadrature points into tasks of about equal estimated cost and gives every thread a contiguous range of
+	 *   tasks with about the same total cost,
+	 * - lets idle threads steal tasks from the end of the queues of the other threads, which corrects wrong estimates.
+	 * The body gets the quadrature point and the id of the thread, e.g. to pick its per-thread wrapper variables:
+	 * @code
+	 * 	WorkStealingScheduler scheduler (n_threads);
+	 * 	std::vector<ScratchData> scratch (scheduler.n_threads());
+	 * 	for ( unsigned int it=0; it<n_iterations; ++it )
+	 * 		scheduler.run( n_qps, [&] (const unsigned int qp, const unsigned int thread) { evaluate_qp(qp, scratch[thread]); } );
+	 * @endcode
+	 * The worker threads are started once by the constructor and wait for the next call of \a run. An exception thrown by
+	 * the body is rethrown by \a run after all threads finished.
+	 *
+	 * @note With \a steal = false and \a use_cost_estimates = false, the scheduler reduces to the static partitioning into
+	 * equal numbers of quadrature points per thread (the reference in benchmark_work_stealing.cc). Without stealing, every
+	 * thread still gets \a n_tasks_per_thread tasks, which only sets the resolution of the measured costs.
+	 */
+	class WorkStealingScheduler
+	{
+	public:
+		struct Statistics
+		{
+			unsigned int n_tasks = 0;
+			unsigned int n_steals = 0;
+			double wall_time = 0;
+			std::vector<double> busy_time;	// per thread, sum of the measured times of the tasks
+
+			// Maximum over mean busy time minus one (0 for a perfect balance)
+			 double imbalance () const;
+
+			void print ( std::ostream &stream ) const;
+		};
+
+		WorkStealingScheduler ( const unsigned int n_threads=std::thread::hardware_concurrency(),
+								const bool steal=true, const bool use_cost_estimates=true,
+								const unsigned int n_tasks_per_thread=16 );
+
+		// Stop and join the worker threads
+		 ~WorkStealingScheduler ();
+
+		WorkStealingScheduler ( const WorkStealingScheduler & ) = delete;
+		WorkStealingScheduler &operator= ( const WorkStealingScheduler & ) = delete;
+
+		unsigned int n_threads () const { return n_threads_; }
+
+		/*
+		 * Evaluate \a body(qp,thread) for all quadrature points 0 ... n_qps-1 and update the cost estimates
+		 */
+		 template<typename Body>
+		 void run ( const unsigned int n_qps, const Body &body );
+
+		// The measured wall time of every quadrature point in the last call of \a run (the time of its task over its size)
+		 const std::vector<double> &cost_estimates () const { return costs; }
+
+		// Forget the cost estimates (e.g. after remeshing)
+		 void clear_cost_estimates () { costs.clear(); }
+
+		const Statistics &statistics () const { return statistics_; }
+
+	private:
+		// The quadrature points [begin,end)
+		 struct Task
+		 {
+			unsigned int begin;
+			unsigned int end;
+		 };
+
+		struct TaskQueue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		// The measured times of the tasks of a thread, merged into \a costs after all threads finished
+		 struct TaskTime
+		 {
+			Task task;
+			double time;
+		 };
+
+		struct ThreadData
+		{
+			std::vector<TaskTime> task_times;
+			double busy_time = 0.;
+			std::exception_ptr exception;
+		};
+
+		// Create the tasks and distribute them over the queues by the (estimated) costs
+		 void partition ( const unsigned int n_qps );
+
+		// Take a task from the front of the own queue or steal one from the back of another queue
+		 bool next_task ( const unsigned int thread, Task &task );
+
+		// Process the tasks of \a thread and record their times in its ThreadData
+		 void work ( const unsigned int thread, const std::function<void(unsigned int,unsigned int)> &body );
+
+		// Wait for the next call of \a run and take part in it, until the destructor sets \a stop
+		 void worker_loop ( const unsigned int thread );
+
+		const unsigned int n_threads_;
+		const bool steal;
+		const bool use_cost_estimates;
+		const unsigned int n_tasks_per_thread;
+
+		std::vector<double> costs;
+		std::vector<std::unique_ptr<TaskQueue> > queues;
+		// Separate allocations per thread, so the threads do not share cache lines
+		 std::vector<std::unique_ptr<ThreadData> > thread_data;
+		std::atomic<unsigned int> n_steals;
+		Statistics statistics_;
+
+		// The persistent worker threads 1 ... n_threads-1 (the calling thread is thread 0)
+		 std::vector<std::thread> workers;
+		 std::mutex pool_mutex;
+		 std::condition_variable start_condition;
+		 std::condition_variable done_condition;
+		 const std::function<void(unsigned int,unsigned int)> *current_body = nullptr;
+		 unsigned long generation = 0;
+		 unsigned int n_running = 0;
+		 bool stop = false;
+	};
+
+
+	inline WorkStealingScheduler::WorkStealingScheduler ( const unsigned int n_threads, const bool steal,
+														  const bool use_cost_estimates, const unsigned int n_tasks_per_thread )
+	:
+	n_threads_(std::max(n_threads,1u)),
+	steal(steal),
+	use_cost_estimates(use_cost_estimates),
+	n_tasks_per_thread(std::max(n_tasks_per_thread,1u)),
+	n_steals(0)
+	{
+		for ( unsigned int thread=0; thread<n_threads_; ++thread )
+		{
+			queues.emplace_back( new TaskQueue );
+			thread_data.emplace_back( new ThreadData );
+		}
+
+		for ( unsigned int thread=1; thread<n_threads_; ++thread )
+			workers.emplace_back( &WorkStealingScheduler::worker_loop, this, thread );
+	}
+
+
+	inline WorkStealingScheduler::~WorkStealingScheduler ()
+	{
+		{
+			std::lock_guard<std::mutex> lock (pool_mutex);
+			stop = true;
+		}
+		start_condition.notify_all();
+		for ( std::thread &worker : workers )
+			worker.join();
+	}
+
+
+	inline void WorkStealingScheduler::worker_loop ( const unsigned int thread )
+	{
+		unsigned long last_generation = 0;
+		while ( true )
+		{
+			const std::function<void(unsigned int,unsigned int)> *body;
+			{
+				std::unique_lock<std::mutex> lock (pool_mutex);
+				start_condition.wait( lock, [&] () { return stop || generation!=last_generation; } );
+				if ( stop )
+					return;
+				last_generation = generation;
+				body = current_body;
+			}
+
+			work( thread, *body );
+
+			std::lock_guard<std::mutex> lock (pool_mutex);
+			if ( --n_running == 0 )
+				done_condition.notify_one();
+		}
+	}
+
+
+	inline void WorkStealingScheduler::partition ( const unsigned int n_qps )
+	{
+		for ( const std::unique_ptr<TaskQueue> &queue : queues )
+			queue->tasks.clear();
+
+		// Equal costs without (valid) estimates
+		 if ( !use_cost_estimates || costs.size()!=n_qps )
+			costs.assign( n_qps, 1. );
+
+		const double total_cost = std::accumulate( costs.begin(), costs.end(), 0. );
+		const double task_cost = total_cost / (n_threads_*n_tasks_per_thread);
+		const double thread_cost = total_cost / n_threads_;
+
+		// Cut at the prefix sums task_cost, 2*task_cost, ... and give the task to the thread, whose share contains its begin
+		 double cost_before_task = 0., cost = 0.;
+		 unsigned int begin = 0;
+		 statistics_.n_tasks = 0;
+		 for ( unsigned int qp=0; qp<n_qps; ++qp )
+		 {
+			cost += costs[qp];
+			if ( cost - cost_before_task >= task_cost || qp+1==n_qps )
+			{
+				const unsigned int thread = std::min<unsigned int>( cost_before_task/thread_cost, n_threads_-1 );
+				queues[thread]->tasks.push_back( Task{begin, qp+1} );
+				++statistics_.n_tasks;
+				begin = qp+1;
+				cost_before_task = cost;
+			}
+		 }
+	}
+
+
+	inline bool WorkStealingScheduler::next_task ( const unsigned int thread, Task &task )
+	{
+		{
+			TaskQueue &own = *queues[thread];
+			std::lock_guard<std::mutex> lock (own.mutex);
+			if ( !own.tasks.empty() )
+			{
+				task = own.tasks.front();
+				own.tasks.pop_front();
+				return true;
+			}
+		}
+
+		if ( !steal )
+			return false;
+
+		// No tasks are created while running, so all queues being empty means that the work is done
+		 for ( unsigned int k=1; k<n_threads_; ++k )
+		 {
+			TaskQueue &victim = *queues[(thread+k)%n_threads_];
+			std::lock_guard<std::mutex> lock (victim.mutex);
+			if ( !victim.tasks.empty() )
+			{
+				task = victim.tasks.back();
+				victim.tasks.pop_back();
+				++n_steals;
+				return true;
+			}
+		 }
+		return false;
+	}
+
+
+	inline void WorkStealingScheduler::work ( const unsigned int thread, const std::function<void(unsigned int,unsigned int)> &body )
+	{
+		typedef std::chrono::steady_clock Clock;
+
+		ThreadData &data = *thread_data[thread];
+		data.task_times.clear();
+		data.busy_time = 0.;
+		data.exception = nullptr;
+
+		try
+		{
+			Task task;
+			while ( next_task(thread, task) )
+			{
+				const Clock::time_point task_start = Clock::now();
+				for ( unsigned int qp=task.begin; qp<task.end; ++qp )
+					body( qp, thread );
+				const double time = std::chrono::duration<double>( Clock::now()-task_start ).count();
+				data.task_times.push_back( TaskTime{task, time} );
+				data.busy_time += time;
+			}
+		}
+		catch ( ... )
+		{
+			data.exception = std::current_exception();
+		}
+	}
+
+
+	template<typename Body>
+	void WorkStealingScheduler::run ( const unsigned int n_qps, const Body &body )
+	{
+		typedef std::chrono::steady_clock Clock;
+		const Clock::time_point start = Clock::now();
+
+		partition(n_qps);
+		n_steals = 0;
+
+		// The body is called per quadrature point through std::function, which is negligible compared to the evaluation
+		 const std::function<void(unsigned int,unsigned int)> body_function (
+			[&body] ( const unsigned int qp, const unsigned int thread ) { body( qp, thread ); } );
+
+		{
+			std::lock_guard<std::mutex> lock (pool_mutex);
+			current_body = &body_function;
+			n_running = n_threads_-1;
+			++generation;
+		}
+		start_condition.notify_all();
+		work( 0, body_function );
+		{
+			std::unique_lock<std::mutex> lock (pool_mutex);
+			done_condition.wait( lock, [&] () { return n_running==0; } );
+			current_body = nullptr;
+		}
+
+		// Merge the task times of all threads into the cost estimates of the quadrature points
+		 statistics_.busy_time.resize( n_threads_ );
+		 std::exception_ptr exception;
+		 for ( unsigned int thread=0; thread<n_threads_; ++thread )
+		 {
+			const ThreadData &data = *thread_data[thread];
+			for ( const TaskTime &task_time : data.task_times )
+				std::fill( costs.begin()+task_time.task.begin, costs.begin()+task_time.task.end,
+						   task_time.time / (task_time.task.end-task_time.task.begin) );
+			statistics_.busy_time[thread] = data.busy_time;
+			if ( data.exception && !exception )
+				exception = data.exception;
+		 }
+
+		statistics_.n_steals = n_steals;
+		statistics_.wall_time = std::chrono::duration<double>( Clock::now()-start ).count();
+
+		if ( exception )
+			std::rethrow_exception( exception );
+	}
+
+
+	inline double WorkStealingScheduler::Statistics::imbalance () const
+	{
+		if ( busy_time.empty() )
+			return 0.;
+		const double max_time = *std::max_element( busy_time.begin(), busy_time.end() );
+		const double mean_time = std::accumulate( busy_time.begin(), busy_time.end(), 0. ) / busy_time.size();
+		return ( mean_time>0 ) ? max_time/mean_time-1. : 0.;
+	}
+
+
+	inline void WorkStealingScheduler::Statistics::print ( std::ostream &stream ) const
+	{
+		stream << std::setw(8) << n_tasks << std::setw(8) << n_steals << std::setw(14) << wall_time
+			   << std::setw(12) << imbalance();
+	}
+}
+
+#endif // Sacado_work_stealing_H
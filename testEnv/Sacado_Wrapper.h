@@ -4,6 +4,11 @@
 // @section includes Include Files
 // The data type SymmetricTensor and some related operations, such as trace, symmetrize, deviator, ... for tensor calculus
 #include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/tensor.h>
+// FullMatrix as output for the packed (Voigt/Mandel) tangents
+#include <deal.II/lac/full_matrix.h>
+// VectorizedArray: the SIMD width for SFad<VectorizedArray<double>,N> and PaddedFad<N>
+#include <deal.II/base/vectorization.h>
 
 // @todo Check whether the following three headers are needed at all
 #include <iostream>
@@ -13,110 +18,210 @@
 // Sacado (from Trilinos, data types, operations, ...)
 #include <Sacado.hpp>
 
+// The compile-time layout of the dofs (index_i, index_j, voigt_scale, DoFs_layout, n_total_dofs, ...)
+#include "../Sacado-dof_layout.h"
+
 using namespace dealii;
 
 using fad_double = Sacado::Fad::DFad<double>;	// this data type now represents a double, but also contains the derivative of this variable with respect to the defined dofs (set via command *.diff(*))
 typedef Sacado::Fad::DFad<double> DFadType;
-/*
- * A function to set up the map that relates the indices (e.g. first entry in vector is the (0,0) component, whereas the second is the (0,1) component
- */
-template<int dim>
-void get_index_map( std::map<unsigned int,std::pair<unsigned int,unsigned int>> &std_map_indicies )
-{
-	std::pair<unsigned int, unsigned int> tmp_pair;
 
-	switch ( dim )
+namespace Sacado_Wrapper
+{
+	namespace internal
 	{
-	case 2:
-		tmp_pair.first=0; tmp_pair.second=0;
-		std_map_indicies[0] = tmp_pair;
-
-		tmp_pair.first=0; tmp_pair.second=1;
-		std_map_indicies[1] = tmp_pair;
-
-		tmp_pair.first=1; tmp_pair.second=1;
-		std_map_indicies[2] = tmp_pair;
-		break;
-	case 3:
-		tmp_pair.first=0; tmp_pair.second=0;
-		std_map_indicies[0] = tmp_pair;
-
-		tmp_pair.first=0; tmp_pair.second=1;
-		std_map_indicies[1] = tmp_pair;
+		// Compile-time sequence 0,1,...,n-1 (as std::index_sequence from C++14) to expand parameter packs with their position
+		 template<std::size_t... k>
+		 struct index_sequence
+		 {
+		 };
 
-		tmp_pair.first=0; tmp_pair.second=2;
-		std_map_indicies[2] = tmp_pair;
+		 template<std::size_t n, std::size_t... k>
+		 struct make_index_sequence_helper : make_index_sequence_helper<n-1, n-1, k...>
+		 {
+		 };
 
-		tmp_pair.first=1; tmp_pair.second=1;
-		std_map_indicies[3] = tmp_pair;
+		 template<std::size_t... k>
+		 struct make_index_sequence_helper<0, k...>
+		 {
+			 typedef index_sequence<k...> type;
+		 };
 
-		tmp_pair.first=1; tmp_pair.second=2;
-		std_map_indicies[4] = tmp_pair;
+		 template<std::size_t n>
+		 using make_index_sequence = typename make_index_sequence_helper<n>::type;
 
-		tmp_pair.first=2; tmp_pair.second=2;
-		std_map_indicies[5] = tmp_pair;
-		break;
+		// Number of quadrature points held by the value type \a T of a Sacado data type and access to the \a lane-th of them:
+		// a single one for double, several for SIMD types (see the specialisation in Sacado-vectorized_array.h)
+		 template<typename T>
+		 struct lanes
+		 {
+			static const unsigned int n = 1;
+			static double &at ( T &value, const unsigned int ) { return value; }
+			static const double &at ( const T &value, const unsigned int ) { return value; }
+		 };
+
+		// SIMD width for doubles of the instruction set deal.II was compiled for (e.g. 4 for AVX2 and 8 for AVX-512).
+		// deal.II 9.1 provides it as VectorizedArray::n_array_elements, which was replaced by size() in deal.II 9.2 and removed later.
+		 #if DEAL_II_VERSION_GTE(9,2,0)
+		 constexpr unsigned int simd_width = VectorizedArray<double>::size();
+		 #else
+		 constexpr unsigned int simd_width = VectorizedArray<double>::n_array_elements;
+		 #endif
+
+		// Selection of the memory pool for the derivative arrays of the data type \a T for the total number of dofs, called by
+		// DoFs_summary whenever the dofs are set. Nothing to do for the heap-based data types (see the specialisations in
+		// Sacado-memory_pool.h)
+		 template<typename T>
+		 struct pool_selector
+		 {
+			static void select ( const unsigned int ) {}
+		 };
 	}
-}
 
+	/*
+	 * Loop over x = \a first, ..., \a last-1 that is unrolled at compile time. Combined with the tables in
+	 * Sacado-dof_layout.h, the extraction of the tangents compiles into straight-line code without branches or lookups.
+	 * @code
+	 * 	unrolled_loop<0,6>::run( [&] (const unsigned int x) { ... } );
+	 * @endcode
+	 */
+	template<unsigned int first, unsigned int last>
+	struct unrolled_loop
+	{
+		template<typename Body>
+		static inline void run ( const Body &body )
+		{
+			body(first);
+			unrolled_loop<first+1,last>::run(body);
+		}
+	};
 
-namespace Sacado_Wrapper
-{
-	template <int dim>
-	class SymTensor: public SymmetricTensor<2,dim, fad_double>
+	template<unsigned int last>
+	struct unrolled_loop<last,last>
 	{
-	public:
-		SymTensor( )
+		template<typename Body>
+		static inline void run ( const Body & )
 		{
-			get_index_map<dim>( std_map_indicies );
 		}
+	};
 
-		// To simplify the access to the dofs we define a map that relate the components of our strain tensor to the dof-nbr
-	    std::map<unsigned int,std::pair<unsigned int,unsigned int>> std_map_indicies;
 
+	/*
+	 * Thread safety
+	 * The wrapper classes have no static or shared mutable state: The relation between dofs and components is given by the
+	 * constexpr tables in Sacado-dof_layout.h, and each wrapper object only holds its values, derivatives and its
+	 * \a start_index. Hence:
+	 * - All const member functions (get_tangent, get_curvature, get_value, get_values) only read the object and their
+	 *   arguments. They are reentrant and may be called concurrently, also on the same objects.
+	 * - The non-const member functions (init, set_dofs, reseed, init_set_dofs) and the DoFs_summary functions that set the
+	 *   dofs modify the objects passed in. Every thread needs its own wrapper variables, e.g. as members of the ScratchData of
+	 *   a WorkStream, where the reseed avoids the allocations for every quadrature point.
+	 * - The DoFs_summary has no data members, so it can be shared between threads.
+	 * The Sacado data types themselves are thread-safe, with the exception of Sacado::Fad::DMFad, whose memory pool is a static
+	 * member (use the thread-local PoolFad instead, see Sacado-memory_pool.h). The heap allocations of Sacado::Fad::DFad
+	 * are thread-safe, but contend for the heap with many threads.
+	 */
+
+
+	/*
+	 * The first-order wrapper classes (SymTensor, SW_double, DoFs_summary) are templated on the Sacado data type \a Number.
+	 * By default this is the dynamically sized \a fad_double, where each component allocates its derivative array on the heap.
+	 * If the total number of dofs is known at compile time, you can instead use the statically sized Sacado::Fad::SFad<double,N>
+	 * (exactly N dofs) or Sacado::Fad::SLFad<double,N> (at most N dofs), which store the derivatives on the stack
+	 * (see the aliases SymTensor_SFad, SW_double_SFad, DoFs_summary_SFad, ... below).
+	 * @note For SFad the total number of dofs set via \a set_dofs(nbr_total_dofs) must be equal to N.
+	 */
+	template <int dim, typename Number=fad_double>
+	class SymTensor: public SymmetricTensor<2,dim, Number>
+	{
+	public:
+		// The relation between the components of our strain tensor and the dof-nbr is given by the
+		// compile-time tables \a index_i, \a index_j and \a voigt_scale (see Sacado-dof_layout.h)
 		unsigned int start_index = 0;
 		static const unsigned int n_dofs = ((dim==2)?3:6); // ToDo: Find a way to use eps.n_independent_components(); that gives ((dim==2)?3:6) for a SymmetricTensor
 
-	    void init ( SymmetricTensor<2,dim> &tensor_double );
+	    void init ( const SymmetricTensor<2,dim> &tensor_double );
 
 		void set_dofs( unsigned int nbr_total_dofs=n_dofs );
 
-		void get_tangent (SymmetricTensor<4,dim> &Tangent, SymmetricTensor<2,dim, fad_double> &sigma);
+		void reseed ( const SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs=n_dofs );
+
+		void get_tangent (SymmetricTensor<4,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma) const;
 
-		void get_tangent( SymmetricTensor<2,dim> &Tangent, fad_double &argument );
+		// Packed n_dofs x n_dofs tangent (row-major) in Voigt or Mandel notation
+		 void get_tangent ( double *Tangent, const SymmetricTensor<2,dim, Number> &sigma, const enum_packing packing=voigt ) const;
+		 void get_tangent ( FullMatrix<double> &Tangent, const SymmetricTensor<2,dim, Number> &sigma, const enum_packing packing=voigt ) const;
+
+		void get_tangent( SymmetricTensor<2,dim> &Tangent, const Number &argument ) const;
 		
-		void get_values ( SymmetricTensor<2,dim> &tensor_double );
+		void get_values ( SymmetricTensor<2,dim> &tensor_double ) const;
+
+		SymmetricTensor<2,dim> get_value () const;
 
-		SymmetricTensor<2,dim> get_value ();
+		// For SIMD data types (Number=Sacado::Fad::SFad<VectorizedArray<double>,N>, see Sacado-vectorized_array.h), where each
+		// component holds the values of several quadrature points: Initialise and extract the quadrature point \a lane
+		 void init ( const SymmetricTensor<2,dim> &tensor_double, const unsigned int lane );
+		 void get_tangent ( SymmetricTensor<4,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma, const unsigned int lane ) const;
+		 void get_tangent ( SymmetricTensor<2,dim> &Tangent, const Number &argument, const unsigned int lane ) const;
+		 SymmetricTensor<2,dim> get_value ( const unsigned int lane ) const;
 	};
 
 
 	/*
 	 * Initialization of the SymTensor data type with the values from a normal double SymmetricTensor
 	 */
-	template<int dim>
-	void SymTensor<dim>::init( SymmetricTensor<2,dim> &tensor_double )
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::init( const SymmetricTensor<2,dim> &tensor_double )
 	{
-		 for ( unsigned int i=0; i<dim; ++i)
-			for ( unsigned int j=0; j<dim; ++j )
-				(*this)[i][j] = tensor_double[i][j];
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			(*this)[index_i<dim>(x)][index_j<dim>(x)] = tensor_double[index_i<dim>(x)][index_j<dim>(x)];
+		});
 	}
 	
 	
 	/*
 	 * Set the dofs as the components of the SymTensor data type
 	 */
-	template<int dim>
-	void SymTensor<dim>::set_dofs( unsigned int nbr_total_dofs )
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::set_dofs( unsigned int nbr_total_dofs )
 	{
-		// Instead of calling the *.diff(*) on the components one-by-one we could also use the following for-loop, so
-		// we also use the map to set the dofs
-		for ( unsigned int x=start_index; x<(start_index+n_dofs); ++x )
+		// Instead of calling the *.diff(*) on the components one-by-one we could also use the following loop, so
+		// we also use the index tables to set the dofs
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
 		{
-			unsigned int i=std_map_indicies[x].first;
-			unsigned int j=std_map_indicies[x].second;
-			(*this)[i][j].diff(x,nbr_total_dofs);
-		}
+			(*this)[index_i<dim>(x)][index_j<dim>(x)].diff( start_index+x, nbr_total_dofs );
+		});
+	}
+
+
+	/*
+	 * Reseed the object in place: The values are overwritten by \a tensor_double and the derivative arrays are reset
+	 * to the unit vectors (identical to \a init followed by \a set_dofs). In contrast to a new object at every quadrature point,
+	 * the derivative arrays of this object are reused. So after the first call (warm-up) the reseed itself does not
+	 * allocate on the heap, also for the dynamically sized DFad, as long as \a nbr_total_dofs does not grow.
+	 * @note This does not make the evaluation of the material model allocation-free: Every temporary DFad variable in the
+	 * model (e.g. trace(eps), deviator(eps) or eps² in the models of benchmark_models.h) still allocates its own derivative
+	 * array. Only models that assign a single expression into preallocated variables, or the statically sized SFad, avoid
+	 * these allocations (see benchmark_reseed.cc for the counts).
+	 * @code
+	 * 	Sacado_Wrapper::SymTensor<dim> eps;	// once per cell or thread
+	 * 	for ( unsigned int qp=0; qp<n_q_points; ++qp )
+	 * 	{
+	 * 		eps.reseed(eps_d[qp]);
+	 * 		...
+	 * 	}
+	 * @endcode
+	 */
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::reseed( const SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs )
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			Number &component = (*this)[index_i<dim>(x)][index_j<dim>(x)];
+			component.val() = tensor_double[index_i<dim>(x)][index_j<dim>(x)];
+			component.diff( start_index+x, nbr_total_dofs ); // only (re)allocates if the derivative array is too small
+		});
 	}
 
 
@@ -125,60 +230,78 @@ namespace Sacado_Wrapper
 	 * @param Tangent The desired tangent that will be computed as d_sigma/d_this, where "this" could be your strain tensor
 	 * @param sigma The input argument used to extract the derivatives
 	 */
-	template<int dim>
-	void SymTensor<dim>::get_tangent( SymmetricTensor<4,dim> &Tangent, SymmetricTensor<2,dim, fad_double> &sigma )
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_tangent( SymmetricTensor<4,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma ) const
 	{
-		for ( unsigned int i=0; i<dim; ++i)
-			for ( unsigned int j=0; j<dim; ++j )
+		// We only loop over the independent components (i,j) of \a sigma and (k,l) of the dofs, because the SymmetricTensor
+		// \a Tangent stores the components [i][j][k][l], [j][i][k][l], [i][j][l][k] and [j][i][l][k] only once.
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			const double *derivs = &sigma[index_i<dim>(y)][index_j<dim>(y)].fastAccessDx(start_index); // Access the derivatives of the (i,j)-th component of \a sigma
+
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
 			{
-				double *derivs = &sigma[i][j].fastAccessDx(0); // Access the derivatives of the (i,j)-th component of \a sigma
-
-	            // We loop over all the dofs. To be able to use this independent of the chosen dimension \a dim, we use a ternary operator
-	            // to decide whether we have to loop over 6 derivatives or just 3.
-	            for(unsigned int x=start_index;x<(start_index+n_dofs);++x)
-	            {
-	                unsigned int k=std_map_indicies[x].first;
-	                unsigned int l=std_map_indicies[x].second;
-
-	                if(k!=l)/*Compare to Voigt notation since only SymmetricTensor instead of Tensor*/
-	                {
-	                    Tangent[i][j][k][l] = 0.5*derivs[x];
-	                    Tangent[i][j][l][k] = 0.5*derivs[x];
-	                }
-	                else
-	                	Tangent[i][j][k][l] = derivs[x];
-	            }
-			}
+				// Compare to Voigt notation since only SymmetricTensor instead of Tensor
+				Tangent[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * derivs[x];
+			});
+		});
 	}
 
-	template<int dim>
-	void SymTensor<dim>::get_tangent( SymmetricTensor<2,dim> &Tangent, fad_double &argument )
+	/*
+	 * Write the tangent d_sigma/d_this row by row into the contiguous buffer \a Tangent (n_dofs*n_dofs entries, row-major)
+	 * in Voigt or Mandel notation, without any intermediate tensor. Each row is filled from the derivative array of one
+	 * component of \a sigma in a single pass.
+	 * @note \a sigma must be symmetric, because only its independent components are read.
+	 */
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_tangent( double *Tangent, const SymmetricTensor<2,dim, Number> &sigma, const enum_packing packing ) const
 	{
-		double *derivs = &argument.fastAccessDx(0); // Access derivatives
-		for(unsigned int x=start_index;x<(start_index+n_dofs);++x)
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
 		{
-			unsigned int k=std_map_indicies[x].first;
-			unsigned int l=std_map_indicies[x].second;
+			const double *derivs = &sigma[index_i<dim>(y)][index_j<dim>(y)].fastAccessDx(start_index);
+			double *row = Tangent + voigt_index<dim>(y) * n_dofs;
+			const double row_weight = packing_weight<dim>(y,packing);
 
-        	Tangent[k][l] = derivs[x]; // ToDo: check whether the 0.5* is necessary here too
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+			{
+				row[ voigt_index<dim>(x) ] = row_weight * packing_weight<dim>(x,packing) * voigt_scale<dim>(x) * derivs[x];
+			});
+		});
+	}
 
-        	// Correct the off-diagonal terms by the factor of 0.5
-             if(k!=l)/*Compare to Voigt notation since only SymmetricTensor instead of Tensor*/
-            	Tangent[k][l] *= 0.5; // ToDo: check whether the 0.5* is necessary here too
-		}
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_tangent( FullMatrix<double> &Tangent, const SymmetricTensor<2,dim, Number> &sigma, const enum_packing packing ) const
+	{
+		AssertThrow( Tangent.m()==n_dofs && Tangent.n()==n_dofs, ExcMessage("SymTensor::get_tangent: The FullMatrix must be of size n_dofs x n_dofs.") );
+		// The entries of the FullMatrix are stored contiguously row by row
+		 (*this).get_tangent( &Tangent(0,0), sigma, packing );
 	}
 
 
-	template<int dim>
-	void SymTensor<dim>::get_values ( SymmetricTensor<2,dim> &tensor_double )
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_tangent( SymmetricTensor<2,dim> &Tangent, const Number &argument ) const
 	{
-		for ( unsigned int i=0; i<dim; ++i)
-			for ( unsigned int j=0; j<dim; ++j )
-				tensor_double[i][j] = ((*this)[i][j]).val();
+		const double *derivs = &argument.fastAccessDx(start_index); // Access derivatives
+
+		// Correct the off-diagonal terms by the factor of 0.5 (see \ref Ex9 "example 9")
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			Tangent[index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * derivs[x];
+		});
 	}
 
-	template<int dim>
-	SymmetricTensor<2,dim> SymTensor<dim>::get_value ()
+
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_values ( SymmetricTensor<2,dim> &tensor_double ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			tensor_double[index_i<dim>(x)][index_j<dim>(x)] = ((*this)[index_i<dim>(x)][index_j<dim>(x)]).val();
+		});
+	}
+
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim> SymTensor<dim,Number>::get_value () const
 	{
 		SymmetricTensor<2,dim> tmp;
 		(*this).get_values(tmp);
@@ -186,35 +309,266 @@ namespace Sacado_Wrapper
 	}
 
 
+	/*
+	 * Set the values of the quadrature point \a lane of a SIMD data type, e.g. for all lanes before \a set_dofs:
+	 * @code
+	 * 	for ( unsigned int lane=0; lane<Sacado_Wrapper::n_lanes; ++lane )
+	 * 		eps.init( eps_d[qp+lane], lane );
+	 * 	eps.set_dofs();
+	 * @endcode
+	 */
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::init( const SymmetricTensor<2,dim> &tensor_double, const unsigned int lane )
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			(*this)[index_i<dim>(x)][index_j<dim>(x)].val()[lane] = tensor_double[index_i<dim>(x)][index_j<dim>(x)];
+		});
+	}
+
+	/*
+	 * The tangent d_sigma/d_this of the quadrature point \a lane of a SIMD data type (see get_tangent above)
+	 */
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_tangent( SymmetricTensor<4,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma, const unsigned int lane ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			const Number &sigma_y = sigma[index_i<dim>(y)][index_j<dim>(y)];
+
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+			{
+				Tangent[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * sigma_y.fastAccessDx(start_index+x)[lane];
+			});
+		});
+	}
+
+	template<int dim, typename Number>
+	void SymTensor<dim,Number>::get_tangent( SymmetricTensor<2,dim> &Tangent, const Number &argument, const unsigned int lane ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			Tangent[index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * argument.fastAccessDx(start_index+x)[lane];
+		});
+	}
+
+	template<int dim, typename Number>
+	SymmetricTensor<2,dim> SymTensor<dim,Number>::get_value ( const unsigned int lane ) const
+	{
+		SymmetricTensor<2,dim> tmp;
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			tmp[index_i<dim>(x)][index_j<dim>(x)] = ((*this)[index_i<dim>(x)][index_j<dim>(x)]).val()[lane];
+		});
+		return tmp;
+	}
+
+
 	//###########################################################################################################//
 
 		 
-	template <int dim>
-	class SymTensor2: public SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> >
+	/*
+	 * Compact storage of a third-order derivative d2_argument/d_eps_d_eps of a symmetric tensor \a argument with respect
+	 * to a symmetric tensor \a eps (e.g. the Hencky strain with respect to the right Cauchy-Green tensor).
+	 * Compared to a Tensor<6,dim> (729 entries in 3D) only the n_dofs^3 = 6x6x6 components that are independent due to
+	 * the minor symmetries in (ij), (kl) and (op) are stored (27 instead of 64 in 2D). The components are addressed as
+	 * Curvature(i,j,k,l,o,p) = d2_argument[o][p] / d_eps[i][j] d_eps[k][l] (same order as the Tensor<6,dim> before),
+	 * which already contains the factors of 0.5 for the off-diagonal components.
+	 * Use the contraction helpers to avoid ever materialising the Tensor<6,dim>.
+	 */
+	template<int dim>
+	class SymCurvature
 	{
 	public:
-		SymTensor2( )
+		static const unsigned int n_dofs = ((dim==2)?3:6);
+
+		SymCurvature ()
 		{
-			get_index_map<dim>( std_map_indicies );
+			for ( unsigned int y=0; y<n_dofs; ++y )
+				for ( unsigned int x=0; x<n_dofs; ++x )
+					for ( unsigned int a=0; a<n_dofs; ++a )
+						values[y][x][a] = 0.;
 		}
 
-		// To simplify the access to the dofs we define a map that relate the components of our strain tensor to the dof-nbr
-		std::map<unsigned int,std::pair<unsigned int,unsigned int>> std_map_indicies;
+		// Access via the dof-nbrs y=(i,j), x=(k,l) and a=(o,p)
+		 double &operator() ( const unsigned int y, const unsigned int x, const unsigned int a )
+		 {
+			 return values[y][x][a];
+		 }
+		 const double &operator() ( const unsigned int y, const unsigned int x, const unsigned int a ) const
+		 {
+			 return values[y][x][a];
+		 }
+
+		// Access via the tensor indices, as for the Tensor<6,dim>
+		 double operator() ( const unsigned int i, const unsigned int j, const unsigned int k, const unsigned int l,
+				 	 	 	 const unsigned int o, const unsigned int p ) const
+		 {
+			 return values[dof_index<dim>(i,j)][dof_index<dim>(k,l)][dof_index<dim>(o,p)];
+		 }
+
+		// R_ijkl = Curvature_ijklop * T_op, e.g. T : d2_H/d_C2 for the chain rule of an energy Psi(H(C))
+		 SymmetricTensor<4,dim> contract_argument ( const SymmetricTensor<2,dim> &T ) const;
 
+		// R_ijop = Curvature_ijklop * dE_kl, the change of the tangent d_argument/d_eps in the direction dE
+		 SymmetricTensor<4,dim> contract_direction ( const SymmetricTensor<2,dim> &dE ) const;
+
+		// The full Tensor<6,dim> (only for output and comparisons)
+		 Tensor<6,dim> to_tensor () const;
+
+	private:
+		double values[n_dofs][n_dofs][n_dofs];
+	};
+
+	template<int dim>
+	SymmetricTensor<4,dim> SymCurvature<dim>::contract_argument ( const SymmetricTensor<2,dim> &T ) const
+	{
+		// The off-diagonal components (o,p) and (p,o) are stored once, but appear twice in the sum
+		 double T_packed[n_dofs];
+		 unrolled_loop<0,n_dofs>::run( [&] (const unsigned int a)
+		 {
+			 T_packed[a] = T[index_i<dim>(a)][index_j<dim>(a)] / voigt_scale<dim>(a);
+		 });
+
+		SymmetricTensor<4,dim> R;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int x=0; x<n_dofs; ++x )
+			{
+				double sum = 0.;
+				for ( unsigned int a=0; a<n_dofs; ++a )
+					sum += values[y][x][a] * T_packed[a];
+				R[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(x)][index_j<dim>(x)] = sum;
+			}
+		return R;
+	}
+
+	template<int dim>
+	SymmetricTensor<4,dim> SymCurvature<dim>::contract_direction ( const SymmetricTensor<2,dim> &dE ) const
+	{
+		double dE_packed[n_dofs];
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			dE_packed[x] = dE[index_i<dim>(x)][index_j<dim>(x)] / voigt_scale<dim>(x);
+		});
+
+		SymmetricTensor<4,dim> R;
+		for ( unsigned int y=0; y<n_dofs; ++y )
+			for ( unsigned int a=0; a<n_dofs; ++a )
+			{
+				double sum = 0.;
+				for ( unsigned int x=0; x<n_dofs; ++x )
+					sum += values[y][x][a] * dE_packed[x];
+				R[index_i<dim>(y)][index_j<dim>(y)][index_i<dim>(a)][index_j<dim>(a)] = sum;
+			}
+		return R;
+	}
+
+	template<int dim>
+	Tensor<6,dim> SymCurvature<dim>::to_tensor () const
+	{
+		Tensor<6,dim> Curvature;
+		for ( unsigned int i=0; i<dim; ++i )
+		 for ( unsigned int j=0; j<dim; ++j )
+		  for ( unsigned int k=0; k<dim; ++k )
+		   for ( unsigned int l=0; l<dim; ++l )
+			for ( unsigned int o=0; o<dim; ++o )
+			 for ( unsigned int p=0; p<dim; ++p )
+				Curvature[i][j][k][l][o][p] = (*this)(i,j,k,l,o,p);
+		return Curvature;
+	}
+
+	template<int dim>
+	std::ostream &operator<< ( std::ostream &out, const SymCurvature<dim> &Curvature )
+	{
+		for ( unsigned int y=0; y<SymCurvature<dim>::n_dofs; ++y )
+			for ( unsigned int x=0; x<SymCurvature<dim>::n_dofs; ++x )
+				for ( unsigned int a=0; a<SymCurvature<dim>::n_dofs; ++a )
+					out << Curvature(y,x,a) << ' ';
+		return out;
+	}
+
+
+	//###########################################################################################################//
+
+
+	/*
+	 * Accessors for the second-order data types, such that the second-order wrapper classes do not depend on the
+	 * nesting of the Sacado data types (\a Number2::value_type holding the "inner" derivatives). Other second-order
+	 * number types provide their own overloads of these functions in the namespace Sacado_Wrapper
+	 * (e.g. HyperDual<N> in Sacado-hyper_dual.h), which are found via argument-dependent lookup.
+	 * @note Pass the base class \a Number2 and not a derived wrapper class (e.g. SW_double2), otherwise these generic
+	 * templates are the better match.
+	 */
+	 // Value of the second-order variable \a argument
+	 template<typename Number2>
+	 inline double value2 ( const Number2 &argument )
+	 {
+		return argument.val().val();
+	 }
+
+	 // First derivative d_argument/d_x with respect to the x-th dof
+	 template<typename Number2>
+	 inline double d_dx ( const Number2 &argument, const unsigned int x )
+	 {
+		return argument.dx(x).val();
+	 }
+
+	 // Second derivative d2_argument/d_x_d_y
+	 template<typename Number2>
+	 inline double d2_dxdy ( const Number2 &argument, const unsigned int x, const unsigned int y )
+	 {
+		return argument.dx(x).dx(y);
+	 }
+
+	 // Set the value of \a variable and declare it as the \a dof-th of \a nbr_total_dofs dofs for the "inner" and "outer" derivatives
+	 template<typename Number2>
+	 inline void seed2 ( Number2 &variable, const double value, const unsigned int dof, const unsigned int nbr_total_dofs )
+	 {
+		variable.diff( dof, nbr_total_dofs );	// set up the "inner" derivatives
+		variable.val().val() = value;
+		variable.val().diff( dof, nbr_total_dofs ); // set up the "outer" derivatives
+	 }
+
+
+	/*
+	 * The second-order wrapper classes (SymTensor2, SW_double2) are templated on the nested Sacado data type \a Number2,
+	 * e.g. Sacado::Fad::DFad<DFadType> (default) or Sacado::Fad::SFad<Sacado::Fad::SFad<double,N>,N>, or any other
+	 * second-order number type with the accessors value2, d_dx, d2_dxdy and seed2 (e.g. HyperDual<N>).
+	 * @note The functions that return the first derivatives as second-order variables (SymTensor2::get_tangent into
+	 * SymmetricTensor<2,dim,Number2> and the respective SW_double2::get_curvature) rely on the nested Sacado data types.
+	 */
+	template <int dim, typename Number2=Sacado::Fad::DFad<DFadType> >
+	class SymTensor2: public SymmetricTensor<2,dim, Number2 >
+	{
+	public:
+		// The relation between the components and the dof-nbr is given by the compile-time tables (see Sacado-dof_layout.h)
 		unsigned int start_index = 0;
 		static const unsigned int n_dofs = ((dim==2)?3:6); // ToDo: Find a way to use eps.n_independent_components(); that gives ((dim==2)?3:6) for a SymmetricTensor
 
-		void init_set_dofs ( SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs=n_dofs );
+		void init_set_dofs ( const SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs=n_dofs );
+
+		// The same in two steps (e.g. for DoFs_summary.set_dofs(*))
+		 void init ( const SymmetricTensor<2,dim> &tensor_double );
+		 void set_dofs ( const unsigned int nbr_total_dofs=n_dofs );
+
+		void reseed ( const SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs=n_dofs );
 
-		void get_tangent (SymmetricTensor<4,dim> &Tangent, SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &sigma);
+		void get_tangent (SymmetricTensor<4,dim> &Tangent, const SymmetricTensor<2,dim, Number2 > &sigma) const;
 
-		void get_tangent( SymmetricTensor<2,dim> &Tangent, Sacado::Fad::DFad<DFadType> &argument );
+		void get_tangent( SymmetricTensor<2,dim> &Tangent, const Number2 &argument ) const;
 		
-		void get_tangent( SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &Tangent, Sacado::Fad::DFad<DFadType> &argument );
+		void get_tangent( SymmetricTensor<2,dim, Number2 > &Tangent, const Number2 &argument ) const;
 		
-		void get_curvature( SymmetricTensor<4,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument );
+		void get_curvature( SymmetricTensor<4,dim> &Curvature, const Number2 &argument ) const;
+
+		// Packed n_dofs x n_dofs Hessian (row-major) in Voigt or Mandel notation
+		 void get_curvature( double *Curvature, const Number2 &argument, const enum_packing packing=voigt ) const;
+		 void get_curvature( FullMatrix<double> &Curvature, const Number2 &argument, const enum_packing packing=voigt ) const;
+
+		void get_curvature( SymCurvature<dim> &Curvature, const SymmetricTensor<2,dim,Number2 > &argument ) const;
 
-		void get_curvature( Tensor<6,dim> &Curvature, SymmetricTensor<2,dim,Sacado::Fad::DFad<DFadType> > &argument );
+		// The same as a full Tensor<6,dim> (use the compact SymCurvature instead)
+		 void get_curvature( Tensor<6,dim> &Curvature, const SymmetricTensor<2,dim,Number2 > &argument ) const;
 		
 //			
 //		void get_values ( SymmetricTensor<2,dim> &tensor_double );
@@ -223,127 +577,173 @@ namespace Sacado_Wrapper
 	/*
 	 * Initialization of the \a SymTensor2 data type with the values from a normal double \a SymmetricTensor
 	 */
-	template<int dim>
-	void SymTensor2<dim>::init_set_dofs( SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs )
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::init_set_dofs( const SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs )
 	{
-		 for ( unsigned int x=0; x<n_dofs; ++x )
-		 {
-		 	unsigned int i=std_map_indicies[x].first;
-		 	unsigned int j=std_map_indicies[x].second;
-			((*this)[i][j]).diff( x, nbr_total_dofs);	// set up the "inner" derivatives
-			((*this)[i][j]).val() = fad_double(nbr_total_dofs, x, tensor_double[i][j]); // set up the "outer" derivatives
-		 }
+		(*this).reseed( tensor_double, nbr_total_dofs );
 	}
 	
 	
-	template<int dim>
-	void SymTensor2<dim>::get_tangent( SymmetricTensor<2,dim> &Tangent, Sacado::Fad::DFad<DFadType> &argument )
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::init( const SymmetricTensor<2,dim> &tensor_double )
 	{
-		for ( unsigned int x=0; x<n_dofs; ++x )
-		 {
-			unsigned int i=std_map_indicies[x].first;
-			unsigned int j=std_map_indicies[x].second;
-			if ( i!=j )
-				Tangent[i][j] = 0.5 * argument.dx(x).val();
-			else
-				Tangent[i][j] = argument.dx(x).val();
-		 }
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			(*this)[index_i<dim>(x)][index_j<dim>(x)] = tensor_double[index_i<dim>(x)][index_j<dim>(x)];
+		});
+	}
+
+	/*
+	 * Set the dofs with the values that were set via \a init
+	 */
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::set_dofs( const unsigned int nbr_total_dofs )
+	{
+		SymmetricTensor<2,dim> tensor_double;
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			tensor_double[index_i<dim>(x)][index_j<dim>(x)] = value2( (*this)[index_i<dim>(x)][index_j<dim>(x)] );
+		});
+		(*this).reseed( tensor_double, nbr_total_dofs );
+	}
+
+
+	/*
+	 * Reseed the object in place (see SymTensor::reseed), the "inner" and "outer" derivatives are reset without
+	 * constructing temporary Sacado variables
+	 */
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::reseed( const SymmetricTensor<2,dim> &tensor_double, const unsigned int nbr_total_dofs )
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			seed2( (*this)[index_i<dim>(x)][index_j<dim>(x)], tensor_double[index_i<dim>(x)][index_j<dim>(x)], start_index+x, nbr_total_dofs );
+		});
+	}
+
+
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_tangent( SymmetricTensor<2,dim> &Tangent, const Number2 &argument ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			Tangent[index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * d_dx( argument, start_index+x );
+		});
 	}
 	
-	template<int dim>
-	void SymTensor2<dim>::get_tangent( SymmetricTensor<4,dim> &Tangent, SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &argument )
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_tangent( SymmetricTensor<4,dim> &Tangent, const SymmetricTensor<2,dim, Number2 > &argument ) const
 	{
-		 for(unsigned int x=0;x<n_dofs;++x)
-			for(unsigned int y=0;y<n_dofs;++y)
+		// Tangent[i][j][k][l] = d_argument[i][j] / d_this[k][l] with the factor 0.5 for the off-diagonal dofs (k,l),
+		// identical to SymTensor::get_tangent
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			const unsigned int i=index_i<dim>(y);
+			const unsigned int j=index_j<dim>(y);
+
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
 			{
-				const unsigned int i=std_map_indicies[y].first;
-				const unsigned int j=std_map_indicies[y].second;
-				const unsigned int k=std_map_indicies[x].first;
-				const unsigned int l=std_map_indicies[x].second;
-
-				if(k!=l)/*Compare to Voigt notation since only SymmetricTensor instead of Tensor*/
-					Tangent[i][j][k][l] = 0.5 * argument[k][l].dx(y).val();		// ToDo: check this on paper (was more like a gut feeling)
-				else
-					Tangent[i][j][k][l] = argument[k][l].dx(y).val();
-			}
+				Tangent[i][j][index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * d_dx( argument[i][j], start_index+x );
+			});
+		});
 	}
 
 
 	/*
 	 * Compute the tangent still containing all the second derivatives
 	 */
-	template<int dim>
-	void SymTensor2<dim>::get_tangent( SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &Tangent, Sacado::Fad::DFad<DFadType> &argument )
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_tangent( SymmetricTensor<2,dim, Number2 > &Tangent, const Number2 &argument ) const
 	{
-		for ( unsigned int x=0; x<n_dofs; ++x )
-		 {
-			unsigned int i=std_map_indicies[x].first;
-			unsigned int j=std_map_indicies[x].second;
-			if ( i!=j )
-				Tangent[i][j] = 0.5 * argument.dx(x);
-			else
-				Tangent[i][j] = argument.dx(x);
-		 }
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			Tangent[index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * argument.dx(start_index+x);
+		});
 	}
 	
 	
-	template<int dim>
-	void SymTensor2<dim>::get_curvature( SymmetricTensor<4,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument )
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_curvature( SymmetricTensor<4,dim> &Curvature, const Number2 &argument ) const
 	{
-		 for(unsigned int x=0;x<n_dofs;++x)
-			for(unsigned int y=0;y<n_dofs;++y)
-			{
-				const unsigned int i=std_map_indicies[y].first;
-				const unsigned int j=std_map_indicies[y].second;
-				const unsigned int k=std_map_indicies[x].first;
-				const unsigned int l=std_map_indicies[x].second;
+		// The second derivative of the scalar \a argument (e.g. an energy) is a Hessian and thus major-symmetric.
+		// Hence, we only read the upper triangle x>=y (21 of 36 entries in 3D) and mirror it, because the
+		// SymmetricTensor<4,dim> only exploits the minor symmetries and stores [i][j][k][l] and [k][l][i][j] separately.
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			const unsigned int i=index_i<dim>(y);
+			const unsigned int j=index_j<dim>(y);
 
-				double deriv = argument.dx(x).dx(y); // Access the derivatives of the (i,j)-th component of \a sigma
+			for ( unsigned int x=y; x<n_dofs; ++x )
+			{
+				const unsigned int k=index_i<dim>(x);
+				const unsigned int l=index_j<dim>(x);
 
-				if ( k!=l && i!=j )
-					Curvature[i][j][k][l] = 0.25* deriv;
-				else if(k!=l)/*Compare to Voigt notation since only SymmetricTensor instead of Tensor*/
-				{
-					Curvature[i][j][k][l] = 0.5*deriv;
-					Curvature[i][j][l][k] = 0.5*deriv;
-				}
-				else
-					Curvature[i][j][k][l] = deriv;
+				// The factors 1, 0.5 and 0.25 follow from the product of the scaling of both dofs
+				Curvature[i][j][k][l] = voigt_scale<dim>(y) * voigt_scale<dim>(x) * d2_dxdy( argument, start_index+y, start_index+x );
+				Curvature[k][l][i][j] = Curvature[i][j][k][l];
 			}
+		});
 	}
 	
 	
-	template<int dim>
-	void SymTensor2<dim>::get_curvature( Tensor<6,dim> &Curvature, SymmetricTensor<2,dim,Sacado::Fad::DFad<DFadType> > &argument )
+	/*
+	 * Write the second derivatives of the scalar \a argument (e.g. the energy) into the contiguous buffer \a Curvature
+	 * (n_dofs*n_dofs entries, row-major) in Voigt or Mandel notation (see SymTensor::get_tangent)
+	 */
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_curvature( double *Curvature, const Number2 &argument, const enum_packing packing ) const
 	{
-		std::cout << "For some reason we cannot use SymmetricTensor<6,dim>" << std::endl;
-		std::cout << "ToDo: check o-p indices for symmetry etc" << std::endl;
+		// Upper triangle only, mirrored (see get_curvature for the SymmetricTensor<4,dim>)
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			const unsigned int row = voigt_index<dim>(y);
+			const double row_factor = packing_weight<dim>(y,packing) * voigt_scale<dim>(y);
 
-		 for(unsigned int x=0;x<n_dofs;++x)
-			for(unsigned int y=0;y<n_dofs;++y)
+			for ( unsigned int x=y; x<n_dofs; ++x )
 			{
-				const unsigned int i=std_map_indicies[y].first;
-				const unsigned int j=std_map_indicies[y].second;
-				const unsigned int k=std_map_indicies[x].first;
-				const unsigned int l=std_map_indicies[x].second;
-
-				 for(unsigned int o=0; o<3; ++o )
-					 for(unsigned int p=0; p<3; ++p )
-					 {
-						double deriv = argument[o][p].dx(x).dx(y); // Access the derivatives of the (i,j)-th component of \a sigma
-		
-						
-						if ( k!=l && i!=j )
-							Curvature[i][j][k][l][o][p] = 0.25* deriv;
-						else if(k!=l)/*Compare to Voigt notation since only SymmetricTensor instead of Tensor*/
-						{
-							Curvature[i][j][k][l][o][p] = 0.5*deriv;
-							Curvature[i][j][l][k][o][p] = 0.5*deriv;
-						}
-						else
-							Curvature[i][j][k][l][o][p] = deriv;
-					 }
+				const unsigned int col = voigt_index<dim>(x);
+				Curvature[row*n_dofs+col] = row_factor * packing_weight<dim>(x,packing) * voigt_scale<dim>(x) * d2_dxdy( argument, start_index+y, start_index+x );
+				Curvature[col*n_dofs+row] = Curvature[row*n_dofs+col];
 			}
+		});
+	}
+
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_curvature( FullMatrix<double> &Curvature, const Number2 &argument, const enum_packing packing ) const
+	{
+		AssertThrow( Curvature.m()==n_dofs && Curvature.n()==n_dofs, ExcMessage("SymTensor2::get_curvature: The FullMatrix must be of size n_dofs x n_dofs.") );
+		(*this).get_curvature( &Curvature(0,0), argument, packing );
+	}
+
+
+	/*
+	 * Compute the third-order derivative d2_argument/d_this_d_this in the compact storage SymCurvature,
+	 * writing each of the n_dofs^3 independent components once
+	 */
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_curvature( SymCurvature<dim> &Curvature, const SymmetricTensor<2,dim,Number2 > &argument ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int a)
+		{
+			// Access the derivatives of the (o,p)-th component of \a argument
+			 const Number2 &argument_op = argument[index_i<dim>(a)][index_j<dim>(a)];
+
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+			{
+				unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+				{
+					Curvature(y,x,a) = voigt_scale<dim>(y) * voigt_scale<dim>(x) * d2_dxdy( argument_op, start_index+x, start_index+y );
+				});
+			});
+		});
+	}
+
+	template<int dim, typename Number2>
+	void SymTensor2<dim,Number2>::get_curvature( Tensor<6,dim> &Curvature, const SymmetricTensor<2,dim,Number2 > &argument ) const
+	{
+		SymCurvature<dim> Curvature_compact;
+		(*this).get_curvature( Curvature_compact, argument );
+		Curvature = Curvature_compact.to_tensor();
 	}
 	
 	//###########################################################################################################//
@@ -351,10 +751,10 @@ namespace Sacado_Wrapper
 		
 		
 	/*
-	 * The same as the class above, just for data type fad_double
+	 * The same as the class above, just for data type fad_double (or any other first-order Sacado data type \a Number)
 	 */
-	template<int dim>
-	class SW_double: public fad_double
+	template<int dim, typename Number=fad_double>
+	class SW_double: public Number
 	{
 	public:
 //		SW_double( double &sdf );
@@ -366,8 +766,8 @@ namespace Sacado_Wrapper
 		// Assignment operator: \n
 		// According to https://stackoverflow.com/questions/31029007/c-assignment-operator-in-derived-class
 		// the operator= is not derived from the base class fad_double and needs to be set explicitly:
-		SW_double & operator=(double double_init) { fad_double::operator =( double_init ) ;return *this;}
-		SW_double & operator=(fad_double fad_assignment) { fad_double::operator =( fad_assignment ) ;return *this;}
+		SW_double & operator=(double double_init) { Number::operator =( double_init ) ;return *this;}
+		SW_double & operator=(Number fad_assignment) { Number::operator =( fad_assignment ) ;return *this;}
 
 		static const unsigned int n_dofs = 1; // a double is just a single number, so it represents a single dof
 		unsigned int start_index = 0;
@@ -376,59 +776,203 @@ namespace Sacado_Wrapper
 
 		void set_dofs ( unsigned int nbr_total_dofs=n_dofs );
 
-		void get_tangent (SymmetricTensor<2,dim> &Tangent, SymmetricTensor<2,dim, fad_double> &sigma);
+		void reseed ( const double &double_init, const unsigned int nbr_total_dofs=n_dofs );
+
+		void get_tangent (SymmetricTensor<2,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma) const;
 
-		void get_tangent ( double &Tangent, fad_double &argument );
+		void get_tangent ( double &Tangent, const Number &argument ) const;
 		
-		void get_values ( double &return_double );
+		void get_values ( double &return_double ) const;
+
+		// The quadrature point \a lane of a SIMD data type (see SymTensor)
+		 void init ( const double &double_init, const unsigned int lane );
+		 void get_tangent ( SymmetricTensor<2,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma, const unsigned int lane ) const;
+		 void get_tangent ( double &Tangent, const Number &argument, const unsigned int lane ) const;
 	};
 
-	template<int dim>
-	void SW_double<dim>::init ( const double &double_init )
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::init ( const double &double_init )
 	{
 		(*this) = double_init;
 	}
 
-	template<int dim>
-	void SW_double<dim>::set_dofs ( unsigned int nbr_total_dofs )
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::set_dofs ( unsigned int nbr_total_dofs )
 	{
 		(*this).diff( this->start_index, nbr_total_dofs );
 	}
 
-	template<int dim>
-	void SW_double<dim>::get_tangent (SymmetricTensor<2,dim> &Tangent, SymmetricTensor<2,dim, fad_double> &sigma)
+	/*
+	 * Reseed the object in place (see SymTensor::reseed)
+	 */
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::reseed ( const double &double_init, const unsigned int nbr_total_dofs )
+	{
+		(*this).val() = double_init;
+		(*this).diff( this->start_index, nbr_total_dofs );
+	}
+
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::get_tangent (SymmetricTensor<2,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma) const
 	{
 		// reassemble the tangent as a SECOND order tensor
-		 for ( unsigned int i=0; i<dim; ++i)
-			for ( unsigned int j=0; j<dim; ++j )
-			{
-				double *derivs = &sigma[i][j].fastAccessDx(0); // Access derivatives
-				Tangent[i][j] = derivs[ this->start_index ]; // ToDo: check whether the 0.5* is necessary here too
-			}
+		// (the derivative with respect to the scalar dof needs no Voigt scaling, so only the independent components are copied)
+		 unrolled_loop<0,SymTensor<dim,Number>::n_dofs>::run( [&] (const unsigned int x)
+		 {
+			Tangent[index_i<dim>(x)][index_j<dim>(x)] = sigma[index_i<dim>(x)][index_j<dim>(x)].fastAccessDx( this->start_index );
+		 });
 	}
 
-	template<int dim>
-	void SW_double<dim>::get_tangent ( double &Tangent, fad_double &argument )
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::get_tangent ( double &Tangent, const Number &argument ) const
 	{
-		 double *derivs = &argument.fastAccessDx(0);
+		 const double *derivs = &argument.fastAccessDx(0);
 		 Tangent = derivs[ this->start_index ];
 	}
 
-	template<int dim>
-	void SW_double<dim>::get_values ( double &return_double )
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::get_values ( double &return_double ) const
 	{
 		return_double = (*this).val();
 	}
 
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::init ( const double &double_init, const unsigned int lane )
+	{
+		(*this).val()[lane] = double_init;
+	}
+
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::get_tangent ( SymmetricTensor<2,dim> &Tangent, const SymmetricTensor<2,dim, Number> &sigma, const unsigned int lane ) const
+	{
+		unrolled_loop<0,SymTensor<dim,Number>::n_dofs>::run( [&] (const unsigned int x)
+		{
+			Tangent[index_i<dim>(x)][index_j<dim>(x)] = sigma[index_i<dim>(x)][index_j<dim>(x)].fastAccessDx( this->start_index )[lane];
+		});
+	}
+
+	template<int dim, typename Number>
+	void SW_double<dim,Number>::get_tangent ( double &Tangent, const Number &argument, const unsigned int lane ) const
+	{
+		Tangent = argument.fastAccessDx( this->start_index )[lane];
+	}
+
 	//###########################################################################################################//
 
 	
 
 	/*
-	 * The same as the class above, just for data type fad_double
+	 * Vector-valued dofs, e.g. a displacement-like or director field, with the \a dim components as dofs
 	 */
-	template<int dim>
-	class SW_double2: public Sacado::Fad::DFad<DFadType>
+	template<int dim, typename Number=fad_double>
+	class SW_vector: public Tensor<1,dim,Number>
+	{
+	public:
+		unsigned int start_index = 0;
+		static const unsigned int n_dofs = dim;
+
+		void init ( const Tensor<1,dim> &vector_double );
+
+		void set_dofs ( const unsigned int nbr_total_dofs=n_dofs );
+
+		void reseed ( const Tensor<1,dim> &vector_double, const unsigned int nbr_total_dofs=n_dofs );
+
+		// d_argument / d_this
+		 void get_tangent ( Tensor<1,dim> &Tangent, const Number &argument ) const;
+		 void get_tangent ( Tensor<2,dim> &Tangent, const Tensor<1,dim,Number> &argument ) const;
+		 void get_tangent ( Tensor<3,dim> &Tangent, const SymmetricTensor<2,dim,Number> &argument ) const;
+
+		void get_values ( Tensor<1,dim> &vector_double ) const;
+	};
+
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::init ( const Tensor<1,dim> &vector_double )
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			(*this)[x] = vector_double[x];
+		});
+	}
+
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::set_dofs ( const unsigned int nbr_total_dofs )
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			(*this)[x].diff( start_index+x, nbr_total_dofs );
+		});
+	}
+
+	/*
+	 * Reseed the object in place (see SymTensor::reseed)
+	 */
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::reseed ( const Tensor<1,dim> &vector_double, const unsigned int nbr_total_dofs )
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			(*this)[x].val() = vector_double[x];
+			(*this)[x].diff( start_index+x, nbr_total_dofs );
+		});
+	}
+
+	// The components of a vector are independent, so no factor of 0.5 is needed for the tangents
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::get_tangent ( Tensor<1,dim> &Tangent, const Number &argument ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			Tangent[x] = argument.fastAccessDx( start_index+x );
+		});
+	}
+
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::get_tangent ( Tensor<2,dim> &Tangent, const Tensor<1,dim,Number> &argument ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int y)
+		{
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+			{
+				Tangent[y][x] = argument[y].fastAccessDx( start_index+x );
+			});
+		});
+	}
+
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::get_tangent ( Tensor<3,dim> &Tangent, const SymmetricTensor<2,dim,Number> &argument ) const
+	{
+		unrolled_loop<0,SymTensor<dim,Number>::n_dofs>::run( [&] (const unsigned int y)
+		{
+			const unsigned int i=index_i<dim>(y);
+			const unsigned int j=index_j<dim>(y);
+
+			unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+			{
+				// Tensor<3,dim> does not know about the symmetry of \a argument, so we fill both components
+				Tangent[i][j][x] = argument[i][j].fastAccessDx( start_index+x );
+				Tangent[j][i][x] = Tangent[i][j][x];
+			});
+		});
+	}
+
+	template<int dim, typename Number>
+	void SW_vector<dim,Number>::get_values ( Tensor<1,dim> &vector_double ) const
+	{
+		unrolled_loop<0,n_dofs>::run( [&] (const unsigned int x)
+		{
+			vector_double[x] = (*this)[x].val();
+		});
+	}
+
+	//###########################################################################################################//
+
+
+
+	/*
+	 * The same as SW_double, just for the nested data type \a Number2 (default Sacado::Fad::DFad<DFadType>)
+	 */
+	template<int dim, typename Number2=Sacado::Fad::DFad<DFadType> >
+	class SW_double2: public Number2
 	{
 	public:
 //		SW_double2( double &sdf );
@@ -440,71 +984,98 @@ namespace Sacado_Wrapper
 		// Assignment operator: \n
 		// According to https://stackoverflow.com/questions/31029007/c-assignment-operator-in-derived-class
 		// the operator= is not derived from the base class fad_double and needs to be set explicitly:
-		SW_double2 & operator=(double double_init) { Sacado::Fad::DFad<DFadType>::operator =( double_init ) ;return *this;}
-		SW_double2 & operator=(Sacado::Fad::DFad<DFadType> fad_assignment) { Sacado::Fad::DFad<DFadType>::operator =( fad_assignment ) ;return *this;}
+		SW_double2 & operator=(double double_init) { Number2::operator =( double_init ) ;return *this;}
+		SW_double2 & operator=(Number2 fad_assignment) { Number2::operator =( fad_assignment ) ;return *this;}
 
 		static const unsigned int n_dofs = 1; // a double is just a single number, so it represents a single dof
 		unsigned int start_index = 0;
 
 		void init_set_dofs ( const double &double_init, unsigned int nbr_total_dofs=n_dofs );
 
-		void get_tangent (double &Tangent, Sacado::Fad::DFad<DFadType> &argument);
-		void get_tangent (SymmetricTensor<2,dim> &Tangent, SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &argument, SymTensor2<dim> &eps);
+		// The same in two steps (e.g. for DoFs_summary.set_dofs(*))
+		 void init ( const double &double_init );
+		 void set_dofs ( const unsigned int nbr_total_dofs=n_dofs );
+
+		void reseed ( const double &double_init, const unsigned int nbr_total_dofs=n_dofs );
+
+		void get_tangent (double &Tangent, const Number2 &argument) const;
+		void get_tangent (SymmetricTensor<2,dim> &Tangent, const SymmetricTensor<2,dim, Number2 > &argument, const SymTensor2<dim,Number2> &eps) const;
 
 
-		void get_curvature (double &Curvature, Sacado::Fad::DFad<DFadType> &argument);
+		void get_curvature (double &Curvature, const Number2 &argument) const;
 		
-		void get_curvature (SymmetricTensor<2,dim> &Curvature, SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &argument, SymTensor2<dim> &eps );
-		void get_curvature (SymmetricTensor<2,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument,                          SymTensor2<dim> &eps );
+		void get_curvature (SymmetricTensor<2,dim> &Curvature, const SymmetricTensor<2,dim, Number2 > &argument, const SymTensor2<dim,Number2> &eps ) const;
+		void get_curvature (SymmetricTensor<2,dim> &Curvature, const Number2 &argument,                          const SymTensor2<dim,Number2> &eps ) const;
 
 //		void get_values ( double &return_double );
 	};
 
-	template<int dim>
-	void SW_double2<dim>::init_set_dofs ( const double &double_init, unsigned int nbr_total_dofs )
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::init_set_dofs ( const double &double_init, unsigned int nbr_total_dofs )
 	{
-		(*this).diff( start_index , nbr_total_dofs );
-		(*this).val() = fad_double(nbr_total_dofs, start_index, double_init);
+		(*this).reseed( double_init, nbr_total_dofs );
 	}
 
 	
-	template<int dim>
-	void SW_double2<dim>::get_tangent (double &Tangent, Sacado::Fad::DFad<DFadType> &argument)
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::init ( const double &double_init )
 	{
-		Tangent = argument.dx(this->start_index).val();
+		(*this) = double_init;
 	}
+
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::set_dofs ( const unsigned int nbr_total_dofs )
+	{
+		const double double_init = value2( static_cast<const Number2&>(*this) );
+		(*this).reseed( double_init, nbr_total_dofs );
+	}
+
+	/*
+	 * Reseed the object in place (see SymTensor2::reseed)
+	 */
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::reseed ( const double &double_init, const unsigned int nbr_total_dofs )
+	{
+		seed2( static_cast<Number2&>(*this), double_init, start_index, nbr_total_dofs );
+	}
+
 	
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::get_tangent (double &Tangent, const Number2 &argument) const
+	{
+		Tangent = d_dx( argument, this->start_index );
+	}
 	
-	template<int dim>
-	void SW_double2<dim>::get_tangent (SymmetricTensor<2,dim> &Tangent, SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &argument, SymTensor2<dim> &eps)
+	
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::get_tangent (SymmetricTensor<2,dim> &Tangent, const SymmetricTensor<2,dim, Number2 > &argument, const SymTensor2<dim,Number2> &eps) const
 	{
 		for(unsigned int x=0;x<eps.n_dofs;++x)
 		{
-			const unsigned int i=eps.std_map_indicies[x].first;
-			const unsigned int j=eps.std_map_indicies[x].second;
-			// ToDo: find a better way to loop over the indices than using eps as input argument
-			Tangent[i][j] = argument[i][j].dx(start_index).val();
+			const unsigned int i=index_i<dim>(x);
+			const unsigned int j=index_j<dim>(x);
+			Tangent[i][j] = d_dx( argument[i][j], start_index );
 		}
 	}
 
 
-	template<int dim>
-	void SW_double2<dim>::get_curvature (double &Curvature, Sacado::Fad::DFad<DFadType> &argument)
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::get_curvature (double &Curvature, const Number2 &argument) const
 	{
-		Curvature = argument.dx(this->start_index).dx(this->start_index);
+		Curvature = d2_dxdy( argument, this->start_index, this->start_index );
 	}
 
 	
 	/*
 	 * Compute Curvature d_argument / d_phi, where argument is already the derivative with respect to d_eps
 	 */
-	template<int dim>
-	void SW_double2<dim>::get_curvature (SymmetricTensor<2,dim> &Curvature, SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > &argument, SymTensor2<dim> &eps )
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::get_curvature (SymmetricTensor<2,dim> &Curvature, const SymmetricTensor<2,dim, Number2 > &argument, const SymTensor2<dim,Number2> &eps ) const
 	{
 		for(unsigned int x=0;x<eps.n_dofs;++x)
 		{
-			const unsigned int i=eps.std_map_indicies[x].first;
-			const unsigned int j=eps.std_map_indicies[x].second;
+			const unsigned int i=index_i<dim>(x);
+			const unsigned int j=index_j<dim>(x);
 
 //			if ( i!=j )
 //				Curvature[i][j] = 0.5 * argument[i][j].val().dx(start_index);	// ToDo: check the factor 0.5
@@ -516,19 +1087,11 @@ namespace Sacado_Wrapper
 	/*
 	 * Compute Curvature d2_argument / d_phi_d_eps
 	 */
-	template<int dim>
-	void SW_double2<dim>::get_curvature (SymmetricTensor<2,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument, SymTensor2<dim> &eps )
+	template<int dim, typename Number2>
+	void SW_double2<dim,Number2>::get_curvature (SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const SymTensor2<dim,Number2> &eps ) const
 	{
 		for(unsigned int x=0;x<eps.n_dofs;++x)
-		{
-			const unsigned int i=eps.std_map_indicies[x].first;
-			const unsigned int j=eps.std_map_indicies[x].second;
-
-			if ( i!=j )
-				Curvature[i][j] = 0.5 * argument.dx(start_index).dx(x);	// ToDo: check the factor 0.5
-			else
-				Curvature[i][j] = argument.dx(start_index).dx(x);
-		}
+			Curvature[index_i<dim>(x)][index_j<dim>(x)] = voigt_scale<dim>(x) * d2_dxdy( argument, start_index, eps.start_index+x );
 	}
 		
 	
@@ -537,87 +1100,121 @@ namespace Sacado_Wrapper
 	
 	
 
-	template<int dim>
+	/*
+	 * Summary of the dofs that relates the start indices of the individual wrapper variables. The first-order functions
+	 * use the data type \a Number, the second-order functions the nested data type \a Number2, which by default is
+	 * the dynamically sized Sacado::Fad::DFad on top of \a Number.
+	 */
+	template<int dim, typename Number=fad_double, typename Number2=Sacado::Fad::DFad<Number> >
 	class DoFs_summary
 	{
 	public:
-		void set_dofs( SymTensor<dim> &eps, SW_double<dim> &double_arg );
-		void init_set_dofs( SymTensor2<dim> &eps, SymmetricTensor<2,dim> &eps_init, SW_double2<dim> &double_arg, double &double_init );
+		template<typename... Fields>
+		void set_dofs( Fields &... fields );
+		void init_set_dofs( SymTensor2<dim,Number2> &eps, const SymmetricTensor<2,dim> &eps_init, SW_double2<dim,Number2> &double_arg, const double &double_init );
 
-		void get_curvature( SymmetricTensor<2,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument, SymTensor2<dim> &eps,        SW_double2<dim> &double_arg );
-		void get_curvature( SymmetricTensor<2,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument, SW_double2<dim> &double_arg, SymTensor2<dim> &eps        );
+		// Reseed preallocated objects in place (see SymTensor::reseed)
+		 void reseed( SymTensor<dim,Number> &eps, const SymmetricTensor<2,dim> &eps_values, SW_double<dim,Number> &double_arg, const double &double_value );
+		 void reseed( SymTensor2<dim,Number2> &eps, const SymmetricTensor<2,dim> &eps_values, SW_double2<dim,Number2> &double_arg, const double &double_value );
 
-		
-		void set_dofs( SymTensor<dim> &eps, SW_double<dim> &double_arg1, SW_double<dim> &double_arg2, SW_double<dim> &double_arg3 );
-		// e.g. for strain, gamma_p and gamma_d
-		 void set_dofs( SymTensor<dim> &eps, SW_double<dim> &double_arg1, SW_double<dim> &double_arg2 );
+		void get_curvature( SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const SymTensor2<dim,Number2> &eps,        const SW_double2<dim,Number2> &double_arg ) const;
+		void get_curvature( SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const SW_double2<dim,Number2> &double_arg, const SymTensor2<dim,Number2> &eps        ) const;
+
+		// Select the memory pools of \a Number and \a Number2 for \a nbr_total_dofs (only relevant for the pool-based data types,
+		// see Sacado-memory_pool.h). This is done automatically by set_dofs, init_set_dofs and reseed.
+		 static void select_pools( const unsigned int nbr_total_dofs );
+
+	private:
+		template<std::size_t... k, typename... Fields>
+		static void set_dofs_unrolled( internal::index_sequence<k...>, Fields &... fields );
 	};
 
-	template<int dim>
-	void DoFs_summary<dim>::set_dofs(SymTensor<dim> &eps, SW_double<dim> &double_arg)
+	/*
+	 * Select the memory pools for \a nbr_total_dofs. The same DoFs_summary sets the dofs of first-order (\a Number) and
+	 * second-order (\a Number2) wrapper variables, so the pools of both data types are selected.
+	 */
+	template<int dim, typename Number, typename Number2>
+	void DoFs_summary<dim,Number,Number2>::select_pools( const unsigned int nbr_total_dofs )
 	{
-		const unsigned int nbr_total_dofs = eps.n_dofs + double_arg.n_dofs;
+		internal::pool_selector<Number>::select( nbr_total_dofs );
+		internal::pool_selector<Number2>::select( nbr_total_dofs );
+	}
 
-		eps.start_index = 0;
-		double_arg.start_index = eps.n_dofs;
+	/*
+	 * Set the dofs of any mix of wrapper variables (SymTensor, SW_double, SW_vector, ... or SymTensor2, SW_double2), e.g.
+	 * for strain, gamma_p and gamma_d: DoFs_summary.set_dofs(eps, gamma_p, gamma_d).
+	 * The start indices and the total number of dofs follow at compile time from DoFs_layout<Fields...>, so the dofs are
+	 * set in a single unrolled pass. The values must be set beforehand via *.init(*).
+	 */
+	template<int dim, typename Number, typename Number2>
+	template<typename... Fields>
+	void DoFs_summary<dim,Number,Number2>::set_dofs( Fields &... fields )
+	{
+		set_dofs_unrolled( internal::make_index_sequence<sizeof...(Fields)>(), fields... );
+	}
+
+	template<int dim, typename Number, typename Number2>
+	template<std::size_t... k, typename... Fields>
+	void DoFs_summary<dim,Number,Number2>::set_dofs_unrolled( internal::index_sequence<k...>, Fields &... fields )
+	{
+		typedef DoFs_layout<Fields...> layout;
 
-		eps.set_dofs( nbr_total_dofs );
-		double_arg.set_dofs( nbr_total_dofs );
+		select_pools( layout::n_total_dofs );
+
+		// Expand the parameter pack into a sequence of statements (one for each field)
+		 using expand = int[];
+		 (void) expand { 0, ( fields.start_index = layout::template start_index<k>::value,
+							  fields.set_dofs( layout::n_total_dofs ), 0 )... };
 	}
 	
-	template<int dim>
-	void DoFs_summary<dim>::init_set_dofs(SymTensor2<dim> &eps, SymmetricTensor<2,dim> &eps_init, SW_double2<dim> &double_arg, double &double_init )
+	template<int dim, typename Number, typename Number2>
+	void DoFs_summary<dim,Number,Number2>::init_set_dofs(SymTensor2<dim,Number2> &eps, const SymmetricTensor<2,dim> &eps_init, SW_double2<dim,Number2> &double_arg, const double &double_init )
 
 	{
 		const unsigned int nbr_total_dofs = eps.n_dofs + double_arg.n_dofs;
 
 		eps.start_index = 0;
 		double_arg.start_index = eps.n_dofs;
+		select_pools( nbr_total_dofs );
 		
 		eps.init_set_dofs( eps_init, nbr_total_dofs);
 		double_arg.init_set_dofs( double_init, nbr_total_dofs );
 	}
 	
-	template<int dim>
-	void DoFs_summary<dim>::set_dofs(SymTensor<dim> &eps, SW_double<dim> &double_arg1, SW_double<dim> &double_arg2, SW_double<dim> &double_arg3 )
+	template<int dim, typename Number, typename Number2>
+	void DoFs_summary<dim,Number,Number2>::reseed( SymTensor<dim,Number> &eps, const SymmetricTensor<2,dim> &eps_values, SW_double<dim,Number> &double_arg, const double &double_value )
 	{
-		const unsigned int nbr_total_dofs = eps.n_dofs + double_arg1.n_dofs + double_arg2.n_dofs + double_arg3.n_dofs ;
+		const unsigned int nbr_total_dofs = eps.n_dofs + double_arg.n_dofs;
 
 		eps.start_index = 0;
-		double_arg1.start_index = eps.n_dofs;
-		double_arg2.start_index = eps.n_dofs + double_arg1.n_dofs;
-		double_arg3.start_index = eps.n_dofs + double_arg1.n_dofs + double_arg2.n_dofs;
+		double_arg.start_index = eps.n_dofs;
+		select_pools( nbr_total_dofs );
 
-		eps.set_dofs( nbr_total_dofs );
-		double_arg1.set_dofs( nbr_total_dofs );
-		double_arg2.set_dofs( nbr_total_dofs );
-		double_arg3.set_dofs( nbr_total_dofs );
+		eps.reseed( eps_values, nbr_total_dofs );
+		double_arg.reseed( double_value, nbr_total_dofs );
 	}
-	
-	template<int dim>
-	void DoFs_summary<dim>::set_dofs(SymTensor<dim> &eps, SW_double<dim> &double_arg1, SW_double<dim> &double_arg2 )
+
+	template<int dim, typename Number, typename Number2>
+	void DoFs_summary<dim,Number,Number2>::reseed( SymTensor2<dim,Number2> &eps, const SymmetricTensor<2,dim> &eps_values, SW_double2<dim,Number2> &double_arg, const double &double_value )
 	{
-		const unsigned int nbr_total_dofs = eps.n_dofs + double_arg1.n_dofs + double_arg2.n_dofs ;
+		const unsigned int nbr_total_dofs = eps.n_dofs + double_arg.n_dofs;
 
 		eps.start_index = 0;
-		double_arg1.start_index = eps.n_dofs;
-		double_arg2.start_index = eps.n_dofs + double_arg1.n_dofs;
+		double_arg.start_index = eps.n_dofs;
+		select_pools( nbr_total_dofs );
 
-		eps.set_dofs( nbr_total_dofs );
-		double_arg1.set_dofs( nbr_total_dofs );
-		double_arg2.set_dofs( nbr_total_dofs );
+		eps.reseed( eps_values, nbr_total_dofs );
+		double_arg.reseed( double_value, nbr_total_dofs );
 	}
 	
 	/*
 	 * 
 	 * example call: DoFs_summary.get_curvature(d2_energy_d_eps_d_phi, energy, eps_fad, phi_fad)
 	 */
-	template<int dim>
-	void DoFs_summary<dim>::get_curvature( SymmetricTensor<2,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument, SymTensor2<dim> &eps, SW_double2<dim> &double_arg )
+	template<int dim, typename Number, typename Number2>
+	void DoFs_summary<dim,Number,Number2>::get_curvature( SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const SymTensor2<dim,Number2> &eps, const SW_double2<dim,Number2> &double_arg ) const
 	{
-		SymmetricTensor<2,dim, Sacado::Fad::DFad<DFadType> > d_arg_d_eps;
-		eps.get_tangent(d_arg_d_eps, argument);
-		double_arg.get_curvature(Curvature, d_arg_d_eps, eps);
+		double_arg.get_curvature(Curvature, argument, eps);
 	}
 
 	
@@ -625,11 +1222,112 @@ namespace Sacado_Wrapper
 	 * 
 	 * example call: DoFs_summary.get_curvature(d2_energy_d_phi_d_eps, energy, phi_fad, eps_fad)
 	 */
-	template<int dim>
-	void DoFs_summary<dim>::get_curvature( SymmetricTensor<2,dim> &Curvature, Sacado::Fad::DFad<DFadType> &argument, SW_double2<dim> &double_arg, SymTensor2<dim> &eps  )
+	template<int dim, typename Number, typename Number2>
+	void DoFs_summary<dim,Number,Number2>::get_curvature( SymmetricTensor<2,dim> &Curvature, const Number2 &argument, const SW_double2<dim,Number2> &double_arg, const SymTensor2<dim,Number2> &eps  ) const
 	{
 		double_arg.get_curvature(Curvature, argument, eps);
 	}
+
+
+	//###########################################################################################################//
+
+
+	/*
+	 * Wrapper data types based on Sacado::Fad::SFad<double,N>, where the number of dofs N is fixed at compile time.
+	 * The derivatives are stored in a fixed size array, so no heap allocations occur when setting the dofs and evaluating
+	 * the equations. The total number of dofs set via \a set_dofs must be exactly N.
+	 * @code
+	 * 	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+	 * 	Sacado_Wrapper::SymTensor_SFad<dim,N> eps;
+	 * 	Sacado_Wrapper::SW_double_SFad<dim,N> phi;
+	 * 	Sacado_Wrapper::DoFs_summary_SFad<dim,N> DoFs_summary;
+	 * @endcode
+	 */
+	template<int dim, unsigned int N>
+	using SymTensor_SFad = SymTensor<dim, Sacado::Fad::SFad<double,N> >;
+	template<int dim, unsigned int N>
+	using SW_double_SFad = SW_double<dim, Sacado::Fad::SFad<double,N> >;
+	template<int dim, unsigned int N>
+	using SymTensor2_SFad = SymTensor2<dim, Sacado::Fad::SFad<Sacado::Fad::SFad<double,N>,N> >;
+	template<int dim, unsigned int N>
+	using SW_double2_SFad = SW_double2<dim, Sacado::Fad::SFad<Sacado::Fad::SFad<double,N>,N> >;
+	template<int dim, unsigned int N>
+	using DoFs_summary_SFad = DoFs_summary<dim, Sacado::Fad::SFad<double,N>, Sacado::Fad::SFad<Sacado::Fad::SFad<double,N>,N> >;
+
+	/*
+	 * The same based on Sacado::Fad::SLFad<double,N>, where N is only the maximum number of dofs. This allows to
+	 * use the same data type for e.g. SymTensor alone (6 dofs) and SymTensor+SW_double (7 dofs) with N=7.
+	 */
+	template<int dim, unsigned int N>
+	using SymTensor_SLFad = SymTensor<dim, Sacado::Fad::SLFad<double,N> >;
+	template<int dim, unsigned int N>
+	using SW_double_SLFad = SW_double<dim, Sacado::Fad::SLFad<double,N> >;
+	template<int dim, unsigned int N>
+	using SymTensor2_SLFad = SymTensor2<dim, Sacado::Fad::SLFad<Sacado::Fad::SLFad<double,N>,N> >;
+	template<int dim, unsigned int N>
+	using SW_double2_SLFad = SW_double2<dim, Sacado::Fad::SLFad<Sacado::Fad::SLFad<double,N>,N> >;
+	template<int dim, unsigned int N>
+	using DoFs_summary_SLFad = DoFs_summary<dim, Sacado::Fad::SLFad<double,N>, Sacado::Fad::SLFad<Sacado::Fad::SLFad<double,N>,N> >;
+
+
+	//###########################################################################################################//
+
+
+	/*
+	 * Fad-type policy that bundles the first-order data type \a Number and the second-order (nested) data type \a Number2
+	 * together with the wrapper classes based on them. A material model templated on the policy can then be evaluated
+	 * with every Sacado data type without forking the wrapper, e.g.
+	 * @code
+	 * 	template<typename Policy>
+	 * 	void material_model ( ... )
+	 * 	{
+	 * 		typename Policy::template SymTensor2_type<3> eps;
+	 * 		typename Policy::template SW_double2_type<3> phi;
+	 * 		typename Policy::template DoFs_summary_type<3> DoFs_summary;
+	 * 		typename Policy::fad2_type energy;
+	 * 		...
+	 * 	}
+	 * 	material_model< Sacado_Wrapper::SFad_policy<7> >( ... );
+	 * @endcode
+	 * @note The data types based on the memory pool (DMFad) need an active pool before the first variable is created
+	 * (see Sacado::Fad::MemPoolManager, or let the DoFs_summary select it via Sacado-memory_pool.h).
+	 */
+	template<typename Number, typename Number2=Sacado::Fad::DFad<Number> >
+	struct FadPolicy
+	{
+		typedef Number  fad_type;	// first derivatives
+		typedef Number2 fad2_type;	// first and second derivatives
+
+		template<int dim>
+		using SymTensor_type = SymTensor<dim,Number>;
+		template<int dim>
+		using SW_double_type = SW_double<dim,Number>;
+		template<int dim>
+		using SW_vector_type = SW_vector<dim,Number>;
+		template<int dim>
+		using SymTensor2_type = SymTensor2<dim,Number2>;
+		template<int dim>
+		using SW_double2_type = SW_double2<dim,Number2>;
+		template<int dim>
+		using DoFs_summary_type = DoFs_summary<dim,Number,Number2>;
+	};
+
+	// The standard Sacado data types as policies
+	// (dynamically sized, expression-level reverse mode, caching and memory pool based derivative arrays)
+	 typedef FadPolicy< Sacado::Fad::DFad<double> > DFad_policy;
+	 typedef FadPolicy< Sacado::ELRFad::DFad<double>,   Sacado::ELRFad::DFad< Sacado::ELRFad::DFad<double> > >     ELRFad_policy;
+	 typedef FadPolicy< Sacado::CacheFad::DFad<double>, Sacado::CacheFad::DFad< Sacado::CacheFad::DFad<double> > > CacheFad_policy;
+	 typedef FadPolicy< Sacado::Fad::DMFad<double>,     Sacado::Fad::DMFad< Sacado::Fad::DMFad<double> > >         DMFad_policy;
+
+	// Statically sized (N: exact or maximum number of dofs)
+	 template<unsigned int N>
+	 using SFad_policy = FadPolicy< Sacado::Fad::SFad<double,N>, Sacado::Fad::SFad<Sacado::Fad::SFad<double,N>,N> >;
+	 template<unsigned int N>
+	 using SLFad_policy = FadPolicy< Sacado::Fad::SLFad<double,N>, Sacado::Fad::SLFad<Sacado::Fad::SLFad<double,N>,N> >;
+
+	// Mixed nesting, e.g. only the inner (first) derivatives are statically sized
+	 template<unsigned int N>
+	 using DFad_SFad_policy = FadPolicy< Sacado::Fad::SFad<double,N>, Sacado::Fad::DFad<Sacado::Fad::SFad<double,N> > >;
 }
 
 
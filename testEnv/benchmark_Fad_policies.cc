@@ -0,0 +1,150 @@
+/*
+ * Benchmark: The energy from example 7/8 evaluated with every Fad-type policy of the Sacado_Wrapper
+ *
+ * At each of the \a n_qps quadrature points the strain \a eps and the scalar \a phi are set as dofs, the energy is
+ * evaluated and the first derivatives (stress, d_energy_d_phi) are extracted with the first-order data type of the policy.
+ * Then the same is done with the second-order (nested) data type, which additionally gives the curvatures.
+ * All policies must give the same results as the default DFad policy.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+#include <string>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Sums of all the derivatives over all quadrature points from the first-order data type (\a results_1st) and from the
+ * second-order data type (\a results_2nd)
+ */
+template<int dim, typename Policy>
+void evaluate_qps ( const unsigned int n_qps, const double lambda, const double mu,
+					QPSums<dim> &results_1st, QPSums<dim> &results_2nd )
+{
+	typedef typename Policy::fad_type  Number;
+	typedef typename Policy::fad2_type Number2;
+
+	results_1st = QPSums<dim>();
+	results_2nd = QPSums<dim>();
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		SymmetricTensor<2,dim> eps = strain_at_qp<dim>(qp);
+		double phi = 0.3;
+
+		// First derivatives
+		{
+			typename Policy::template SymTensor_type<dim> eps_fad;
+			typename Policy::template SW_double_type<dim> phi_fad;
+			typename Policy::template DoFs_summary_type<dim> DoFs_summary;
+
+			eps_fad.init(eps);
+			phi_fad.init(phi);
+			DoFs_summary.set_dofs(eps_fad, phi_fad);
+
+			Number energy = energy_eps_phi<dim,Number>(eps_fad, phi_fad, lambda, mu);
+
+			SymmetricTensor<2,dim> sigma;
+			eps_fad.get_tangent(sigma, energy);
+			double d_energy_d_phi;
+			phi_fad.get_tangent(d_energy_d_phi, energy);
+
+			results_1st.sigma += sigma;
+			results_1st.d_psi_d_phi += d_energy_d_phi;
+		}
+
+		// First and second derivatives
+		{
+			typename Policy::template SymTensor2_type<dim> eps_fad;
+			typename Policy::template SW_double2_type<dim> phi_fad;
+			typename Policy::template DoFs_summary_type<dim> DoFs_summary;
+
+			DoFs_summary.init_set_dofs(eps_fad, eps, phi_fad, phi);
+
+			Number2 energy = energy_eps_phi<dim,Number2>(eps_fad, phi_fad, lambda, mu);
+
+			SymmetricTensor<2,dim> sigma;
+			eps_fad.get_tangent(sigma, energy);
+			double d_energy_d_phi;
+			phi_fad.get_tangent(d_energy_d_phi, energy);
+
+			SymmetricTensor<4,dim> C;
+			eps_fad.get_curvature(C, energy);
+			double d2_energy_d_phi_2;
+			phi_fad.get_curvature(d2_energy_d_phi_2, energy);
+			SymmetricTensor<2,dim> d2_energy_d_eps_d_phi;
+			DoFs_summary.get_curvature(d2_energy_d_eps_d_phi, energy, eps_fad, phi_fad);
+
+			results_2nd.sigma += sigma;
+			results_2nd.d_psi_d_phi += d_energy_d_phi;
+			results_2nd.C += C;
+			results_2nd.d2_psi_d_phi2 += d2_energy_d_phi_2;
+			results_2nd.d_sigma_d_phi += d2_energy_d_eps_d_phi;
+		}
+	}
+}
+
+
+template<int dim, typename Policy>
+bool run_policy ( const std::string &name, const unsigned int n_qps, const double lambda, const double mu,
+				  const QPSums<dim> &reference_1st, const QPSums<dim> &reference_2nd, TimerOutput &timer )
+{
+	QPSums<dim> results_1st, results_2nd;
+	timer.enter_subsection(name);
+	 evaluate_qps<dim,Policy>( n_qps, lambda, mu, results_1st, results_2nd );
+	timer.leave_subsection();
+
+	const bool passed = check_error( name + " vs DFad (first order)", results_1st.error(reference_1st) );
+	return check_error( name + " vs DFad (second order)", results_2nd.error(reference_2nd) ) && passed;
+}
+
+
+int main ()
+{
+	const unsigned int dim=3;
+	const unsigned int n_qps = 100000;
+
+	const double lambda = 1;
+	const double mu = 2;
+
+	// The number of dofs (strain tensor and phi) is known at compile time
+	 const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+
+	// The memory pool based DMFad needs an active pool for the inner and the nested data type
+	 Sacado::Fad::MemPoolManager<double> pool_manager(100);
+	 Sacado::Fad::DMFad<double>::setDefaultPool( pool_manager.getMemoryPool(N) );
+	 Sacado::Fad::MemPoolManager< Sacado::Fad::DMFad<double> > pool_manager2(100);
+	 Sacado::Fad::DMFad< Sacado::Fad::DMFad<double> >::setDefaultPool( pool_manager2.getMemoryPool(N) );
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	std::cout << "Benchmark Fad-type policies: " << n_qps << " quadrature points" << std::endl;
+
+	QPSums<dim> reference_1st, reference_2nd;
+	timer.enter_subsection("DFad");
+	 evaluate_qps<dim,Sacado_Wrapper::DFad_policy>( n_qps, lambda, mu, reference_1st, reference_2nd );
+	timer.leave_subsection();
+
+	bool passed = true;
+	passed &= run_policy<dim, Sacado_Wrapper::SFad_policy<N> >     ("SFad",      n_qps, lambda, mu, reference_1st, reference_2nd, timer);
+	passed &= run_policy<dim, Sacado_Wrapper::SLFad_policy<N> >    ("SLFad",     n_qps, lambda, mu, reference_1st, reference_2nd, timer);
+	passed &= run_policy<dim, Sacado_Wrapper::DFad_SFad_policy<N> >("DFad<SFad>",n_qps, lambda, mu, reference_1st, reference_2nd, timer);
+	passed &= run_policy<dim, Sacado_Wrapper::ELRFad_policy >      ("ELRFad",    n_qps, lambda, mu, reference_1st, reference_2nd, timer);
+	passed &= run_policy<dim, Sacado_Wrapper::CacheFad_policy >    ("CacheFad",  n_qps, lambda, mu, reference_1st, reference_2nd, timer);
+	passed &= run_policy<dim, Sacado_Wrapper::DMFad_policy >       ("DMFad",     n_qps, lambda, mu, reference_1st, reference_2nd, timer);
+
+	return passed ? 0 : 1;
+}
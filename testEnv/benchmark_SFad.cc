@@ -0,0 +1,88 @@
+/*
+ * Benchmark: Sacado_Wrapper::SymTensor based on the dynamically sized DFad (fad_double)
+ * versus the statically sized SFad and SLFad
+ *
+ * Each data type evaluates the \a stress_strain_relation from example 10 at \a n_qps quadrature points,
+ * where at every quadrature point the strain tensor is initialised, set as dofs and the tangent is extracted.
+ * This mimics the material routine that is called for every quadrature point in a FE code.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Evaluate the stress and the tangent at all quadrature points with the Sacado data type \a Number
+ * and return the sum over all tangents (also to keep the compiler from skipping the computation).
+ */
+template<int dim, typename Number>
+QPSums<dim> evaluate_qps ( const unsigned int n_qps, const double kappa, const double mu )
+{
+	QPSums<dim> sums;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		SymmetricTensor<2,dim> eps_d = strain_at_qp<dim>(qp);
+
+		Sacado_Wrapper::SymTensor<dim,Number> eps;
+		eps.init(eps_d);
+		eps.set_dofs();
+
+		SymmetricTensor<2,dim,Number> sigma = stress_strain_relation ( eps, kappa, mu );
+
+		SymmetricTensor<4,dim> C_Sacado;
+		eps.get_tangent(C_Sacado, sigma);
+
+		sums.C += C_Sacado;
+	}
+
+	return sums;
+}
+
+
+int main ()
+{
+	const unsigned int dim=3;
+	const unsigned int n_qps = 1000000;
+
+	const double kappa = 5;
+	const double mu = 2;
+
+	// The number of dofs of the strain tensor is known at compile time
+	 const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	 timer.enter_subsection("DFad");
+	  const QPSums<dim> C_DFad = evaluate_qps<dim, Sacado::Fad::DFad<double> >( n_qps, kappa, mu );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("SFad");
+	  const QPSums<dim> C_SFad = evaluate_qps<dim, Sacado::Fad::SFad<double,N> >( n_qps, kappa, mu );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("SLFad");
+	  const QPSums<dim> C_SLFad = evaluate_qps<dim, Sacado::Fad::SLFad<double,N> >( n_qps, kappa, mu );
+	 timer.leave_subsection();
+
+	// All data types must give the same tangents
+	 std::cout << "Benchmark SFad: " << n_qps << " quadrature points" << std::endl;
+	 bool passed = check_error( "SFad  vs DFad", C_SFad.error(C_DFad) );
+	 passed &= check_error( "SLFad vs DFad", C_SLFad.error(C_DFad) );
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+/*
+ * Benchmark: Quadrature point loop over deal.II tensors (array of structures) versus the structure-of-arrays
+ * containers SymTensorBatch and SymTangentBatch
+ *
+ * The \a stress_strain_relation from example 10 is evaluated for a block of \a n_qps strains, which could be the strains of
+ * all quadrature points of a cell or of a whole set of cells. The stresses and tangents are written into
+ * - "AoS": std::vector<SymmetricTensor<2,dim>> and std::vector<SymmetricTensor<4,dim>> (the usual approach)
+ * - "batch SFad": SymTensorBatch and SymTangentBatch filled via set_dofs, get_value and get_tangent with SFad<double,N>
+ * - "batch SIMD": the same with SFad<VectorizedArray<double>,N> (n_lanes quadrature points at once)
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-vectorized_array.h"
+#include "Sacado-qp_batch.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+template<int dim>
+void evaluate_AoS ( const std::vector< SymmetricTensor<2,dim> > &eps_d, const double kappa, const double mu,
+					std::vector< SymmetricTensor<2,dim> > &sigma_d, std::vector< SymmetricTensor<4,dim> > &C )
+{
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+	Sacado_Wrapper::SymTensor_SFad<dim,N> eps;
+
+	for ( unsigned int qp=0; qp<eps_d.size(); ++qp )
+	{
+		eps.reseed( eps_d[qp] );
+
+		SymmetricTensor<2,dim,Sacado::Fad::SFad<double,N> > sigma = stress_strain_relation ( eps, kappa, mu );
+
+		eps.get_tangent(C[qp], sigma);
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				sigma_d[qp][i][j] = sigma[i][j].val();
+	}
+}
+
+
+/*
+ * The same loop for any first-order Sacado data type \a Number, advancing by the number of lanes of its value type
+ */
+template<int dim, typename Number>
+void evaluate_batch ( const Sacado_Wrapper::SymTensorBatch<dim> &eps_batch, const double kappa, const double mu,
+					  Sacado_Wrapper::SymTensorBatch<dim> &sigma_batch, Sacado_Wrapper::SymTangentBatch<dim> &C_batch )
+{
+	const unsigned int n_lanes = Sacado_Wrapper::internal::lanes<typename Number::value_type>::n;
+
+	Sacado_Wrapper::SymTensor<dim,Number> eps;
+
+	for ( unsigned int qp=0; qp<eps_batch.size(); qp+=n_lanes )
+	{
+		eps_batch.set_dofs(eps, qp);
+
+		SymmetricTensor<2,dim,Number> sigma = stress_strain_relation ( eps, kappa, mu );
+
+		sigma_batch.get_value(sigma, qp);
+		C_batch.get_tangent(eps, sigma, qp);
+	}
+}
+
+
+int main ()
+{
+	const unsigned int dim=3;
+	const unsigned int n_qps = 1000003; // on purpose not a multiple of the number of lanes
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+
+	const double kappa = 5;
+	const double mu = 2;
+
+	std::vector< SymmetricTensor<2,dim> > eps_d (n_qps), sigma_AoS (n_qps);
+	std::vector< SymmetricTensor<4,dim> > C_AoS (n_qps);
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+		eps_d[qp] = strain_at_qp<dim>(qp);
+
+	Sacado_Wrapper::SymTensorBatch<dim> eps_batch, sigma_batch (n_qps), sigma_batch_SIMD (n_qps);
+	Sacado_Wrapper::SymTangentBatch<dim> C_batch (n_qps), C_batch_SIMD (n_qps);
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	 timer.enter_subsection("AoS");
+	  evaluate_AoS<dim>( eps_d, kappa, mu, sigma_AoS, C_AoS );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("AoS to batch");
+	  eps_batch.init(eps_d);
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("batch SFad");
+	  evaluate_batch< dim, Sacado::Fad::SFad<double,N> >( eps_batch, kappa, mu, sigma_batch, C_batch );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("batch SIMD");
+	  evaluate_batch< dim, Sacado_Wrapper::fad_vectorized<N> >( eps_batch, kappa, mu, sigma_batch_SIMD, C_batch_SIMD );
+	 timer.leave_subsection();
+
+	// All approaches must give the same stresses and tangents
+	 QPSums<dim> sums_AoS, sums_SFad, sums_SIMD;
+	 for ( unsigned int qp=0; qp<n_qps; ++qp )
+	 {
+		sums_AoS.sigma += sigma_AoS[qp];
+		sums_AoS.C += C_AoS[qp];
+		sums_SFad.sigma += sigma_batch.get(qp);
+		sums_SFad.C += C_batch.get(qp);
+		sums_SIMD.sigma += sigma_batch_SIMD.get(qp);
+		sums_SIMD.C += C_batch_SIMD.get(qp);
+	 }
+	 std::cout << "Benchmark batch: " << n_qps << " quadrature points" << std::endl;
+	 bool passed = check_error( "batch SFad vs AoS", sums_SFad.error(sums_AoS) );
+	 passed &= check_error( "batch SIMD vs AoS", sums_SIMD.error(sums_AoS) );
+
+	return passed ? 0 : 1;
+}
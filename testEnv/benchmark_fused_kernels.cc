@@ -0,0 +1,223 @@
+/*
+ * Benchmark: Fused tensor kernels vs. the generic deal.II tensor functions
+ *
+ * The example models from benchmark_models.h are evaluated at \a n_qps quadrature points as written there (generic) and with
+ * the kernels from Sacado-fused_kernels.h (fused):
+ * - stress_strain_relation (\ref Ex10 "example 10"): trace and deviator (the generic version computes the deviator 9 times)
+ *   and alternatively the contraction with the constant tangent (fused C:eps)
+ * - stress_eps_phi (\ref Ex4 "example 4"): trace and norm
+ * - energy_eps_phi (\ref Ex7 "example 7"): trace and eps.eps, with first (Number) and second (Number2) derivatives
+ * each with DFad and SFad. The derivatives of the fused versions are compared to those of the generic ones.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-fused_kernels.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+const double kappa = 5;
+const double mu = 2;
+const double lambda = 1;
+
+
+// Example 10 with the fused trace and deviator
+ template<typename Number>
+ SymmetricTensor<2,dim,Number> stress_strain_relation_fused ( const SymmetricTensor<2,dim,Number> &eps )
+ {
+	const Number tr = Sacado_Wrapper::fused::trace(eps);
+	SymmetricTensor<2,dim,Number> sigma = Sacado_Wrapper::fused::deviator(eps);
+	sigma *= 2.*mu;
+	for ( unsigned int i=0; i<dim; ++i )
+		sigma[i][i] += kappa * tr;
+	return sigma;
+ }
+
+// Example 4 with the fused trace and norm
+ template<typename Number>
+ SymmetricTensor<2,dim,Number> stress_eps_phi_fused ( const SymmetricTensor<2,dim,Number> &eps, const Number &phi )
+ {
+	const Number phi_d = phi * ( phi*phi + 25 + Sacado_Wrapper::fused::trace(eps) + Sacado_Wrapper::fused::norm(eps) );
+
+	SymmetricTensor<2,dim,Number> sigma;
+	for ( unsigned int i=0; i<dim; ++i)
+		for ( unsigned int j=i; j<dim; ++j )
+			sigma[i][j] = phi_d * eps[i][j];
+	return sigma;
+ }
+
+// Example 7 with the fused trace and eps.eps
+ template<typename Number>
+ Number energy_eps_phi_fused ( const SymmetricTensor<2,dim,Number> &eps, const Number &phi )
+ {
+	const Number tr = Sacado_Wrapper::fused::trace(eps);
+	const Number tr_eps_squared = Sacado_Wrapper::fused::trace( Sacado_Wrapper::fused::square(eps) );
+	return lambda/2. * tr*tr + mu * tr_eps_squared + 25. * phi * tr;
+ }
+
+
+enum class Model
+{
+	stress_strain,
+	stress_eps_phi,
+	energy_1st,
+	energy_2nd
+};
+
+
+template<typename Policy>
+QPSums<dim> evaluate_qps ( const Model model, const bool fused, const unsigned int n_qps )
+{
+	typedef typename Policy::fad_type  Number;
+	typedef typename Policy::fad2_type Number2;
+
+	typename Policy::template SymTensor_type<dim> eps;
+	typename Policy::template SW_double_type<dim> phi;
+	typename Policy::template SymTensor2_type<dim> eps2;
+	typename Policy::template SW_double2_type<dim> phi2;
+	typename Policy::template DoFs_summary_type<dim> DoFs_summary;
+
+	QPSums<dim> results;
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		const SymmetricTensor<2,dim> eps_d = strain_at_qp<dim>(qp);
+		SymmetricTensor<2,dim> sigma, d_sigma_d_phi;
+		SymmetricTensor<4,dim> C;
+
+		switch ( model )
+		{
+			case Model::stress_strain:
+			{
+				eps.reseed(eps_d);
+				const SymmetricTensor<2,dim,Number> sigma_fad = fused ? stress_strain_relation_fused<Number>(eps)
+																	  : stress_strain_relation<dim,Number>(eps, kappa, mu);
+				eps.get_tangent(C, sigma_fad);
+				break;
+			}
+			case Model::stress_eps_phi:
+			{
+				DoFs_summary.reseed(eps, eps_d, phi, 0.3);
+				const SymmetricTensor<2,dim,Number> sigma_fad = fused ? stress_eps_phi_fused<Number>(eps, phi)
+																	  : stress_eps_phi<dim,Number>(eps, phi);
+				eps.get_tangent(C, sigma_fad);
+				phi.get_tangent(d_sigma_d_phi, sigma_fad);
+				break;
+			}
+			case Model::energy_1st:
+			{
+				DoFs_summary.reseed(eps, eps_d, phi, 0.3);
+				const Number energy = fused ? energy_eps_phi_fused<Number>(eps, phi)
+											: energy_eps_phi<dim,Number>(eps, phi, lambda, mu);
+				eps.get_tangent(sigma, energy);
+				break;
+			}
+			case Model::energy_2nd:
+			{
+				DoFs_summary.reseed(eps2, eps_d, phi2, 0.3);
+				const Number2 energy = fused ? energy_eps_phi_fused<Number2>(eps2, phi2)
+											 : energy_eps_phi<dim,Number2>(eps2, phi2, lambda, mu);
+				eps2.get_tangent(sigma, energy);
+				eps2.get_curvature(C, energy);
+				DoFs_summary.get_curvature(d_sigma_d_phi, energy, eps2, phi2);
+				break;
+			}
+		}
+
+		results.sigma += sigma;
+		results.C += C;
+		results.d_sigma_d_phi += d_sigma_d_phi;
+	}
+
+	return results;
+}
+
+
+// The (fused) contraction with the constant tangent for example 10
+ template<typename Policy>
+ QPSums<dim> evaluate_contraction ( const unsigned int n_qps )
+ {
+	typedef typename Policy::fad_type Number;
+
+	const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+	const SymmetricTensor<4,dim> C_iso = kappa * outer_product(I, I) + 2. * mu * deviator_tensor<dim>();
+
+	typename Policy::template SymTensor_type<dim> eps;
+	QPSums<dim> results;
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		eps.reseed( strain_at_qp<dim>(qp) );
+		const SymmetricTensor<2,dim,Number> sigma_fad = Sacado_Wrapper::fused::double_contract(C_iso, eps);
+		SymmetricTensor<4,dim> C;
+		eps.get_tangent(C, sigma_fad);
+		results.C += C;
+	}
+	return results;
+ }
+
+
+/*
+ * All models fused vs generic with the data types of the \a Policy, returns whether all errors are within the tolerance
+ */
+template<typename Policy>
+bool run_models ( const std::string &name, const unsigned int n_qps, TimerOutput &timer )
+{
+	bool passed = true;
+	const std::vector<std::pair<Model,std::string> > models = { {Model::stress_strain, "Ex10 stress"},
+																{Model::stress_eps_phi, "Ex4 stress"},
+																{Model::energy_1st, "Ex7 energy 1st"},
+																{Model::energy_2nd, "Ex7 energy 2nd"} };
+	for ( const std::pair<Model,std::string> &model : models )
+	{
+		timer.enter_subsection(name + " " + model.second + " generic");
+		 const QPSums<dim> reference = evaluate_qps<Policy>( model.first, false, n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection(name + " " + model.second + " fused");
+		 const QPSums<dim> results = evaluate_qps<Policy>( model.first, true, n_qps );
+		timer.leave_subsection();
+
+		passed &= check_error( name + " " + model.second + " fused vs generic", results.error(reference) );
+
+		if ( model.first==Model::stress_strain )
+		{
+			timer.enter_subsection(name + " " + model.second + " fused C:eps");
+			 const QPSums<dim> results_contraction = evaluate_contraction<Policy>( n_qps );
+			timer.leave_subsection();
+
+			passed &= check_error( name + " " + model.second + " fused C:eps vs generic", results_contraction.error(reference) );
+		}
+	}
+	return passed;
+}
+
+
+int main ()
+{
+	const unsigned int n_qps = 200000;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	std::cout << "Benchmark fused tensor kernels: " << n_qps << " quadrature points" << std::endl;
+
+	bool passed = run_models< Sacado_Wrapper::DFad_policy >( "DFad", n_qps, timer );
+	passed &= run_models< Sacado_Wrapper::SFad_policy<N> >( "SFad<7>", n_qps, timer );
+
+	return passed ? 0 : 1;
+}
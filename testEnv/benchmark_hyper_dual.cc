@@ -0,0 +1,208 @@
+/*
+ * Benchmark: Energy Hessians with the nested Sacado::Fad::DFad<DFad<double>> versus the HyperDual<N>
+ *
+ * The strain energy density from example 7/8 is evaluated at \a n_qps quadrature points with the strain \a eps (6 dofs)
+ * and the scalar \a phi (1 dof). At every quadrature point the stress, the tangent d2_psi/d_eps2, the second derivative
+ * d2_psi/d_phi2 and the mixed derivative d2_psi/d_eps_d_phi are extracted.
+ * - "DFad<DFad> (Test 8 path)": SymTensor2, SW_double2 and DoFs_summary with the energy \a energy_eps_phi
+ * - "DFad<DFad> components": the same wrapper variables, but the energy written in components (see \a energy_components)
+ * - "HyperDual<7>": the same component equation, where only the upper triangle of the Hessian is propagated
+ * - "HyperDual<7> (Test 8 path)": HyperDual<7> as drop-in data type of SymTensor2, SW_double2 and DoFs_summary with \a energy_eps_phi
+ *
+ * In all cases the tangent is extracted as the upper triangle and mirrored.
+ */
+
+// @section includes Include Files
+// First, such that the deal.II templates find the elementary functions of the number type in std
+#include "Sacado-hyper_dual.h"
+
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Energy from example 7/8 for dim=3 in the independent components of the strain, where
+ * trace(eps²) = eps_00² + eps_11² + eps_22² + 2 * ( eps_01² + eps_02² + eps_12² )
+ */
+template<typename Number>
+Number energy_components ( const Number &e00, const Number &e11, const Number &e22,
+						   const Number &e01, const Number &e02, const Number &e12,
+						   const Number &phi, const double &lambda, const double &mu )
+{
+	const Number tr = e00 + e11 + e22;
+	return lambda/2. * tr * tr + mu * ( e00*e00 + e11*e11 + e22*e22 + 2. * ( e01*e01 + e02*e02 + e12*e12 ) ) + 25. * phi * tr;
+}
+
+
+/*
+ * Second-order wrapper with the data types from the \a Policy (see Sacado_Wrapper::FadPolicy), with the energy
+ * either from \a energy_eps_phi (as in example 8) or from \a energy_components
+ */
+template<typename Policy, bool component_equation>
+QPSums<3> evaluate_wrapper ( const unsigned int n_qps, const double lambda, const double mu )
+{
+	const unsigned int dim=3;
+	typedef typename Policy::fad2_type Number2;
+
+	QPSums<3> results;
+
+	typename Policy::template SymTensor2_type<dim> eps;
+	typename Policy::template SW_double2_type<dim> phi;
+	typename Policy::template DoFs_summary_type<dim> DoFs_summary;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		Number2 energy;
+		if ( component_equation )
+			energy = energy_components<Number2>( eps[0][0], eps[1][1], eps[2][2], eps[0][1], eps[0][2], eps[1][2], phi, lambda, mu );
+		else
+			energy = energy_eps_phi<dim,Number2>( eps, phi, lambda, mu );
+
+		SymmetricTensor<2,dim> sigma;
+		eps.get_tangent(sigma, energy);
+		results.sigma += sigma;
+
+		SymmetricTensor<4,dim> C;
+		eps.get_curvature(C, energy);
+		results.C += C;
+
+		double d2_psi_d_phi2;
+		phi.get_curvature(d2_psi_d_phi2, energy);
+		results.d2_psi_d_phi2 += d2_psi_d_phi2;
+
+		SymmetricTensor<2,dim> d2_psi_d_eps_d_phi;
+		DoFs_summary.get_curvature(d2_psi_d_eps_d_phi, energy, eps, phi);
+		results.d_sigma_d_phi += d2_psi_d_eps_d_phi;
+	}
+
+	return results;
+}
+
+
+/*
+ * HyperDual<7>, where the dofs are numbered as in the wrapper: the strain components (0,0),(0,1),(0,2),(1,1),(1,2),(2,2)
+ * followed by phi
+ */
+QPSums<3> evaluate_HyperDual ( const unsigned int n_qps, const double lambda, const double mu )
+{
+	const unsigned int dim=3;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+	typedef Sacado_Wrapper::HyperDual<N> Number;
+	const unsigned int phi_dof = N-1;
+
+	QPSums<3> results;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		const SymmetricTensor<2,dim> eps_d = strain_at_qp<dim>(qp);
+
+		Number eps[Sacado_Wrapper::SymTensor<dim>::n_dofs];
+		for ( unsigned int x=0; x<Sacado_Wrapper::SymTensor<dim>::n_dofs; ++x )
+			eps[x] = Number( N, x, eps_d[Sacado_Wrapper::index_i<dim>(x)][Sacado_Wrapper::index_j<dim>(x)] );
+		const Number phi ( N, phi_dof, 0.3 );
+
+		const Number energy = energy_components<Number>( eps[0], eps[3], eps[5], eps[1], eps[2], eps[4], phi, lambda, mu );
+
+		for ( unsigned int y=0; y<Sacado_Wrapper::SymTensor<dim>::n_dofs; ++y )
+		{
+			const unsigned int i = Sacado_Wrapper::index_i<dim>(y);
+			const unsigned int j = Sacado_Wrapper::index_j<dim>(y);
+			const double scale_y = Sacado_Wrapper::voigt_scale<dim>(y);
+
+			results.sigma[i][j] += scale_y * energy.dx(y);
+			results.d_sigma_d_phi[i][j] += scale_y * energy.dx2(y,phi_dof);
+
+			// Upper triangle, mirrored
+			 for ( unsigned int x=y; x<Sacado_Wrapper::SymTensor<dim>::n_dofs; ++x )
+			 {
+				const unsigned int k = Sacado_Wrapper::index_i<dim>(x);
+				const unsigned int l = Sacado_Wrapper::index_j<dim>(x);
+				const double C_ijkl = scale_y * Sacado_Wrapper::voigt_scale<dim>(x) * energy.dx2(y,x);
+				results.C[i][j][k][l] += C_ijkl;
+				if ( x!=y )
+					results.C[k][l][i][j] += C_ijkl;
+			 }
+		}
+		results.d2_psi_d_phi2 += energy.dx2(phi_dof,phi_dof);
+	}
+
+	return results;
+}
+
+
+/*
+ * Curvature d2_norm(eps)/d_eps2 via SymmetricTensor::norm (deal.II calls std::sqrt) with the second-order data type from \a Policy
+ */
+template<typename Policy>
+SymmetricTensor<4,3> norm_curvature ( const unsigned int nbr_total_dofs )
+{
+	typename Policy::template SymTensor2_type<3> eps;
+	eps.reseed( strain_at_qp<3>(0), nbr_total_dofs );
+
+	SymmetricTensor<4,3> d2_norm_d_eps2;
+	eps.get_curvature(d2_norm_d_eps2, eps.norm());
+	return d2_norm_d_eps2;
+}
+
+
+int main ()
+{
+	const unsigned int n_qps = 200000;
+
+	const double lambda = 1;
+	const double mu = 2;
+
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<3,1>::value;
+
+	QPSums<3> results_DFad, results_DFad_components, results_HyperDual, results_HyperDual_wrapper;
+
+	{
+		TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+		timer.enter_subsection("DFad<DFad> (Test 8 path)");
+		 results_DFad = evaluate_wrapper<Sacado_Wrapper::DFad_policy,false>( n_qps, lambda, mu );
+		timer.leave_subsection();
+
+		timer.enter_subsection("DFad<DFad> components");
+		 results_DFad_components = evaluate_wrapper<Sacado_Wrapper::DFad_policy,true>( n_qps, lambda, mu );
+		timer.leave_subsection();
+
+		timer.enter_subsection("HyperDual<7>");
+		 results_HyperDual = evaluate_HyperDual( n_qps, lambda, mu );
+		timer.leave_subsection();
+
+		timer.enter_subsection("HyperDual<7> (Test 8 path)");
+		 results_HyperDual_wrapper = evaluate_wrapper<Sacado_Wrapper::HyperDual_policy<N>,false>( n_qps, lambda, mu );
+		timer.leave_subsection();
+	}
+
+	std::cout << "Benchmark HyperDual: " << n_qps << " quadrature points" << std::endl;
+	std::cout << "sizeof(HyperDual<7>)=" << sizeof(Sacado_Wrapper::HyperDual<7>) << " bytes" << std::endl;
+
+	const SymmetricTensor<4,3> norm_curvature_DFad = norm_curvature<Sacado_Wrapper::DFad_policy>(N);
+	const SymmetricTensor<4,3> norm_curvature_HyperDual = norm_curvature<Sacado_Wrapper::HyperDual_policy<N> >(N);
+
+	bool passed = check_error( "DFad<DFad> components vs Test 8 path", results_DFad_components.error(results_DFad) );
+	passed &= check_error( "HyperDual vs DFad<DFad>", results_HyperDual.error(results_DFad) );
+	passed &= check_error( "HyperDual vs DFad<DFad> for the curvature of eps.norm()",
+						   (norm_curvature_HyperDual-norm_curvature_DFad).norm() / std::max( 1., norm_curvature_DFad.norm() ) );
+	passed &= check_error( "HyperDual (Test 8 path) vs DFad<DFad>", results_HyperDual_wrapper.error(results_DFad) );
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/*
+ * Benchmark: AD with respect to the invariants I1, I2, I3 (StrainInvariants) vs. all strain components (SymTensor2)
+ *
+ * The strain energy density from \ref Ex7 "example 7" is evaluated at \a n_qps quadrature points
+ * - as in example 8 with the SymTensor2, SW_double2 and DoFs_summary (6+1 dofs), with DFad<DFad> and SFad<SFad<7>>
+ * - written in the invariants, where only I1, I2, I3 and phi are seeded (3+1 dofs) and the stress and the tangent are
+ *   assembled with the analytical derivatives of the invariants (see Sacado-invariants.h), with DFad<DFad> and SFad<SFad<4>>
+ * At every quadrature point the stress, the tangent, d2_psi/d_eps_d_phi and d2_psi/d_phi2 are extracted, and the sums are
+ * compared to those of the SymTensor2 with DFad<DFad>.
+ * The energy of example 7 does not depend on I3, so the same is repeated for an energy with additional terms in
+ * I3 = det(eps), which also need d2_I3/d_eps2 and the mixed derivatives of I3 with I1, I2 and phi.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-invariants.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+const double lambda = 1;
+const double mu = 2;
+
+
+/*
+ * Energy from example 7 in the invariants of the strain, with trace(eps²) = I1² - 2 I2 (\a I3 is not needed)
+ */
+template<typename Number2>
+Number2 energy_invariants ( const Number2 &I1, const Number2 &I2, const Number2 &I3, const Number2 &phi )
+{
+	(void)I3;
+	return lambda/2. * I1*I1 + mu * ( I1*I1 - 2.*I2 ) + 25. * phi * I1;
+}
+
+
+/*
+ * Energy from example 7 plus terms in I3 = det(eps), coupled with all the other arguments
+ */
+template<typename Number2>
+Number2 energy_det_invariants ( const Number2 &I1, const Number2 &I2, const Number2 &I3, const Number2 &phi )
+{
+	return energy_invariants<Number2>( I1, I2, I3, phi ) + I3 * ( 0.5 + 0.1*I1 + 0.05*I2 + 1e-3*I3 + 2.*phi );
+}
+
+
+/*
+ * The same energy with the invariants computed from the strain components
+ */
+template<typename Number2>
+Number2 energy_det_eps_phi ( const SymmetricTensor<2,dim,Number2> &eps, const Number2 &phi )
+{
+	// Compute eps² = eps_ij * eps_jk in index notation (see energy_eps_phi)
+	 SymmetricTensor<2,dim,Number2> eps_squared;
+	 for ( unsigned int i=0; i<dim; ++i)
+		for ( unsigned int k=0; k<dim; ++k )
+			for ( unsigned int j=0; j<dim; ++j )
+				if ( i>=k )
+					eps_squared[i][k] += eps[i][j] * eps[j][k];
+
+	const Number2 I1 = trace(eps);
+	const Number2 I2 = 0.5 * ( I1*I1 - trace(eps_squared) );
+	const Number2 I3 = determinant(eps);
+	return energy_det_invariants<Number2>( I1, I2, I3, phi );
+}
+
+
+// All strain components and phi seeded (example 8), with the energy of example 7 or with the terms in det(eps)
+ template<typename Policy, bool with_det>
+ QPSums<dim> evaluate_SymTensor2 ( const unsigned int n_qps )
+ {
+	typedef typename Policy::fad2_type Number2;
+
+	typename Policy::template SymTensor2_type<dim> eps;
+	typename Policy::template SW_double2_type<dim> phi;
+	typename Policy::template DoFs_summary_type<dim> DoFs_summary;
+
+	QPSums<dim> results;
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		const Number2 energy = with_det ? energy_det_eps_phi<Number2>( eps, phi )
+										: energy_eps_phi<dim,Number2>( eps, phi, lambda, mu );
+
+		SymmetricTensor<2,dim> sigma, d2_psi_d_eps_d_phi;
+		SymmetricTensor<4,dim> C;
+		double d2_psi_d_phi2;
+		eps.get_tangent(sigma, energy);
+		eps.get_curvature(C, energy);
+		phi.get_curvature(d2_psi_d_phi2, energy);
+		DoFs_summary.get_curvature(d2_psi_d_eps_d_phi, energy, eps, phi);
+
+		results.sigma += sigma;
+		results.C += C;
+		results.d_sigma_d_phi += d2_psi_d_eps_d_phi;
+		results.d2_psi_d_phi2 += d2_psi_d_phi2;
+	}
+	return results;
+ }
+
+
+// Only the invariants and phi seeded
+ template<typename Number2, bool with_det>
+ QPSums<dim> evaluate_invariants ( const unsigned int n_qps )
+ {
+	Sacado_Wrapper::StrainInvariants<dim,1,Number2> invariants;
+
+	QPSums<dim> results;
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		invariants.reseed( strain_at_qp<dim>(qp), {{0.3}} );
+
+		const Number2 energy = with_det ? energy_det_invariants<Number2>( invariants.I1(), invariants.I2(), invariants.I3(), invariants.scalar(0) )
+										: energy_invariants<Number2>( invariants.I1(), invariants.I2(), invariants.I3(), invariants.scalar(0) );
+
+		SymmetricTensor<2,dim> sigma, d2_psi_d_eps_d_phi;
+		SymmetricTensor<4,dim> C;
+		double d2_psi_d_phi2;
+		invariants.get_tangent(sigma, energy);
+		invariants.get_curvature(C, energy);
+		invariants.get_curvature(d2_psi_d_phi2, energy, 0, 0);
+		invariants.get_curvature(d2_psi_d_eps_d_phi, energy, 0);
+
+		results.sigma += sigma;
+		results.C += C;
+		results.d_sigma_d_phi += d2_psi_d_eps_d_phi;
+		results.d2_psi_d_phi2 += d2_psi_d_phi2;
+	}
+	return results;
+ }
+
+
+int main ()
+{
+	const unsigned int n_qps = 200000;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+	const unsigned int N_invariants = Sacado_Wrapper::StrainInvariants<dim,1>::n_dofs;
+
+	typedef Sacado::Fad::DFad<Sacado::Fad::DFad<double> > DFad2;
+	typedef Sacado::Fad::SFad<Sacado::Fad::SFad<double,N_invariants>,N_invariants> SFad2_invariants;
+
+	QPSums<dim> results_DFad, results_SFad, results_invariants_DFad, results_invariants_SFad;
+	QPSums<dim> results_det_DFad, results_det_invariants_DFad, results_det_invariants_SFad;
+	{
+		TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+		timer.enter_subsection("SymTensor2 DFad<DFad> (7 dofs)");
+		 results_DFad = evaluate_SymTensor2< Sacado_Wrapper::DFad_policy, false >( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("SymTensor2 SFad<SFad<7>> (7 dofs)");
+		 results_SFad = evaluate_SymTensor2< Sacado_Wrapper::SFad_policy<N>, false >( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("Invariants DFad<DFad> (4 dofs)");
+		 results_invariants_DFad = evaluate_invariants< DFad2, false >( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("Invariants SFad<SFad<4>> (4 dofs)");
+		 results_invariants_SFad = evaluate_invariants< SFad2_invariants, false >( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("det(eps): SymTensor2 DFad<DFad> (7 dofs)");
+		 results_det_DFad = evaluate_SymTensor2< Sacado_Wrapper::DFad_policy, true >( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("det(eps): Invariants DFad<DFad> (4 dofs)");
+		 results_det_invariants_DFad = evaluate_invariants< DFad2, true >( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("det(eps): Invariants SFad<SFad<4>> (4 dofs)");
+		 results_det_invariants_SFad = evaluate_invariants< SFad2_invariants, true >( n_qps );
+		timer.leave_subsection();
+	}
+
+	std::cout << "Benchmark invariant-based AD: " << n_qps << " quadrature points" << std::endl;
+	bool passed = check_error( "SymTensor2 SFad vs DFad", results_SFad.error(results_DFad) );
+	passed &= check_error( "Invariants DFad vs SymTensor2", results_invariants_DFad.error(results_DFad) );
+	passed &= check_error( "Invariants SFad vs SymTensor2", results_invariants_SFad.error(results_DFad) );
+	passed &= check_error( "det(eps): Invariants DFad vs SymTensor2", results_det_invariants_DFad.error(results_det_DFad) );
+	passed &= check_error( "det(eps): Invariants SFad vs SymTensor2", results_det_invariants_SFad.error(results_det_DFad) );
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+/*
+ * Benchmark: Kokkos backend vs. the deal.II tensor path of the wrapper
+ *
+ * The stress, the tangent and d_sigma_d_phi from \ref Ex4 "example 4" (see \a stress_eps_phi) are computed with SFad<7> at
+ * \a n_qps points by
+ * - deal.II: the wrapper variables (SymTensor_SFad, SW_double_SFad) reseeded at every point, serial
+ * - Kokkos: a KokkosPointBatch with all points in Kokkos views of SFad<7>, evaluated by a parallel_for on the OpenMP host
+ *   execution space with all its threads (see Sacado-kokkos_batch.h)
+ * Besides the wall times, the throughput per thread and the relative error of the sums of the Kokkos results vs. the
+ * deal.II path are listed. The benchmark fails if the error exceeds the tolerance.
+ *
+ * @note Only built with the CMake option SACADO_WRAPPER_WITH_KOKKOS (Trilinos configured with Kokkos and OpenMP).
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// Timer: to measure the wall time of each run
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-kokkos_batch.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+typedef Sacado::Fad::SFad<double,N> Number;
+
+
+double phi_at_qp ( const unsigned int qp )
+{
+	return 1e-3 * (qp%1000);
+}
+
+
+void print_run ( const std::string &name, const unsigned int n_threads, const double wall_time, const unsigned int n_qps, const double error )
+{
+	std::cout << std::setw(10) << name << std::setw(10) << n_threads << std::setw(16) << wall_time
+			  << std::setw(16) << n_qps/wall_time/n_threads << std::setw(14) << error << std::endl;
+}
+
+
+int main ( int argc, char **argv )
+{
+	bool passed = true;
+
+	Kokkos::initialize(argc, argv);
+	{
+		const unsigned int n_qps = 1000000;
+
+		std::cout << "Benchmark Kokkos backend: " << n_qps << " points" << std::endl;
+		std::cout << std::setw(10) << "path" << std::setw(10) << "threads" << std::setw(16) << "wall time [s]"
+				  << std::setw(16) << "QPs/s/thread" << std::setw(14) << "error" << std::endl;
+
+		// deal.II tensor path: The sums of the results of all points for the comparison
+		 QPSums<dim> reference;
+		 {
+			Sacado_Wrapper::SymTensor_SFad<dim,N> eps;
+			Sacado_Wrapper::SW_double_SFad<dim,N> phi;
+			Sacado_Wrapper::DoFs_summary_SFad<dim,N> DoFs_summary;
+
+			Timer timer;
+			for ( unsigned int qp=0; qp<n_qps; ++qp )
+			{
+				DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, phi_at_qp(qp));
+
+				const SymmetricTensor<2,dim,Number> sigma = stress_eps_phi<dim,Number>( eps, phi );
+
+				SymmetricTensor<4,dim> C;
+				SymmetricTensor<2,dim> d_sigma_d_phi;
+				eps.get_tangent(C, sigma);
+				phi.get_tangent(d_sigma_d_phi, sigma);
+				reference.C += C;
+				reference.d_sigma_d_phi += d_sigma_d_phi;
+				for ( unsigned int i=0; i<dim; ++i )
+					for ( unsigned int j=i; j<dim; ++j )
+						reference.sigma[i][j] += sigma[i][j].val();
+			}
+			timer.stop();
+			print_run( "deal.II", 1, timer.wall_time(), n_qps, 0. );
+		 }
+
+		// Kokkos path: The filling of the input views is not timed (it is the same as filling a SymTensorBatch)
+		 {
+			Sacado_Wrapper::KokkosPointBatch<dim,N> batch (n_qps);
+			for ( unsigned int qp=0; qp<n_qps; ++qp )
+				batch.set( qp, strain_at_qp<dim>(qp), phi_at_qp(qp) );
+
+			Timer timer;
+			batch.evaluate( [] ( const SymmetricTensor<2,dim,Number> &eps, const Number &phi )
+			{
+				return stress_eps_phi<dim,Number>( eps, phi );
+			});
+			timer.stop();
+
+			QPSums<dim> results;
+			for ( unsigned int qp=0; qp<n_qps; ++qp )
+			{
+				results.sigma += batch.get_stress(qp);
+				results.C += batch.get_tangent(qp);
+				results.d_sigma_d_phi += batch.get_d_sigma_d_phi(qp);
+			}
+			const double error = results.error(reference);
+
+			print_run( "Kokkos", Sacado_Wrapper::kokkos_execution_space::concurrency(), timer.wall_time(), n_qps, error );
+			passed = check_error( "Kokkos vs deal.II", error );
+		 }
+	}
+	Kokkos::finalize();
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+/*
+ * Benchmark: Heap allocated derivative arrays (Sacado::Fad::DFad) versus the memory pools (DMFad with the MemPoolManager
+ * and the thread-local PoolFad)
+ *
+ * The energy from example 8 is evaluated with the second-order wrapper at \a n_qps quadrature points, where all the
+ * derivative arrays (wrapper variables and intermediates) are dynamically sized:
+ * - single thread: DFad, DMFad (pool selected by the DoFs_summary) and PoolFad
+ * - \a n_threads threads, each evaluating its share of the quadrature points: DFad and PoolFad (DMFad cannot be used,
+ *   because its pool is shared by all threads)
+ * The pool statistics of every thread show that after the first quadrature point all blocks come from the free lists.
+ * Finally, two checks of the thread-local pools:
+ * - a worker thread that starts with the nested reseed and exits afterwards (destruction order of the pools of a thread)
+ * - blocks taken on the main thread and freed on a worker thread (bounded free lists)
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <cmath>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-memory_pool.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Quadrature points [qp_begin, qp_end) with the data types of the \a Policy
+ */
+template<typename Policy>
+QPSums<3> evaluate_qps ( const unsigned int qp_begin, const unsigned int qp_end, const double lambda, const double mu )
+{
+	const unsigned int dim=3;
+	typedef typename Policy::fad2_type Number2;
+
+	QPSums<3> results;
+
+	typename Policy::template SymTensor2_type<dim> eps;
+	typename Policy::template SW_double2_type<dim> phi;
+	typename Policy::template DoFs_summary_type<dim> DoFs_summary;
+
+	for ( unsigned int qp=qp_begin; qp<qp_end; ++qp )
+	{
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		Number2 energy = energy_eps_phi<dim,Number2>( eps, phi, lambda, mu );
+
+		SymmetricTensor<2,dim> sigma;
+		eps.get_tangent(sigma, energy);
+		results.sigma += sigma;
+
+		SymmetricTensor<4,dim> C;
+		eps.get_curvature(C, energy);
+		results.C += C;
+
+		double d2_psi_d_phi2;
+		phi.get_curvature(d2_psi_d_phi2, energy);
+		results.d2_psi_d_phi2 += d2_psi_d_phi2;
+	}
+
+	return results;
+}
+
+
+/*
+ * The quadrature points split into \a n_threads contiguous blocks, one per thread. The pool statistics of each
+ * thread are collected into \a statistics.
+ */
+template<typename Policy>
+QPSums<3> evaluate_threads ( const unsigned int n_qps, const unsigned int n_threads, const double lambda, const double mu,
+						   std::vector<Sacado_Wrapper::PoolStatistics> &statistics )
+{
+	std::vector<QPSums<3>> results (n_threads);
+	statistics.assign(n_threads, Sacado_Wrapper::PoolStatistics());
+
+	std::vector<std::thread> threads;
+	for ( unsigned int t=0; t<n_threads; ++t )
+		threads.emplace_back( [&,t] ()
+		{
+			Sacado_Wrapper::ThreadLocalPool<double>::reset_statistics();
+			results[t] = evaluate_qps<Policy>( (n_qps*t)/n_threads, (n_qps*(t+1))/n_threads, lambda, mu );
+			statistics[t] = Sacado_Wrapper::ThreadLocalPool<double>::statistics();
+		});
+	for ( std::thread &thread : threads )
+		thread.join();
+
+	QPSums<3> sum;
+	for ( const QPSums<3> &results_t : results )
+		sum += results_t;
+	return sum;
+}
+
+
+/*
+ * Nested reseed as the first use of the pools on a worker thread, which exits afterwards. The pools of the outer data type
+ * are then created before those of the inner one, but must be destroyed first (see ThreadLocalPool::FreeLists).
+ */
+QPSums<3> evaluate_on_exiting_thread ( const unsigned int n_qps, const double lambda, const double mu )
+{
+	QPSums<3> results;
+	std::thread worker ( [&] ()
+	{
+		// As in internal::pool_selector, the pool of the outer data type is used first
+		 Sacado_Wrapper::ThreadLocalPool< Sacado_Wrapper::PoolFad<double> >::reserve( Sacado_Wrapper::n_total_dofs<3,1>::value,
+																					  Sacado_Wrapper::n_pool_blocks );
+		results = evaluate_qps<Sacado_Wrapper::PoolFad_policy>( 0, n_qps, lambda, mu );
+	});
+	worker.join();
+	return results;
+}
+
+
+/*
+ * \a n_blocks blocks of 7 derivatives are taken on the calling thread and freed on a worker thread. Returns the statistics
+ * of the worker thread, which keeps only \a n_pool_blocks of them and returns the others to the heap.
+ */
+Sacado_Wrapper::PoolStatistics free_on_other_thread ( const unsigned int n_blocks )
+{
+	std::vector< Sacado_Wrapper::PoolFad<double> > variables;
+	for ( unsigned int i=0; i<n_blocks; ++i )
+		variables.emplace_back( 7, i%7, double(i) );
+
+	Sacado_Wrapper::PoolStatistics statistics;
+	std::thread worker ( [&] ()
+	{
+		variables.clear();
+		statistics = Sacado_Wrapper::ThreadLocalPool<double>::statistics();
+	});
+	worker.join();
+	return statistics;
+}
+
+
+int main ()
+{
+	const unsigned int n_qps = 1000000;
+	const unsigned int n_threads = MultithreadInfo::n_cores();
+
+	const double lambda = 1;
+	const double mu = 2;
+
+	std::vector<Sacado_Wrapper::PoolStatistics> statistics_DFad, statistics_pool;
+	QPSums<3> DFad_threads, pool_threads;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	 timer.enter_subsection("DFad 1 thread");
+	  const QPSums<3> reference = evaluate_qps<Sacado_Wrapper::DFad_policy>( 0, n_qps, lambda, mu );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("DMFad 1 thread");
+	  const QPSums<3> DMFad = evaluate_qps<Sacado_Wrapper::DMFad_policy>( 0, n_qps, lambda, mu );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("PoolFad 1 thread");
+	  Sacado_Wrapper::ThreadLocalPool<double>::reset_statistics();
+	  const QPSums<3> pool = evaluate_qps<Sacado_Wrapper::PoolFad_policy>( 0, n_qps, lambda, mu );
+	 timer.leave_subsection();
+	 const Sacado_Wrapper::PoolStatistics statistics_main = Sacado_Wrapper::ThreadLocalPool<double>::statistics();
+
+	 timer.enter_subsection("DFad n threads");
+	  DFad_threads = evaluate_threads<Sacado_Wrapper::DFad_policy>( n_qps, n_threads, lambda, mu, statistics_DFad );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("PoolFad n threads");
+	  pool_threads = evaluate_threads<Sacado_Wrapper::PoolFad_policy>( n_qps, n_threads, lambda, mu, statistics_pool );
+	 timer.leave_subsection();
+
+	std::cout << "Benchmark memory pool: " << n_qps << " quadrature points, " << n_threads << " threads" << std::endl;
+	bool passed = check_error( "DMFad vs DFad", DMFad.error(reference) );
+	passed &= check_error( "PoolFad vs DFad", pool.error(reference) );
+	passed &= check_error( "DFad threads vs DFad", DFad_threads.error(reference) );
+	passed &= check_error( "PoolFad threads vs DFad", pool_threads.error(reference) );
+
+	// Pool statistics of the inner derivative arrays (double)
+	 std::cout << "PoolFad 1 thread: ";
+	 statistics_main.print(std::cout);
+	 Sacado_Wrapper::PoolStatistics statistics_sum;
+	 for ( unsigned int t=0; t<n_threads; ++t )
+	 {
+		std::cout << "PoolFad thread " << t << ": ";
+		statistics_pool[t].print(std::cout);
+		statistics_sum += statistics_pool[t];
+	 }
+	 std::cout << "PoolFad all threads: ";
+	 statistics_sum.print(std::cout);
+
+	const unsigned int n_qps_exit = 100;
+	passed &= check_error( "PoolFad on an exiting thread vs DFad",
+						   evaluate_on_exiting_thread( n_qps_exit, lambda, mu )
+						   .error( evaluate_qps<Sacado_Wrapper::DFad_policy>( 0, n_qps_exit, lambda, mu ) ) );
+
+	const unsigned int n_blocks_foreign = 4 * Sacado_Wrapper::n_pool_blocks;
+	const Sacado_Wrapper::PoolStatistics statistics_foreign = free_on_other_thread( n_blocks_foreign );
+	std::cout << "PoolFad freed on another thread: ";
+	statistics_foreign.print(std::cout);
+	if ( statistics_foreign.n_heap_deallocations!=n_blocks_foreign-Sacado_Wrapper::n_pool_blocks )
+	{
+		std::cout << "ERROR: The free list of a thread must keep at most " << Sacado_Wrapper::n_pool_blocks
+				  << " blocks freed on this thread but taken on another one." << std::endl;
+		passed = false;
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+/*
+ * Benchmark: Constants as double (mixed-type tensor operations) vs. constants promoted to the Sacado data type
+ *
+ * The stress law from \ref Ex3 "example 3"
+ * \f[ \sigma = \kappa \cdot trace(\varepsilon) \cdot \boldsymbol{I} + 2 \cdot \mu \cdot \varepsilon^{dev} \f]
+ * and its tangent are computed at \a n_qps quadrature points with
+ * - promoted: as in example 3, with the unit and deviatoric tensors and \a kappa as Sacado data types
+ * - promoted C:eps: the constant tangent kappa I x I + 2 mu I^dev built from the Sacado data type and contracted with eps
+ * - mixed: the same equation with the constants as double (Sacado_Wrapper::scale, see Sacado-mixed_tensor_ops.h)
+ * - mixed C:eps: the double tangent contracted with eps (Sacado_Wrapper::double_contract)
+ * each with DFad and SFad<6>. The tangents are compared to the analytical one, and the benchmark fails if the relative
+ * error of any variant exceeds the tolerance.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-mixed_tensor_ops.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+const double kappa_d = 5;
+const double mu_d = 2;
+
+
+enum class Variant
+{
+	promoted,
+	promoted_contraction,
+	mixed,
+	mixed_contraction
+};
+
+
+template<typename Policy>
+SymmetricTensor<4,dim> evaluate_qps ( const Variant variant, const unsigned int n_qps )
+{
+	typedef typename Policy::fad_type Number;
+
+	// The constant tangent as double and (for the promoted contraction) as the Sacado data type
+	 const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+	 const SymmetricTensor<4,dim> C_iso = kappa_d * outer_product(I, I) + 2. * mu_d * deviator_tensor<dim>();
+	 SymmetricTensor<4,dim,Number> C_iso_fad;
+	 for ( unsigned int i=0; i<dim; ++i )
+		for ( unsigned int j=i; j<dim; ++j )
+			for ( unsigned int k=0; k<dim; ++k )
+				for ( unsigned int l=k; l<dim; ++l )
+					C_iso_fad[i][j][k][l] = C_iso[i][j][k][l];
+
+	typename Policy::template SymTensor_type<dim> eps;
+	SymmetricTensor<4,dim> C_sum;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		eps.reseed( strain_at_qp<dim>(qp) );
+
+		SymmetricTensor<2,dim,Number> sigma;
+		switch ( variant )
+		{
+			case Variant::promoted:
+			{
+				// Example 3: The constants are built from the Sacado data type, because the deal.II operators need equal number types
+				 const Number kappa = kappa_d;
+				 const SymmetricTensor<2,dim,Number> stdTensor_I (( unit_symmetric_tensor<dim,Number>()) );
+				 const SymmetricTensor<4,dim,Number> stdTensor_Idev ( (deviator_tensor<dim,Number>()) );
+				 (void) stdTensor_Idev;
+				sigma = kappa * (trace(eps) * stdTensor_I);
+				SymmetricTensor<2,dim,Number> tmp = deviator<dim,Number>(symmetrize<dim,Number>(eps));
+				tmp *= (mu_d*2);
+				sigma += tmp;
+				break;
+			}
+			case Variant::promoted_contraction:
+			{
+				for ( unsigned int i=0; i<dim; ++i )
+					for ( unsigned int j=i; j<dim; ++j )
+						for ( unsigned int k=0; k<dim; ++k )
+							for ( unsigned int l=0; l<dim; ++l )
+								sigma[i][j] += C_iso_fad[i][j][k][l] * eps[k][l];
+				break;
+			}
+			case Variant::mixed:
+			{
+				sigma = Sacado_Wrapper::scale( kappa_d*trace(eps), I );
+				sigma += Sacado_Wrapper::scale( 2.*mu_d, deviator<dim,Number>(eps) );
+				break;
+			}
+			case Variant::mixed_contraction:
+			{
+				sigma = Sacado_Wrapper::double_contract( C_iso, eps );
+				break;
+			}
+		}
+
+		SymmetricTensor<4,dim> C;
+		eps.get_tangent(C, sigma);
+		C_sum += C;
+	}
+
+	return C_sum;
+}
+
+
+// Returns whether all variants agree with the analytical tangent
+ template<typename Policy>
+ bool run_variants ( const std::string &name, const unsigned int n_qps, TimerOutput &timer )
+ {
+	const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+	const SymmetricTensor<4,dim> C_analy = kappa_d * outer_product(I, I) + 2. * mu_d * deviator_tensor<dim>();
+
+	const std::vector<std::pair<Variant,std::string> > variants = { {Variant::promoted, "promoted"},
+																	{Variant::promoted_contraction, "promoted C:eps"},
+																	{Variant::mixed, "mixed"},
+																	{Variant::mixed_contraction, "mixed C:eps"} };
+	bool passed = true;
+	for ( const std::pair<Variant,std::string> &variant : variants )
+	{
+		timer.enter_subsection(name + " " + variant.second);
+		 const SymmetricTensor<4,dim> C_sum = evaluate_qps<Policy>( variant.first, n_qps );
+		timer.leave_subsection();
+
+		passed &= check_error( name + " " + variant.second + " vs analytical tangent",
+							   (C_sum/double(n_qps) - C_analy).norm() / C_analy.norm() );
+	}
+	return passed;
+ }
+
+
+int main ()
+{
+	const unsigned int n_qps = 1000000;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	std::cout << "Benchmark mixed-type tensor operations: " << n_qps << " quadrature points" << std::endl;
+
+	bool passed = run_variants< Sacado_Wrapper::DFad_policy >    ( "DFad",    n_qps, timer );
+	passed &= run_variants< Sacado_Wrapper::SFad_policy<N> > ( "SFad<6>", n_qps, timer );
+
+	return passed ? 0 : 1;
+}
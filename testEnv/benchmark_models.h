@@ -0,0 +1,163 @@
+#ifndef benchmark_models_H
+#define benchmark_models_H
+
+// @section includes Include Files
+// The data type SymmetricTensor and some related operations, such as trace, symmetrize, deviator, ... for tensor calculus
+#include <deal.II/base/symmetric_tensor.h>
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+using namespace dealii;
+
+/*
+ * Material models from the examples in Sacado_example.cc, collected here such that the benchmarks can
+ * evaluate them with different data types.
+ */
+
+
+/*
+ * Stress equation from \ref Ex10 "example 10":
+ * \f[ \sigma = \kappa \cdot trace(\varepsilon) \cdot \boldsymbol{I} + 2 \cdot \mu \cdot \varepsilon^{dev} \f]
+ */
+template<int dim, typename Number>
+SymmetricTensor<2,dim,Number> stress_strain_relation ( const SymmetricTensor<2,dim,Number> &eps, const double &kappa, const double &mu )
+{
+	SymmetricTensor<2,dim,Number> sigma;
+
+	SymmetricTensor<2,dim,Number> stdTensor_I (( unit_symmetric_tensor<dim,Number>()) );
+
+	// Our stress equation is now computed in index notation to simplify the use of the constants and
+	// especially the use of the \a deviator.
+	 for ( unsigned int i=0; i<dim; ++i)
+		for ( unsigned int j=0; j<dim; ++j )
+			sigma[i][j] = kappa * trace(eps) *  stdTensor_I[i][j] + 2. * mu * deviator(eps)[i][j];
+
+	return sigma;
+}
+
+
+/*
+ * Stress equation from \ref Ex4 "example 4" with the strain \a eps and the damage variable \a phi:
+ * \f[ \sigma = \varphi \cdot d \cdot \varepsilon \quad with \quad d = \varphi^2 + 25 + trace(\varepsilon) + \|\varepsilon\| \f]
+ * @note Call this with explicit template arguments (see \a energy_eps_phi)
+ */
+template<int dim, typename Number>
+SymmetricTensor<2,dim,Number> stress_eps_phi ( const SymmetricTensor<2,dim,Number> &eps, const Number &phi )
+{
+	const Number d = phi*phi + 25 + trace(eps) + eps.norm();
+
+	SymmetricTensor<2,dim,Number> sigma;
+	for ( unsigned int i=0; i<dim; ++i)
+		for ( unsigned int j=i; j<dim; ++j )
+			sigma[i][j] = phi * d * eps[i][j];
+
+	return sigma;
+}
+
+
+/*
+ * Strain energy density from \ref Ex7 "example 7" and \ref Ex8 "example 8" for the two-field problem with the strain
+ * \a eps and the scalar \a phi:
+ * \f[ \Psi = \frac{\lambda}{2} \cdot trace(\varepsilon)^2 + \mu \cdot trace(\varepsilon^2) + 25 \cdot \varphi \cdot trace(\varepsilon) \f]
+ * @note Call this with explicit template arguments, e.g. energy_eps_phi<dim,Number>(eps_fad, phi_fad, lambda, mu),
+ * because the wrapper data types (SymTensor, SW_double, ...) are only derived from SymmetricTensor and \a Number.
+ */
+template<int dim, typename Number>
+Number energy_eps_phi ( const SymmetricTensor<2,dim,Number> &eps, const Number &phi, const double &lambda, const double &mu )
+{
+	// Compute eps² = eps_ij * eps_jk in index notation
+	 SymmetricTensor<2,dim,Number> eps_squared;
+	 for ( unsigned int i=0; i<dim; ++i)
+		for ( unsigned int k=0; k<dim; ++k )
+			for ( unsigned int j=0; j<dim; ++j )
+				if ( i>=k )
+					eps_squared[i][k] += eps[i][j] * eps[j][k];
+
+	return lambda/2. * trace(eps)*trace(eps) + mu * trace(eps_squared) + 25. * phi * trace(eps);
+}
+
+
+/*
+ * A strain tensor for the quadrature point \a qp, slightly varied around the point from the examples
+ * such that the compiler cannot hoist the computations out of the benchmark loops.
+ */
+template<int dim>
+SymmetricTensor<2,dim> strain_at_qp ( const unsigned int qp )
+{
+	SymmetricTensor<2,dim> eps_d;
+	const double shift = 1e-6 * (qp%1000);
+
+	eps_d[0][0] = 1 + shift;
+	eps_d[1][1] = 2 - shift;
+	eps_d[0][1] = 4 + shift;
+	if ( dim==3 )
+	{
+		eps_d[2][2] = 3 + shift;
+		eps_d[0][dim-1] = 5 - shift;
+		eps_d[1][dim-1] = 6 + shift;
+	}
+
+	return eps_d;
+}
+
+
+/*
+ * Sums of the quantities extracted at all quadrature points (also to keep the compiler from skipping the computation).
+ * Each benchmark adds up only the quantities it extracts, the others remain zero.
+ */
+template<int dim>
+struct QPSums
+{
+	SymmetricTensor<2,dim> sigma;			// stress or d_psi/d_eps
+	SymmetricTensor<4,dim> C;				// d_sigma/d_eps or d2_psi/d_eps2
+	SymmetricTensor<2,dim> d_sigma_d_phi;	// d_sigma/d_phi or d2_psi/d_eps_d_phi
+	double d_psi_d_phi = 0.;
+	double d2_psi_d_phi2 = 0.;
+
+	QPSums &operator+= ( const QPSums &other )
+	{
+		sigma += other.sigma;
+		C += other.C;
+		d_sigma_d_phi += other.d_sigma_d_phi;
+		d_psi_d_phi += other.d_psi_d_phi;
+		d2_psi_d_phi2 += other.d2_psi_d_phi2;
+		return *this;
+	}
+
+	// The difference to the \a reference relative to the magnitude of the \a reference (but at least one)
+	 double error ( const QPSums &reference ) const
+	 {
+		const double difference = (sigma-reference.sigma).norm() + (C-reference.C).norm()
+								  + (d_sigma_d_phi-reference.d_sigma_d_phi).norm()
+								  + std::abs(d_psi_d_phi-reference.d_psi_d_phi) + std::abs(d2_psi_d_phi2-reference.d2_psi_d_phi2);
+		const double magnitude = reference.sigma.norm() + reference.C.norm() + reference.d_sigma_d_phi.norm()
+								 + std::abs(reference.d_psi_d_phi) + std::abs(reference.d2_psi_d_phi2);
+		return difference / std::max( 1., magnitude );
+	 }
+};
+
+
+// Relative error below which two data types or algorithms count as giving the same results
+ const double benchmark_tolerance = 1e-10;
+
+
+/*
+ * Print the \a error of the benchmark \a name and check it against the \a tolerance. The benchmarks return a non-zero exit
+ * code if any check fails (as benchmark_reseed.cc for heap allocations).
+ */
+inline bool check_error ( const std::string &name, const double error, const double tolerance=benchmark_tolerance )
+{
+	std::cout << "error " << name << ": " << error << std::endl;
+	if ( !(error<=tolerance) )
+	{
+		std::cout << "ERROR: The error of " << name << " exceeds the tolerance " << tolerance << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+
+#endif // benchmark_models_H
@@ -0,0 +1,147 @@
+/*
+ * Benchmark: The padded and aligned PaddedFad<N> versus Sacado::Fad::DFad<double> and Sacado::Fad::SFad<double,N>
+ *
+ * The two-field problems with the strain \a eps (6 dofs) and the scalar \a phi (1 dof) are evaluated at \a n_qps
+ * quadrature points with the first-order wrapper (SymTensor, SW_double and DoFs_summary), i.e. with 7 dofs, where
+ * SFad<double,7> loops over 7 derivatives and PaddedFad<7> over 8 (two SIMD instructions with AVX2):
+ * - "Test 4": the stress \a stress_eps_phi and its tangents d_sigma/d_eps and d_sigma/d_phi
+ * - "Test 7": the energy \a energy_eps_phi and its derivatives d_psi/d_eps (stress) and d_psi/d_phi
+ */
+
+// @section includes Include Files
+// First, such that the deal.II templates find the elementary functions of the number type in std
+#include "Sacado-padded_fad.h"
+
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Test 4: Stress and tangents for the first-order data type \a Number
+ */
+template<typename Number>
+QPSums<3> evaluate_stress ( const unsigned int n_qps )
+{
+	const unsigned int dim=3;
+
+	QPSums<3> results;
+
+	Sacado_Wrapper::SymTensor<dim,Number> eps;
+	Sacado_Wrapper::SW_double<dim,Number> phi;
+	Sacado_Wrapper::DoFs_summary<dim,Number> DoFs_summary;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		SymmetricTensor<2,dim,Number> sigma = stress_eps_phi<dim,Number>(eps, phi);
+
+		SymmetricTensor<4,dim> C;
+		eps.get_tangent(C, sigma);
+		SymmetricTensor<2,dim> d_sigma_d_phi;
+		phi.get_tangent(d_sigma_d_phi, sigma);
+
+		results.C += C;
+		results.d_sigma_d_phi += d_sigma_d_phi;
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				results.sigma[i][j] += sigma[i][j].val();
+	}
+
+	return results;
+}
+
+
+/*
+ * Test 7: Energy and its first derivatives for the first-order data type \a Number
+ */
+template<typename Number>
+QPSums<3> evaluate_energy ( const unsigned int n_qps, const double lambda, const double mu )
+{
+	const unsigned int dim=3;
+
+	QPSums<3> results;
+
+	Sacado_Wrapper::SymTensor<dim,Number> eps;
+	Sacado_Wrapper::SW_double<dim,Number> phi;
+	Sacado_Wrapper::DoFs_summary<dim,Number> DoFs_summary;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		Number energy = energy_eps_phi<dim,Number>(eps, phi, lambda, mu);
+
+		SymmetricTensor<2,dim> sigma;
+		eps.get_tangent(sigma, energy);
+		double d_psi_d_phi;
+		phi.get_tangent(d_psi_d_phi, energy);
+
+		results.sigma += sigma;
+		results.d_psi_d_phi += d_psi_d_phi;
+	}
+
+	return results;
+}
+
+
+int main ()
+{
+	const unsigned int dim=3;
+	const unsigned int n_qps = 1000000;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+
+	const double lambda = 5;
+	const double mu = 2;
+
+	QPSums<3> stress_DFad, stress_SFad, stress_padded, energy_DFad, energy_SFad, energy_padded;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	 timer.enter_subsection("Test 4 DFad");
+	  stress_DFad = evaluate_stress< Sacado::Fad::DFad<double> >( n_qps );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("Test 4 SFad<7>");
+	  stress_SFad = evaluate_stress< Sacado::Fad::SFad<double,N> >( n_qps );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("Test 4 PaddedFad<7>");
+	  stress_padded = evaluate_stress< Sacado_Wrapper::PaddedFad<N> >( n_qps );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("Test 7 DFad");
+	  energy_DFad = evaluate_energy< Sacado::Fad::DFad<double> >( n_qps, lambda, mu );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("Test 7 SFad<7>");
+	  energy_SFad = evaluate_energy< Sacado::Fad::SFad<double,N> >( n_qps, lambda, mu );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("Test 7 PaddedFad<7>");
+	  energy_padded = evaluate_energy< Sacado_Wrapper::PaddedFad<N> >( n_qps, lambda, mu );
+	 timer.leave_subsection();
+
+	// All data types must give the same results
+	 std::cout << "Benchmark padded Fad: " << n_qps << " quadrature points, " << N << " dofs padded to "
+			   << Sacado_Wrapper::PaddedFad<N>::n_padded << std::endl;
+	 bool passed = check_error( "Test 4 SFad      vs DFad", stress_SFad.error(stress_DFad) );
+	 passed &= check_error( "Test 4 PaddedFad vs DFad", stress_padded.error(stress_DFad) );
+	 passed &= check_error( "Test 7 SFad      vs DFad", energy_SFad.error(energy_DFad) );
+	 passed &= check_error( "Test 7 PaddedFad vs DFad", energy_padded.error(energy_DFad) );
+
+	return passed ? 0 : 1;
+}
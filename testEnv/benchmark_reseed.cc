@@ -0,0 +1,269 @@
+/*
+ * Benchmark: Reseeding preallocated wrapper variables in place versus new wrapper variables at every quadrature point
+ *
+ * The global operator new is replaced by a version that counts the heap allocations. With new SymTensor and SW_double
+ * objects at every quadrature point, the dynamically sized DFad allocates the derivative arrays again and again.
+ * When the objects are created once and reseeded via \a reseed at every quadrature point, the derivative arrays are
+ * reused, so after the first quadrature point (warm-up) there must be zero allocations per quadrature point.
+ * The program returns 1 if this is not the case.
+ *
+ * @note To obtain zero allocations, the material model itself must not create temporary DFad variables either. Hence,
+ * the energy from example 7/8 is assigned as a single expression into the preallocated variable \a energy
+ * (see \a energy_in_place). The statically sized SFad never allocates on the heap.
+ *
+ * Finally, the allocations per quadrature point are counted for the reseeded variables with the unmodified models from
+ * benchmark_models.h (energy_eps_phi, stress_eps_phi, stress_strain_relation). Their temporaries (e.g. eps², trace(eps),
+ * deviator(eps)) are new DFad variables, so these models still allocate with DFad, only the allocations for the seeded
+ * variables themselves are saved. These numbers are only reported, whereas SFad must not allocate for any model.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+// @section alloc Counting heap allocations
+// Number of calls to the global operator new (single-threaded program)
+ static unsigned long int n_allocations = 0;
+
+void* operator new ( std::size_t size )
+{
+	++n_allocations;
+	if ( void *ptr = std::malloc(size) )
+		return ptr;
+	throw std::bad_alloc();
+}
+void* operator new[] ( std::size_t size )
+{
+	return operator new(size);
+}
+void operator delete ( void *ptr ) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[] ( void *ptr ) noexcept
+{
+	std::free(ptr);
+}
+void operator delete ( void *ptr, std::size_t ) noexcept
+{
+	std::free(ptr);
+}
+void operator delete[] ( void *ptr, std::size_t ) noexcept
+{
+	std::free(ptr);
+}
+
+
+/*
+ * Energy from example 7/8 for dim=3 assigned as a single Sacado expression into \a energy, so no temporary
+ * Sacado variables are created. Here we use trace(eps²)=eps:eps for the symmetric strain tensor.
+ */
+template<typename Number>
+void energy_in_place ( Number &energy, const SymmetricTensor<2,3,Number> &eps, const Number &phi, const double &lambda, const double &mu )
+{
+	energy = lambda/2. * (eps[0][0]+eps[1][1]+eps[2][2]) * (eps[0][0]+eps[1][1]+eps[2][2])
+			 + mu * (   eps[0][0]*eps[0][0] + eps[1][1]*eps[1][1] + eps[2][2]*eps[2][2]
+					  + 2. * ( eps[0][1]*eps[0][1] + eps[0][2]*eps[0][2] + eps[1][2]*eps[1][2] ) )
+			 + 25. * phi * (eps[0][0]+eps[1][1]+eps[2][2]);
+}
+
+
+/*
+ * New wrapper variables at every quadrature point (the usual approach)
+ * @return Number of heap allocations per quadrature point
+ */
+template<typename Number>
+double evaluate_new_objects ( const unsigned int n_qps, const double lambda, const double mu, QPSums<3> &sums )
+{
+	const unsigned int dim=3;
+	const unsigned long int n_allocations_start = n_allocations;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		Sacado_Wrapper::SymTensor<dim,Number> eps;
+		Sacado_Wrapper::SW_double<dim,Number> phi;
+		Sacado_Wrapper::DoFs_summary<dim,Number> DoFs_summary;
+
+		SymmetricTensor<2,dim> eps_d = strain_at_qp<dim>(qp);
+		eps.init( eps_d );
+		phi.init( 0.3 );
+		DoFs_summary.set_dofs(eps, phi);
+
+		Number energy;
+		energy_in_place<Number>(energy, eps, phi, lambda, mu);
+
+		SymmetricTensor<2,dim> sigma;
+		eps.get_tangent(sigma, energy);
+		sums.sigma += sigma;
+	}
+
+	return double(n_allocations - n_allocations_start) / n_qps;
+}
+
+
+/*
+ * The wrapper variables and the output variables are created once and reseeded at every quadrature point
+ * @return Number of heap allocations per quadrature point after the warm-up at the first quadrature point
+ */
+template<typename Number>
+double evaluate_reseed ( const unsigned int n_qps, const double lambda, const double mu, QPSums<3> &sums )
+{
+	const unsigned int dim=3;
+
+	Sacado_Wrapper::SymTensor<dim,Number> eps;
+	Sacado_Wrapper::SW_double<dim,Number> phi;
+	Sacado_Wrapper::DoFs_summary<dim,Number> DoFs_summary;
+	Number energy;
+	SymmetricTensor<2,dim> sigma;
+
+	unsigned long int n_allocations_start = n_allocations;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		// Start counting after the warm-up
+		 if ( qp==1 )
+			 n_allocations_start = n_allocations;
+
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		energy_in_place<Number>(energy, eps, phi, lambda, mu);
+
+		eps.get_tangent(sigma, energy);
+		sums.sigma += sigma;
+	}
+
+	return double(n_allocations - n_allocations_start) / (n_qps-1);
+}
+
+
+enum class Model
+{
+	energy_eps_phi,
+	stress_eps_phi,
+	stress_strain
+};
+
+
+/*
+ * The reseeded wrapper variables with an unmodified model from benchmark_models.h
+ * @return Number of heap allocations per quadrature point after the warm-up at the first quadrature point
+ */
+template<typename Number>
+double evaluate_reseed_model ( const Model model, const unsigned int n_qps, const double lambda, const double mu, double &checksum )
+{
+	const unsigned int dim=3;
+
+	Sacado_Wrapper::SymTensor<dim,Number> eps;
+	Sacado_Wrapper::SW_double<dim,Number> phi;
+	Sacado_Wrapper::DoFs_summary<dim,Number> DoFs_summary;
+	SymmetricTensor<2,dim> sigma;
+	SymmetricTensor<4,dim> C;
+
+	unsigned long int n_allocations_start = n_allocations;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		// Start counting after the warm-up
+		 if ( qp==1 )
+			 n_allocations_start = n_allocations;
+
+		DoFs_summary.reseed(eps, strain_at_qp<dim>(qp), phi, 0.3);
+
+		switch ( model )
+		{
+			case Model::energy_eps_phi:
+				eps.get_tangent(sigma, energy_eps_phi<dim,Number>( eps, phi, lambda, mu ));
+				checksum += sigma[0][0];
+				break;
+			case Model::stress_eps_phi:
+				eps.get_tangent(C, stress_eps_phi<dim,Number>( eps, phi ));
+				checksum += C[0][0][0][0];
+				break;
+			case Model::stress_strain:
+				eps.get_tangent(C, stress_strain_relation<dim,Number>( eps, lambda, mu ));
+				checksum += C[0][0][0][0];
+				break;
+		}
+	}
+
+	return double(n_allocations - n_allocations_start) / (n_qps-1);
+}
+
+
+int main ()
+{
+	const unsigned int dim=3;
+	const unsigned int n_qps = 1000000;
+
+	const double lambda = 1;
+	const double mu = 2;
+
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+
+	QPSums<dim> sums_new, sums_reseed, sums_SFad;
+	double allocs_new, allocs_reseed, allocs_SFad;
+
+	{
+		TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+		timer.enter_subsection("DFad new objects");
+		 allocs_new = evaluate_new_objects<Sacado::Fad::DFad<double> >( n_qps, lambda, mu, sums_new );
+		timer.leave_subsection();
+
+		timer.enter_subsection("DFad reseed");
+		 allocs_reseed = evaluate_reseed<Sacado::Fad::DFad<double> >( n_qps, lambda, mu, sums_reseed );
+		timer.leave_subsection();
+
+		timer.enter_subsection("SFad reseed");
+		 allocs_SFad = evaluate_reseed<Sacado::Fad::SFad<double,N> >( n_qps, lambda, mu, sums_SFad );
+		timer.leave_subsection();
+	}
+
+	std::cout << "Benchmark reseed: " << n_qps << " quadrature points" << std::endl;
+	std::cout << "heap allocations per QP, DFad new objects: " << allocs_new << std::endl;
+	std::cout << "heap allocations per QP, DFad reseed:      " << allocs_reseed << std::endl;
+	std::cout << "heap allocations per QP, SFad reseed:      " << allocs_SFad << std::endl;
+	bool passed = check_error( "reseed vs new objects", sums_reseed.error(sums_new) );
+	passed &= check_error( "SFad vs DFad", sums_SFad.error(sums_new) );
+
+	// The models from benchmark_models.h with their temporary Sacado variables
+	 const unsigned int n_qps_models = 10000;
+	 const std::pair<Model,const char*> models[] = { {Model::energy_eps_phi, "energy_eps_phi (Ex7)        "},
+													 {Model::stress_eps_phi, "stress_eps_phi (Ex4)        "},
+													 {Model::stress_strain,  "stress_strain_relation (Ex10)"} };
+	 double checksum = 0.;
+	 bool models_SFad_allocate = false;
+	 for ( const std::pair<Model,const char*> &model : models )
+	 {
+		const double allocs_model_DFad = evaluate_reseed_model<Sacado::Fad::DFad<double> >( model.first, n_qps_models, lambda, mu, checksum );
+		const double allocs_model_SFad = evaluate_reseed_model<Sacado::Fad::SFad<double,N> >( model.first, n_qps_models, lambda, mu, checksum );
+		std::cout << "heap allocations per QP, reseed " << model.second << ": DFad " << allocs_model_DFad
+				  << ", SFad " << allocs_model_SFad << std::endl;
+		models_SFad_allocate = models_SFad_allocate || ( allocs_model_SFad != 0. );
+	 }
+	 std::cout << "(checksum " << checksum << ")" << std::endl;
+
+	if ( allocs_reseed != 0. || allocs_SFad != 0. || models_SFad_allocate )
+	{
+		std::cout << "ERROR: Reseeding must not allocate on the heap after the warm-up." << std::endl;
+		passed = false;
+	}
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+/*
+ * Benchmark: Spectral derivatives of the logarithmic strain (SpectralTensorFunction) vs. AD through eigenvectors()
+ *
+ * The logarithm ln(C) of the right Cauchy-Green tensor from ln_space_AD.cc (slightly varied per point) is computed at
+ * \a n_qps quadrature points
+ * - AD: as in ln_space_AD.cc with eigenvectors() of the SymTensor (DFad, tangent) and of the SymTensor2 (DFad<DFad>,
+ *   tangent and curvature)
+ * - spectral: with the SpectralTensorFunction, which differentiates only ln(lambda) (see Sacado-spectral.h)
+ * The sums of the values, tangents and curvatures of the spectral versions are compared to the AD ones. Finally, the
+ * tangent is checked for C = 2I with three equal eigenvalues, where it equals 1/2 II^sym, and the curvature for C = 2I
+ * and for two and three nearly equal eigenvalues. There, the derivatives of the eigenvectors do not exist or lose all
+ * digits, so the AD reference differentiates the power series of ln(C) instead.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <utility>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-spectral.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+
+
+/*
+ * The right Cauchy-Green tensor from ln_space_AD.cc, varied with the strain of the quadrature point \a qp
+ */
+SymmetricTensor<2,dim> right_cauchy_green_at_qp ( const unsigned int qp )
+{
+	SymmetricTensor<2,dim> C;
+	C[0][0] = 1.;
+	C[1][1] = 2.;
+	C[2][2] = 3.;
+	C[0][1] = 0.4;
+	C[0][2] = 0.5;
+	C[1][2] = 0.6;
+	return C + 1e-2 * strain_at_qp<dim>(qp);
+}
+
+
+/*
+ * ln(C) via the eigenvalues and eigenvectors of the Sacado data type \a Number (as in ln_space_AD.cc)
+ */
+template<typename Number>
+SymmetricTensor<2,dim,Number> logarithm_AD ( const SymmetricTensor<2,dim,Number> &C )
+{
+	using std::log;
+	const std::array<std::pair<Number,Tensor<1,dim,Number> >,dim> eigensystem = eigenvectors(C);
+
+	SymmetricTensor<2,dim,Number> ln_C;
+	for ( unsigned int a=0; a<dim; ++a )
+	{
+		const Number ln_lambda = log(eigensystem[a].first);
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				ln_C[i][j] += ln_lambda * eigensystem[a].second[i] * eigensystem[a].second[j];
+	}
+	return ln_C;
+}
+
+
+// ln(C) and its derivatives summed over all quadrature points (the curvature is not covered by QPSums)
+struct Results
+{
+	SymmetricTensor<2,dim> ln_C;
+	SymmetricTensor<4,dim> ln_C_C;
+	Sacado_Wrapper::SymCurvature<dim> ln_C_CC;
+
+	void add_curvature ( const Sacado_Wrapper::SymCurvature<dim> &Curvature )
+	{
+		for ( unsigned int y=0; y<Sacado_Wrapper::SymCurvature<dim>::n_dofs; ++y )
+			for ( unsigned int x=0; x<Sacado_Wrapper::SymCurvature<dim>::n_dofs; ++x )
+				for ( unsigned int a=0; a<Sacado_Wrapper::SymCurvature<dim>::n_dofs; ++a )
+					ln_C_CC(y,x,a) += Curvature(y,x,a);
+	}
+
+	// Relative to the magnitude of the \a reference, as QPSums::error
+	 double error ( const Results &reference ) const
+	 {
+		double difference = (ln_C-reference.ln_C).norm() + (ln_C_C-reference.ln_C_C).norm();
+		double magnitude = reference.ln_C.norm() + reference.ln_C_C.norm();
+		for ( unsigned int y=0; y<Sacado_Wrapper::SymCurvature<dim>::n_dofs; ++y )
+			for ( unsigned int x=0; x<Sacado_Wrapper::SymCurvature<dim>::n_dofs; ++x )
+				for ( unsigned int a=0; a<Sacado_Wrapper::SymCurvature<dim>::n_dofs; ++a )
+				{
+					difference += std::abs( ln_C_CC(y,x,a) - reference.ln_C_CC(y,x,a) );
+					magnitude += std::abs( reference.ln_C_CC(y,x,a) );
+				}
+		return difference / std::max( 1., magnitude );
+	 }
+};
+
+
+/*
+ * ln(C) via the power series ln(C) = ln(alpha) I + sum_k (-1)^(k+1)/k X^k with X = C/alpha - I, which avoids the
+ * eigenvectors and thus also works for repeated eigenvalues. The shift \a alpha should be close to the eigenvalues
+ * of C, so that the series converges quickly. It is summed until the terms drop below 1e-17.
+ */
+template<typename Number>
+SymmetricTensor<2,dim,Number> logarithm_series ( const SymmetricTensor<2,dim,Number> &C, const double alpha )
+{
+	const SymmetricTensor<2,dim,Number> X = C / alpha - unit_symmetric_tensor<dim,Number>();
+
+	SymmetricTensor<2,dim,Number> ln_C = std::log(alpha) * unit_symmetric_tensor<dim,Number>();
+	SymmetricTensor<2,dim,Number> X_k = X;
+	for ( unsigned int k=1; k<200; ++k )
+	{
+		ln_C += ( k%2==1 ? 1. : -1. ) / k * X_k;
+
+		double norm_X_k = 0.;
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				norm_X_k = std::max( norm_X_k, std::abs(Sacado_Wrapper::value2(X_k[i][j])) );
+		if ( k>3 && norm_X_k < 1e-17 )
+			break;
+
+		// X^(k+1) = X^k * X is symmetric, because the powers of X commute
+		 SymmetricTensor<2,dim,Number> X_k1;
+		 for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				for ( unsigned int m=0; m<dim; ++m )
+					X_k1[i][j] += X_k[i][m] * X[m][j];
+		 X_k = X_k1;
+	}
+	return ln_C;
+}
+
+
+/*
+ * The error of the spectral curvature of ln(C) relative to the AD of the power series, for C with the eigenvalues
+ * \a lambda and the eigenvectors of right_cauchy_green_at_qp(0)
+ */
+double error_curvature_series ( const std::array<double,dim> &lambda )
+{
+	const std::array<std::pair<double,Tensor<1,dim> >,dim> eigensystem = eigenvectors( right_cauchy_green_at_qp(0) );
+	SymmetricTensor<2,dim> C;
+	for ( unsigned int a=0; a<dim; ++a )
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				C[i][j] += lambda[a] * eigensystem[a].second[i] * eigensystem[a].second[j];
+
+	typedef Sacado::Fad::DFad<DFadType> Number2;
+	Sacado_Wrapper::SymTensor2<dim> C2;
+	C2.reseed( C );
+	const SymmetricTensor<2,dim,Number2> ln_C_fad = logarithm_series<Number2>( C2, trace(C) / dim );
+	Results results_AD;
+	C2.get_tangent(results_AD.ln_C_C, ln_C_fad);
+	Sacado_Wrapper::SymCurvature<dim> ln_C_CC_AD;
+	C2.get_curvature(ln_C_CC_AD, ln_C_fad);
+	results_AD.add_curvature(ln_C_CC_AD);
+
+	Sacado_Wrapper::SpectralTensorFunction<dim> ln;
+	ln.reinit( C, Sacado_Wrapper::SpectralFunctions::Logarithm() );
+	Results results_spectral;
+	ln.get_tangent(results_spectral.ln_C_C);
+	Sacado_Wrapper::SymCurvature<dim> ln_C_CC;
+	ln.get_curvature(ln_C_CC);
+	results_spectral.add_curvature(ln_C_CC);
+
+	return results_spectral.error(results_AD);
+}
+
+
+// AD through eigenvectors(): the tangent with the SymTensor, optionally also the curvature with the SymTensor2
+ template<bool with_curvature>
+ Results evaluate_AD ( const unsigned int n_qps )
+ {
+	typedef Sacado::Fad::DFad<double> Number;
+	typedef Sacado::Fad::DFad<DFadType> Number2;
+
+	Sacado_Wrapper::SymTensor<dim> C;
+	Sacado_Wrapper::SymTensor2<dim> C2;
+
+	Results results;
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		SymmetricTensor<2,dim> ln_C;
+		SymmetricTensor<4,dim> ln_C_C;
+		if ( with_curvature )
+		{
+			C2.reseed( right_cauchy_green_at_qp(qp) );
+			const SymmetricTensor<2,dim,Number2> ln_C_fad = logarithm_AD<Number2>( C2 );
+
+			for ( unsigned int i=0; i<dim; ++i )
+				for ( unsigned int j=i; j<dim; ++j )
+					ln_C[i][j] = Sacado_Wrapper::value2( ln_C_fad[i][j] );
+			C2.get_tangent(ln_C_C, ln_C_fad);
+
+			Sacado_Wrapper::SymCurvature<dim> ln_C_CC;
+			C2.get_curvature(ln_C_CC, ln_C_fad);
+			results.add_curvature(ln_C_CC);
+		}
+		else
+		{
+			C.reseed( right_cauchy_green_at_qp(qp) );
+			const SymmetricTensor<2,dim,Number> ln_C_fad = logarithm_AD<Number>( C );
+
+			for ( unsigned int i=0; i<dim; ++i )
+				for ( unsigned int j=i; j<dim; ++j )
+					ln_C[i][j] = ln_C_fad[i][j].val();
+			C.get_tangent(ln_C_C, ln_C_fad);
+		}
+		results.ln_C += ln_C;
+		results.ln_C_C += ln_C_C;
+	}
+	return results;
+ }
+
+
+// The same with the SpectralTensorFunction
+ template<bool with_curvature>
+ Results evaluate_spectral ( const unsigned int n_qps )
+ {
+	Sacado_Wrapper::SpectralTensorFunction<dim> ln;
+
+	Results results;
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		ln.reinit( right_cauchy_green_at_qp(qp), Sacado_Wrapper::SpectralFunctions::Logarithm() );
+
+		SymmetricTensor<4,dim> ln_C_C;
+		ln.get_tangent(ln_C_C);
+		results.ln_C += ln.get_value();
+		results.ln_C_C += ln_C_C;
+
+		if ( with_curvature )
+		{
+			Sacado_Wrapper::SymCurvature<dim> ln_C_CC;
+			ln.get_curvature(ln_C_CC);
+			results.add_curvature(ln_C_CC);
+		}
+	}
+	return results;
+ }
+
+
+int main ()
+{
+	const unsigned int n_qps = 20000;
+
+	// The AD derivatives go through the iterations of the eigenvalue solver in eigenvectors()
+	 const double tolerance = 1e-8;
+
+	Results results_AD, results_AD2, results_spectral, results_spectral2;
+	{
+		TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+		timer.enter_subsection("AD eigenvectors DFad (tangent)");
+		 results_AD = evaluate_AD<false>( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("spectral (tangent)");
+		 results_spectral = evaluate_spectral<false>( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("AD eigenvectors DFad<DFad> (tangent, curvature)");
+		 results_AD2 = evaluate_AD<true>( n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection("spectral (tangent, curvature)");
+		 results_spectral2 = evaluate_spectral<true>( n_qps );
+		timer.leave_subsection();
+	}
+
+	std::cout << "Benchmark spectral derivatives of ln(C): " << n_qps << " quadrature points" << std::endl;
+	bool passed = check_error( "spectral vs AD (tangent)", results_spectral.error(results_AD), tolerance );
+	passed &= check_error( "spectral vs AD (tangent, curvature)", results_spectral2.error(results_AD2), tolerance );
+
+	// Three equal eigenvalues: d ln(C)/dC = 1/lambda II^sym
+	 {
+		Sacado_Wrapper::SpectralTensorFunction<dim> ln;
+		ln.reinit( 2. * unit_symmetric_tensor<dim>(), Sacado_Wrapper::SpectralFunctions::Logarithm() );
+		SymmetricTensor<4,dim> ln_C_C;
+		ln.get_tangent(ln_C_C);
+		passed &= check_error( "spectral tangent for C=2I vs 1/2 II^sym", (ln_C_C - 0.5 * identity_tensor<dim>()).norm() );
+	 }
+
+	// The curvature for three equal eigenvalues, where f[x,x,x] = f''/2, and for two and three nearly equal ones, where
+	// the plain divided differences lose digits
+	 passed &= check_error( "spectral vs AD series (curvature, C=2I)", error_curvature_series({{2., 2., 2.}}) );
+	 passed &= check_error( "spectral vs AD series (curvature, two nearly equal)", error_curvature_series({{1.5, 2., 2.+2e-7}}) );
+	 passed &= check_error( "spectral vs AD series (curvature, three nearly equal)", error_curvature_series({{2., 2.+1e-6, 2.+3e-6}}) );
+
+	return passed ? 0 : 1;
+}
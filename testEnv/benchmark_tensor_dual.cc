@@ -0,0 +1,189 @@
+/*
+ * Benchmark: Tensor-level forward mode (TensorDual) vs. the component-wise Sacado data types of the SymTensor
+ *
+ * The stress and the tangent of three models are computed at \a n_qps quadrature points:
+ * - stress_strain_relation (\ref Ex10 "example 10"): trace and deviator
+ * - stress_eps_phi (\ref Ex4 "example 4") with a constant phi: trace, norm and the product of a scalar and a tensor
+ * - a compressible Neo-Hooke material in the Green-Lagrange strain E (the strain is scaled to keep C = I + 2E positive definite)
+ *   \f[ S = \mu \cdot ( \boldsymbol{I} - \boldsymbol{C}^{-1} ) + \lambda \cdot \ln(J) \cdot \boldsymbol{C}^{-1} \quad with \quad J = \sqrt{\det \boldsymbol{C}} \f]
+ *   with the inverse and the determinant
+ * each with the SymTensor of DFad and SFad<6> (tangent via get_tangent) and with the TensorDual (see Sacado-tensor_dual.h),
+ * whose tangents are compared to the SFad ones.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-tensor_dual.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+const double kappa = 5;
+const double mu = 2;
+const double lambda = 1;
+const double phi = 0.3;
+
+
+// Neo-Hooke: second Piola-Kirchhoff stress for the Sacado data types
+ template<typename Number>
+ SymmetricTensor<2,dim,Number> neo_hooke ( const SymmetricTensor<2,dim,Number> &E )
+ {
+	const SymmetricTensor<2,dim,Number> I (( unit_symmetric_tensor<dim,Number>() ));
+	const SymmetricTensor<2,dim,Number> C = I + 2. * E;
+	const SymmetricTensor<2,dim,Number> C_inv = invert(C);
+	using std::log;
+	const Number lambda_ln_J = lambda * 0.5 * log( determinant(C) );
+
+	SymmetricTensor<2,dim,Number> S = mu * ( I - C_inv );
+	S += lambda_ln_J * C_inv;
+	return S;
+ }
+
+
+// The three models for the TensorDual, written with the same tensor operations
+ Sacado_Wrapper::TensorDual<dim> stress_strain_relation_dual ( const Sacado_Wrapper::TensorDual<dim> &eps )
+ {
+	return kappa * trace(eps) * unit_symmetric_tensor<dim>() + 2. * mu * deviator(eps);
+ }
+
+ Sacado_Wrapper::TensorDual<dim> stress_eps_phi_dual ( const Sacado_Wrapper::TensorDual<dim> &eps )
+ {
+	const Sacado_Wrapper::ScalarDual<dim> d = phi*phi + 25 + trace(eps) + norm(eps);
+	return (phi * d) * eps;
+ }
+
+ Sacado_Wrapper::TensorDual<dim> neo_hooke_dual ( const Sacado_Wrapper::TensorDual<dim> &E )
+ {
+	const SymmetricTensor<2,dim> I = unit_symmetric_tensor<dim>();
+	const Sacado_Wrapper::TensorDual<dim> C = I + 2. * E;
+	const Sacado_Wrapper::TensorDual<dim> C_inv = invert(C);
+	const Sacado_Wrapper::ScalarDual<dim> ln_J = 0.5 * log( determinant(C) );
+
+	return mu * ( I - C_inv ) + ( lambda * ln_J ) * C_inv;
+ }
+
+
+enum class Model
+{
+	stress_strain,
+	stress_eps_phi,
+	neo_hooke
+};
+
+
+SymmetricTensor<2,dim> strain ( const Model model, const unsigned int qp )
+{
+	return ( model==Model::neo_hooke ) ? SymmetricTensor<2,dim>( 1e-2 * strain_at_qp<dim>(qp) ) : strain_at_qp<dim>(qp);
+}
+
+
+// Sum of the tangents over all quadrature points with the SymTensor of the data types from the \a Policy
+ template<typename Policy>
+ SymmetricTensor<4,dim> evaluate_components ( const Model model, const unsigned int n_qps )
+ {
+	typedef typename Policy::fad_type Number;
+
+	typename Policy::template SymTensor_type<dim> eps;
+	SymmetricTensor<4,dim> C_sum;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		eps.reseed( strain(model, qp) );
+
+		SymmetricTensor<2,dim,Number> sigma;
+		switch ( model )
+		{
+			case Model::stress_strain:
+				sigma = stress_strain_relation<dim,Number>( eps, kappa, mu );
+				break;
+			case Model::stress_eps_phi:
+				// phi as a constant (without derivatives)
+				 sigma = stress_eps_phi<dim,Number>( eps, Number(phi) );
+				break;
+			case Model::neo_hooke:
+				sigma = neo_hooke<Number>( eps );
+				break;
+		}
+
+		SymmetricTensor<4,dim> C;
+		eps.get_tangent(C, sigma);
+		C_sum += C;
+	}
+	return C_sum;
+ }
+
+
+// Sum of the tangents over all quadrature points with the TensorDual
+ SymmetricTensor<4,dim> evaluate_dual ( const Model model, const unsigned int n_qps )
+ {
+	Sacado_Wrapper::TensorDual<dim> eps;
+	SymmetricTensor<4,dim> C_sum;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		eps.reseed( strain(model, qp) );
+
+		switch ( model )
+		{
+			case Model::stress_strain:
+				C_sum += stress_strain_relation_dual( eps ).dx();
+				break;
+			case Model::stress_eps_phi:
+				C_sum += stress_eps_phi_dual( eps ).dx();
+				break;
+			case Model::neo_hooke:
+				C_sum += neo_hooke_dual( eps ).dx();
+				break;
+		}
+	}
+	return C_sum;
+ }
+
+
+int main ()
+{
+	const unsigned int n_qps = 200000;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	std::cout << "Benchmark tensor-level forward mode: " << n_qps << " quadrature points" << std::endl;
+
+	const std::vector<std::pair<Model,std::string> > models = { {Model::stress_strain, "Ex10 stress"},
+																{Model::stress_eps_phi, "Ex4 stress"},
+																{Model::neo_hooke, "Neo-Hooke"} };
+	bool passed = true;
+	for ( const std::pair<Model,std::string> &model : models )
+	{
+		timer.enter_subsection(model.second + " DFad");
+		 evaluate_components< Sacado_Wrapper::DFad_policy >( model.first, n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection(model.second + " SFad<6>");
+		 const SymmetricTensor<4,dim> C_reference = evaluate_components< Sacado_Wrapper::SFad_policy<N> >( model.first, n_qps );
+		timer.leave_subsection();
+
+		timer.enter_subsection(model.second + " TensorDual");
+		 const SymmetricTensor<4,dim> C_dual = evaluate_dual( model.first, n_qps );
+		timer.leave_subsection();
+
+		passed &= check_error( model.second + " TensorDual vs SFad<6>", (C_dual-C_reference).norm() / C_reference.norm() );
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*
+ * Benchmark: Parallel efficiency of the second-order wrapper in a deal.II WorkStream
+ *
+ * The energy from example 8 is evaluated at \a n_qps quadrature points, split into blocks of \a block_size quadrature
+ * points that are distributed over the threads by WorkStream::run. Each thread works with the wrapper variables in its own
+ * ScratchData (see the notes on the thread safety in Sacado_Wrapper.h) and the partial sums are added up in the copier.
+ * The number of threads is limited via MultithreadInfo::set_thread_limit to 1, 2, 4, ... up to the number of cores and the
+ * parallel efficiency T_1 / ( n * T_n ) is reported for
+ * - DFad: heap allocations for all derivative arrays
+ * - SFad<7>: derivative arrays on the stack
+ * - PoolFad: derivative arrays from the thread-local pools (see Sacado-memory_pool.h)
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// Timer: to measure the wall time of each run
+#include <deal.II/base/timer.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/work_stream.h>
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-memory_pool.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Per-thread wrapper variables, reseeded at every quadrature point
+ */
+template<typename Policy>
+struct ScratchData
+{
+	typename Policy::template SymTensor2_type<3> eps;
+	typename Policy::template SW_double2_type<3> phi;
+	typename Policy::template DoFs_summary_type<3> DoFs_summary;
+};
+
+
+struct CopyData
+{
+	QPSums<3> results;
+};
+
+
+template<typename Policy>
+void evaluate_block ( const std::vector<unsigned int>::const_iterator &block, ScratchData<Policy> &scratch, CopyData &copy_data,
+					  const unsigned int block_size, const double lambda, const double mu )
+{
+	const unsigned int dim=3;
+	typedef typename Policy::fad2_type Number2;
+
+	QPSums<3> &results = copy_data.results;
+	results = QPSums<3>();
+
+	for ( unsigned int qp=*block; qp<*block+block_size; ++qp )
+	{
+		scratch.DoFs_summary.reseed(scratch.eps, strain_at_qp<dim>(qp), scratch.phi, 0.3);
+
+		const Number2 energy = energy_eps_phi<dim,Number2>( scratch.eps, scratch.phi, lambda, mu );
+
+		SymmetricTensor<2,dim> sigma;
+		scratch.eps.get_tangent(sigma, energy);
+		results.sigma += sigma;
+
+		SymmetricTensor<4,dim> C;
+		scratch.eps.get_curvature(C, energy);
+		results.C += C;
+
+		double d2_psi_d_phi2;
+		scratch.phi.get_curvature(d2_psi_d_phi2, energy);
+		results.d2_psi_d_phi2 += d2_psi_d_phi2;
+	}
+}
+
+
+template<typename Policy>
+QPSums<3> evaluate_work_stream ( const std::vector<unsigned int> &blocks, const unsigned int block_size, const double lambda, const double mu )
+{
+	QPSums<3> sum;
+
+	WorkStream::run( blocks.begin(), blocks.end(),
+					 [&] ( const std::vector<unsigned int>::const_iterator &block, ScratchData<Policy> &scratch, CopyData &copy_data )
+					 {
+						evaluate_block<Policy>( block, scratch, copy_data, block_size, lambda, mu );
+					 },
+					 [&] ( const CopyData &copy_data )
+					 {
+						sum += copy_data.results;
+					 },
+					 ScratchData<Policy>(),
+					 CopyData() );
+
+	return sum;
+}
+
+
+/*
+ * Run the data types of the \a Policy with 1, 2, 4, ... and \a max_threads threads, returns the largest error vs 1 thread
+ */
+template<typename Policy>
+double run_scaling ( const std::string &name, const std::vector<unsigned int> &blocks, const unsigned int block_size,
+				   const double lambda, const double mu, const unsigned int max_threads )
+{
+	std::vector<unsigned int> n_threads_list;
+	for ( unsigned int n_threads=1; n_threads<max_threads; n_threads*=2 )
+		n_threads_list.push_back(n_threads);
+	n_threads_list.push_back(max_threads);
+
+	QPSums<3> reference;
+	double wall_time_1 = 0.;
+	double max_error = 0.;
+
+	for ( const unsigned int n_threads : n_threads_list )
+	{
+		MultithreadInfo::set_thread_limit(n_threads);
+
+		Timer timer;
+		 const QPSums<3> results = evaluate_work_stream<Policy>( blocks, block_size, lambda, mu );
+		timer.stop();
+
+		if ( n_threads==1 )
+		{
+			reference = results;
+			wall_time_1 = timer.wall_time();
+		}
+
+		std::cout << std::setw(10) << name << std::setw(8) << n_threads
+				  << std::setw(14) << timer.wall_time()
+				  << std::setw(12) << wall_time_1 / ( n_threads * timer.wall_time() )
+				  << std::setw(14) << results.error(reference) << std::endl;
+		max_error = std::max( max_error, results.error(reference) );
+	}
+	return max_error;
+}
+
+
+int main ()
+{
+	const unsigned int n_qps = 1000000;
+	const unsigned int block_size = 1000;
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<3,1>::value;
+
+	const double lambda = 1;
+	const double mu = 2;
+
+	// The first quadrature point of each block
+	 std::vector<unsigned int> blocks;
+	 for ( unsigned int qp=0; qp<n_qps; qp+=block_size )
+		blocks.push_back(qp);
+
+	const unsigned int max_threads = MultithreadInfo::n_cores();
+
+	std::cout << "Benchmark thread scaling: " << n_qps << " quadrature points in blocks of " << block_size << std::endl;
+	std::cout << std::setw(10) << "data type" << std::setw(8) << "threads" << std::setw(14) << "wall time [s]"
+			  << std::setw(12) << "efficiency" << std::setw(14) << "error vs 1" << std::endl;
+
+	const double error_DFad = run_scaling< Sacado_Wrapper::DFad_policy >    ( "DFad",    blocks, block_size, lambda, mu, max_threads );
+	const double error_SFad = run_scaling< Sacado_Wrapper::SFad_policy<N> > ( "SFad<7>", blocks, block_size, lambda, mu, max_threads );
+	const double error_pool = run_scaling< Sacado_Wrapper::PoolFad_policy > ( "PoolFad", blocks, block_size, lambda, mu, max_threads );
+
+	bool passed = check_error( "DFad n threads vs 1", error_DFad );
+	passed &= check_error( "SFad<7> n threads vs 1", error_SFad );
+	passed &= check_error( "PoolFad n threads vs 1", error_pool );
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/*
+ * Benchmark: SIMD evaluation across quadrature points with Sacado::Fad::SFad<VectorizedArray<double>,N>
+ * versus the scalar Sacado::Fad::SFad<double,N>
+ *
+ * The \a stress_strain_relation from example 10 is evaluated at \a n_qps quadrature points. The scalar path
+ * reseeds a SymTensor_SFad at every quadrature point, the SIMD path fills the \a n_lanes lanes of a
+ * SymTensor_vectorized with consecutive quadrature points and unpacks the stress and the tangent lane by lane.
+ * The expected speed-up is roughly the number of lanes for the evaluation of the model, minus the overhead of
+ * the packing and unpacking.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+
+// TimerOutput: to measure the time spent in certain parts of the code
+#include <deal.II/base/timer.h>
+
+#include <iostream>
+#include <cmath>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-vectorized_array.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+/*
+ * Scalar path: one quadrature point after the other
+ */
+template<int dim>
+void evaluate_scalar ( const unsigned int n_qps, const double kappa, const double mu, QPSums<dim> &sums )
+{
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+	Sacado_Wrapper::SymTensor_SFad<dim,N> eps;
+
+	for ( unsigned int qp=0; qp<n_qps; ++qp )
+	{
+		eps.reseed( strain_at_qp<dim>(qp) );
+
+		SymmetricTensor<2,dim,Sacado::Fad::SFad<double,N> > sigma = stress_strain_relation ( eps, kappa, mu );
+
+		SymmetricTensor<4,dim> C;
+		eps.get_tangent(C, sigma);
+		sums.C += C;
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				sums.sigma[i][j] += sigma[i][j].val();
+	}
+}
+
+
+/*
+ * SIMD path: \a n_lanes quadrature points at once
+ * @note \a n_qps must be a multiple of \a n_lanes
+ */
+template<int dim>
+void evaluate_vectorized ( const unsigned int n_qps, const double kappa, const double mu, QPSums<dim> &sums )
+{
+	const unsigned int N = Sacado_Wrapper::n_total_dofs<dim>::value;
+	Sacado_Wrapper::SymTensor_vectorized<dim,N> eps;
+
+	for ( unsigned int qp=0; qp<n_qps; qp+=Sacado_Wrapper::n_lanes )
+	{
+		for ( unsigned int lane=0; lane<Sacado_Wrapper::n_lanes; ++lane )
+			eps.init( strain_at_qp<dim>(qp+lane), lane );
+		eps.set_dofs();
+
+		SymmetricTensor<2,dim,Sacado_Wrapper::fad_vectorized<N> > sigma = stress_strain_relation ( eps, kappa, mu );
+
+		for ( unsigned int lane=0; lane<Sacado_Wrapper::n_lanes; ++lane )
+		{
+			SymmetricTensor<4,dim> C;
+			eps.get_tangent(C, sigma, lane);
+			sums.C += C;
+			sums.sigma += Sacado_Wrapper::get_value(sigma, lane);
+		}
+	}
+}
+
+
+int main ()
+{
+	const unsigned int dim=3;
+	const unsigned int n_qps = 1000000; // a multiple of 4 and 8
+
+	const double kappa = 5;
+	const double mu = 2;
+
+	QPSums<dim> sums_scalar, sums_vectorized;
+
+	TimerOutput timer (std::cout, TimerOutput::summary, TimerOutput::wall_times);
+
+	 timer.enter_subsection("SFad<double>");
+	  evaluate_scalar<dim>( n_qps, kappa, mu, sums_scalar );
+	 timer.leave_subsection();
+
+	 timer.enter_subsection("SFad<VectorizedArray<double>>");
+	  evaluate_vectorized<dim>( n_qps, kappa, mu, sums_vectorized );
+	 timer.leave_subsection();
+
+	// Both paths must give the same stresses and tangents
+	 std::cout << "Benchmark vectorized: " << n_qps << " quadrature points, " << Sacado_Wrapper::n_lanes << " lanes" << std::endl;
+	 const bool passed = check_error( "SIMD vs scalar", sums_vectorized.error(sums_scalar) );
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/*
+ * Benchmark: Work stealing vs. static partitioning for quadrature points of different cost
+ *
+ * A synthetic mix of quadrature points mimics a damage/plasticity model:
+ * - cheap (elastic shortcut): stress, tangent and d_sigma_d_phi of \ref Ex4 "example 4" with SFad<7> (sacado_test_4)
+ * - expensive (local iterations): \a n_local_iterations evaluations of the energy from \ref Ex8 "example 8" with the
+ *   nested SymTensor2 (SFad<SFad<7>>) and the extraction of the Hessian
+ * The expensive points lie in a band, which moves a little in every load step, and every 50th point is expensive, too.
+ * All quadrature points are evaluated in \a n_steps load steps by
+ * - static: equal numbers of quadrature points per thread
+ * - static+costs: one contiguous range per thread with equal costs estimated from the previous step
+ * - stealing: tasks of equal numbers of quadrature points, idle threads steal tasks
+ * - stealing+costs: tasks of equal estimated costs, distributed by the costs, plus stealing
+ * (see Sacado-work_stealing.h). For every step, the number of tasks and steals, the wall time, the imbalance of the busy
+ * times of the threads and the error of the results vs. the static partitioning are listed.
+ */
+
+// @section includes Include Files
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+// Sacado (from Trilinos, data types, operations, ...)
+#include <Sacado.hpp>
+
+#include "Sacado_Wrapper.h"
+#include "Sacado-work_stealing.h"
+#include "benchmark_models.h"
+
+using namespace dealii;
+
+
+const unsigned int dim = 3;
+const unsigned int N = Sacado_Wrapper::n_total_dofs<dim,1>::value;
+
+const double lambda = 1;
+const double mu = 2;
+const unsigned int n_local_iterations = 4;
+
+
+// Whether the quadrature point \a qp is expensive in the load step \a step
+ bool is_expensive ( const unsigned int qp, const unsigned int step, const unsigned int n_qps )
+ {
+	const unsigned int band_begin = ( 0.30 + 0.02*step ) * n_qps;
+	const unsigned int band_end = ( 0.45 + 0.02*step ) * n_qps;
+	return ( qp>=band_begin && qp<band_end ) || qp%50==0;
+ }
+
+
+/*
+ * Per-thread wrapper variables and results
+ */
+struct ScratchData
+{
+	Sacado_Wrapper::SymTensor_SFad<dim,N> eps;
+	Sacado_Wrapper::SW_double_SFad<dim,N> phi;
+	Sacado_Wrapper::DoFs_summary_SFad<dim,N> DoFs_summary;
+
+	Sacado_Wrapper::SymTensor2_SFad<dim,N> eps2;
+	Sacado_Wrapper::SW_double2_SFad<dim,N> phi2;
+	Sacado_Wrapper::DoFs_summary_SFad<dim,N> DoFs_summary2;
+
+	// Sums of the extracted quantities of this thread
+	 QPSums<dim> sums;
+};
+
+
+void evaluate_qp ( const unsigned int qp, const unsigned int step, const unsigned int n_qps, ScratchData &scratch )
+{
+	const SymmetricTensor<2,dim> eps_d = strain_at_qp<dim>(qp);
+	SymmetricTensor<2,dim> sigma;
+	SymmetricTensor<4,dim> C;
+
+	if ( is_expensive(qp, step, n_qps) )
+	{
+		typedef Sacado::Fad::SFad< Sacado::Fad::SFad<double,N>, N > Number2;
+
+		for ( unsigned int it=0; it<n_local_iterations; ++it )
+		{
+			scratch.DoFs_summary2.reseed(scratch.eps2, eps_d, scratch.phi2, 0.3);
+			const Number2 energy = energy_eps_phi<dim,Number2>( scratch.eps2, scratch.phi2, lambda, mu );
+			scratch.eps2.get_tangent(sigma, energy);
+			scratch.eps2.get_curvature(C, energy);
+		}
+	}
+	else
+	{
+		typedef Sacado::Fad::SFad<double,N> Number;
+
+		scratch.DoFs_summary.reseed(scratch.eps, eps_d, scratch.phi, 0.3);
+		const SymmetricTensor<2,dim,Number> sigma_fad = stress_eps_phi<dim,Number>( scratch.eps, scratch.phi );
+		scratch.eps.get_tangent(C, sigma_fad);
+		for ( unsigned int i=0; i<dim; ++i )
+			for ( unsigned int j=i; j<dim; ++j )
+				sigma[i][j] = sigma_fad[i][j].val();
+	}
+
+	scratch.sums.sigma += sigma;
+	scratch.sums.C += C;
+}
+
+
+/*
+ * Run all load steps with the \a scheduler and return the results of every step
+ */
+std::vector<QPSums<dim>> run_steps ( const std::string &name, Sacado_Wrapper::WorkStealingScheduler &scheduler, const unsigned int n_qps,
+									 const unsigned int n_steps, const std::vector<QPSums<dim>> &reference )
+{
+	std::vector<QPSums<dim>> results ( n_steps );
+
+	for ( unsigned int step=0; step<n_steps; ++step )
+	{
+		std::vector<ScratchData> scratch ( scheduler.n_threads() );
+
+		scheduler.run( n_qps, [&] ( const unsigned int qp, const unsigned int thread )
+		{
+			evaluate_qp( qp, step, n_qps, scratch[thread] );
+		});
+
+		for ( const ScratchData &scratch_thread : scratch )
+			results[step] += scratch_thread.sums;
+
+		std::cout << std::setw(16) << name << std::setw(6) << step;
+		scheduler.statistics().print(std::cout);
+		std::cout << std::setw(14) << ( reference.empty() ? 0. : results[step].error(reference[step]) ) << std::endl;
+	}
+
+	return results;
+}
+
+
+// The largest error of all load steps
+ double max_error ( const std::vector<QPSums<dim>> &results, const std::vector<QPSums<dim>> &reference )
+ {
+	double error = 0.;
+	for ( unsigned int step=0; step<results.size(); ++step )
+		error = std::max( error, results[step].error(reference[step]) );
+	return error;
+ }
+
+
+int main ()
+{
+	const unsigned int n_qps = 200000;
+	const unsigned int n_steps = 4;
+	const unsigned int n_threads = MultithreadInfo::n_cores();
+
+	std::cout << "Benchmark work stealing: " << n_qps << " quadrature points, " << n_steps << " load steps, "
+			  << n_threads << " threads" << std::endl;
+	std::cout << std::setw(16) << "scheduler" << std::setw(6) << "step" << std::setw(8) << "tasks" << std::setw(8) << "steals"
+			  << std::setw(14) << "wall time [s]" << std::setw(12) << "imbalance" << std::setw(14) << "error" << std::endl;
+
+	Sacado_Wrapper::WorkStealingScheduler static_scheduler ( n_threads, false, false );
+	const std::vector<QPSums<dim>> reference = run_steps( "static", static_scheduler, n_qps, n_steps, std::vector<QPSums<dim>>() );
+
+	Sacado_Wrapper::WorkStealingScheduler balanced_scheduler ( n_threads, false, true );
+	const std::vector<QPSums<dim>> results_balanced = run_steps( "static+costs", balanced_scheduler, n_qps, n_steps, reference );
+
+	Sacado_Wrapper::WorkStealingScheduler stealing_scheduler ( n_threads, true, false );
+	const std::vector<QPSums<dim>> results_stealing = run_steps( "stealing", stealing_scheduler, n_qps, n_steps, reference );
+
+	Sacado_Wrapper::WorkStealingScheduler stealing_costs_scheduler ( n_threads, true, true );
+	const std::vector<QPSums<dim>> results_stealing_costs = run_steps( "stealing+costs", stealing_costs_scheduler, n_qps, n_steps, reference );
+
+	bool passed = check_error( "static+costs vs static", max_error(results_balanced, reference) );
+	passed &= check_error( "stealing vs static", max_error(results_stealing, reference) );
+	passed &= check_error( "stealing+costs vs static", max_error(results_stealing_costs, reference) );
+
+	return passed ? 0 : 1;
+}
@@ -31,6 +31,7 @@
 // Sacado
 #include <Sacado.hpp>
 #include "Sacado_Wrapper.h"
+#include "Sacado-spectral.h"
 
 // defining a data type for the Sacada variables (simply used the standard types from the step-33 tutorial's introduction)
 using fad_double = Sacado::Fad::DFad<double>;
@@ -150,9 +151,27 @@ int main ()
 	 right_cauchy_green_sym.get_tangent(H_C, hencky_strain_3D);
 	 std::cout << "H_C=" << H_C << std::endl;
 	
-	 Tensor<6,dim> H_CC;
-	 right_cauchy_green_sym.get_curvature(H_CC, hencky_strain_3D);
-	 std::cout << "H_CC=" << H_CC << std::endl;
+	 // The second derivative of the Hencky strain is stored compactly with its 6x6x6 independent components
+	  Sacado_Wrapper::SymCurvature<dim> H_CC;
+	  right_cauchy_green_sym.get_curvature(H_CC, hencky_strain_3D);
+	  std::cout << "H_CC=" << H_CC << std::endl;
+
+	 // For an energy Psi(H(C)) the chain rule needs the contraction T : H_CC with the stress-like T=d_Psi/d_H,
+	 // which is computed without ever setting up the Tensor<6,dim> (here exemplary with T=I)
+	  SymmetricTensor<4,dim> I_H_CC = H_CC.contract_argument( unit_symmetric_tensor<dim>() );
+	  std::cout << "I:H_CC=" << I_H_CC << std::endl;
+
+	 // The same from the spectral decomposition with double, where only ln(lambda) is differentiated
+	 // (see Sacado-spectral.h, also for repeated eigenvalues)
+	  Sacado_Wrapper::SpectralTensorFunction<dim> ln_C;
+	  ln_C.reinit( C, Sacado_Wrapper::SpectralFunctions::Logarithm() );
+	  SymmetricTensor<4,dim> H_C_spectral;
+	  ln_C.get_tangent(H_C_spectral);
+	  Sacado_Wrapper::SymCurvature<dim> H_CC_spectral;
+	  ln_C.get_curvature(H_CC_spectral);
+	  std::cout << "spectral: H=" << ln_C.get_value() << std::endl;
+	  std::cout << "spectral: |H_C - H_C(AD)|=" << (H_C_spectral-H_C).norm() << std::endl;
+	  std::cout << "spectral: |I:H_CC - I:H_CC(AD)|=" << (H_CC_spectral.contract_argument( unit_symmetric_tensor<dim>() )-I_H_CC).norm() << std::endl;
     }
 }
 